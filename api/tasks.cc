@@ -152,6 +152,17 @@ void set_tasks_compaction_module(http_context& ctx, routes& r, sharded<service::
         co_return json::json_return_type(0);
     }));
 
+    t::garbage_collect_async.set(r, wrap_ks_cf(ctx, [] (http_context& ctx, std::unique_ptr<http::request> req, sstring keyspace, std::vector<table_info> table_infos) -> future<json::json_return_type> {
+        auto& db = ctx.db;
+
+        apilog.info("garbage_collect: keyspace={} tables={}", keyspace, table_infos);
+
+        auto& compaction_module = db.local().get_compaction_manager().get_task_manager_module();
+        auto task = co_await compaction_module.make_and_start_task<compaction::garbage_collection_compaction_task_impl>({}, std::move(keyspace), db, table_infos);
+
+        co_return json::json_return_type(task->get_status().id.to_sstring());
+    }));
+
     t::scrub_async.set(r, [&ctx, &snap_ctl] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
         auto& db = ctx.db;
         auto info = parse_scrub_options(ctx, std::move(req));
@@ -192,6 +203,7 @@ void unset_tasks_compaction_module(http_context& ctx, httpd::routes& r) {
     ss::perform_keyspace_offstrategy_compaction.unset(r);
     t::upgrade_sstables_async.unset(r);
     ss::upgrade_sstables.unset(r);
+    t::garbage_collect_async.unset(r);
     t::scrub_async.unset(r);
     ss::force_compaction.unset(r);
 }
@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <map>
+#include <deque>
 #include <functional>
 #include <utility>
 #include <assert.h>
@@ -25,6 +26,7 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/shard_id.hh>
 #include <seastar/core/on_internal_error.hh>
+#include <seastar/core/thread_cputime_clock.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
 #include "compaction/compaction_garbage_collector.hh"
@@ -37,6 +39,7 @@
 #include "sstables/sstables_manager.hh"
 #include "compaction.hh"
 #include "schema/schema.hh"
+#include "db/config.hh"
 #include "db/system_keyspace.hh"
 #include "db_clock.hh"
 #include "mutation/mutation_compactor.hh"
@@ -130,6 +133,7 @@ static const std::unordered_map<compaction_type, sstring> compaction_types = {
     { compaction_type::Reshape, "RESHAPE" },
     { compaction_type::Split, "SPLIT" },
     { compaction_type::Major, "MAJOR" },
+    { compaction_type::Garbage_collection, "GARBAGE_COLLECTION" },
 };
 
 sstring compaction_name(compaction_type type) {
@@ -161,6 +165,7 @@ std::string_view to_string(compaction_type type) {
     case compaction_type::Reshape: return "Reshape";
     case compaction_type::Split: return "Split";
     case compaction_type::Major: return "Major";
+    case compaction_type::Garbage_collection: return "Garbage_collection";
     }
     on_internal_error_noexcept(clogger, format("Invalid compaction type {}", int(type)));
     return "(invalid)";
@@ -308,6 +313,51 @@ static std::vector<sstables::basic_info> extract_basic_info_from_sstables(const
     }) | std::ranges::to<std::vector<sstables::basic_info>>();
 }
 
+// Estimates the CPU time spent by a compaction.
+//
+// The reactor thread runs other work in between the tasks of a compaction, so
+// the CPU time of the thread doesn't tell the CPU time of the compaction.
+// Instead, every sample_interval-th fragment written by the compaction is
+// timed, from its consumption to the consumption of the next fragment.
+// Samples which waited for I/O (used noticeably less CPU time than wall time)
+// or which are likely to include other tasks (took longer than the task
+// quota) are dropped, and the remaining ones are extrapolated to all
+// fragments. Fragments, unlike partitions, are small enough that the
+// dropped samples don't skew the estimate towards small partitions.
+class compaction_cpu_time_sampler {
+    static constexpr uint64_t sample_interval = 16;
+    static constexpr std::chrono::nanoseconds max_sample_duration = std::chrono::milliseconds(1);
+
+    struct sample_start {
+        thread_cputime_clock::time_point cpu_time;
+        std::chrono::steady_clock::time_point wall_time;
+    };
+    std::optional<sample_start> _sample_start;
+    uint64_t _fragments = 0;
+    uint64_t _samples = 0;
+    std::chrono::nanoseconds _sampled_cpu_time{0};
+public:
+    void on_fragment() noexcept {
+        if (_sample_start) {
+            auto cpu_time = thread_cputime_clock::now() - _sample_start->cpu_time;
+            auto wall_time = std::chrono::steady_clock::now() - _sample_start->wall_time;
+            if (wall_time <= max_sample_duration && cpu_time * 10 >= wall_time * 9) {
+                _sampled_cpu_time += cpu_time;
+                _samples++;
+            }
+            _sample_start.reset();
+        }
+        if (_fragments++ % sample_interval == 0) {
+            _sample_start = sample_start{thread_cputime_clock::now(), std::chrono::steady_clock::now()};
+        }
+    }
+
+    // Returns zero if there are no usable samples.
+    std::chrono::nanoseconds estimated_cpu_time() const noexcept {
+        return _samples ? _sampled_cpu_time / _samples * _fragments : std::chrono::nanoseconds(0);
+    }
+};
+
 class compaction;
 
 class compaction_write_monitor final : public sstables::write_monitor, public backlog_write_progress_manager {
@@ -452,19 +502,60 @@ class compacted_fragments_writer {
 using use_backlog_tracker = bool_class<class use_backlog_tracker_tag>;
 
 struct compaction_read_monitor_generator final : public sstables::read_monitor_generator {
+    // Monitors the reader of one of the token ranges of an sstable which is
+    // compacted by parallel token ranges.
+    class range_read_monitor final : public sstables::read_monitor {
+        const sstables::reader_position_tracker* _tracker = nullptr;
+        std::optional<uint64_t> _start;
+        uint64_t _last_position_seen = 0;
+        noncopyable_function<void ()> _on_read_started;
+    public:
+        explicit range_read_monitor(noncopyable_function<void ()> on_read_started)
+            : _on_read_started(std::move(on_read_started)) { }
+
+        virtual void on_read_started(const sstables::reader_position_tracker& tracker) override {
+            _tracker = &tracker;
+            if (!_start) {
+                _start = tracker.position;
+            }
+            _on_read_started();
+        }
+
+        virtual void on_read_completed() override {
+            if (_tracker) {
+                _last_position_seen = _tracker->position;
+                _tracker = nullptr;
+            }
+        }
+
+        uint64_t compacted() const {
+            auto position = _tracker ? _tracker->position : _last_position_seen;
+            return position - std::min(position, _start.value_or(0));
+        }
+    };
+
+    class range_generator;
+
     class compaction_read_monitor final : public  sstables::read_monitor, public backlog_read_progress_manager {
         sstables::shared_sstable _sst;
         compaction_group_view& _table_s;
         const sstables::reader_position_tracker* _tracker = nullptr;
         uint64_t _last_position_seen = 0;
         use_backlog_tracker _use_backlog_tracker;
-    public:
-        virtual void on_read_started(const sstables::reader_position_tracker& tracker) override {
-            _tracker = &tracker;
+        // If the sstable is compacted by parallel token ranges, its progress
+        // is the sum of the progress of the readers of the ranges.
+        std::vector<const range_read_monitor*> _range_monitors;
+
+        void register_compacting_sstable() {
             if (_use_backlog_tracker) {
                 _table_s.get_backlog_tracker().register_compacting_sstable(_sst, *this);
             }
         }
+    public:
+        virtual void on_read_started(const sstables::reader_position_tracker& tracker) override {
+            _tracker = &tracker;
+            register_compacting_sstable();
+        }
 
         virtual void on_read_completed() override {
             if (_tracker) {
@@ -474,6 +565,9 @@ struct compaction_read_monitor_generator final : public sstables::read_monitor_g
         }
 
         virtual uint64_t compacted() const override {
+            if (!_range_monitors.empty()) {
+                return std::ranges::fold_left(_range_monitors | std::views::transform(std::mem_fn(&range_read_monitor::compacted)), uint64_t(0), std::plus());
+            }
             if (_tracker) {
                 return _tracker->position;
             }
@@ -499,6 +593,28 @@ struct compaction_read_monitor_generator final : public sstables::read_monitor_g
         }
 
         friend class compaction_read_monitor_generator;
+        friend class range_generator;
+    };
+
+    // Generates monitors for the readers of one of the token ranges of a
+    // compaction by parallel token ranges, see make_range_generator().
+    class range_generator final : public sstables::read_monitor_generator {
+        compaction_read_monitor_generator& _parent;
+        std::unordered_map<sstables::generation_type, range_read_monitor> _generated_monitors;
+    public:
+        explicit range_generator(compaction_read_monitor_generator& parent) : _parent(parent) { }
+
+        virtual sstables::read_monitor& operator()(sstables::shared_sstable sst) override {
+            auto it = _generated_monitors.find(sst->generation());
+            if (it == _generated_monitors.end()) {
+                auto& parent_monitor = static_cast<compaction_read_monitor&>(_parent(sst));
+                it = _generated_monitors.try_emplace(sst->generation(), [&parent_monitor] {
+                    parent_monitor.register_compacting_sstable();
+                }).first;
+                parent_monitor._range_monitors.push_back(&it->second);
+            }
+            return it->second;
+        }
     };
 
     virtual sstables::read_monitor& operator()(sstables::shared_sstable sst) override {
@@ -506,6 +622,15 @@ struct compaction_read_monitor_generator final : public sstables::read_monitor_g
         return p.first->second;
     }
 
+    // Returns a generator for the readers of one of the token ranges of a
+    // compaction by parallel token ranges. The monitors of an sstable
+    // generated by this generator account their progress to the monitor
+    // generated by this object, so that the backlog tracker sees the
+    // progress of all ranges.
+    range_generator& make_range_generator() {
+        return _range_generators.emplace_back(*this);
+    }
+
     explicit compaction_read_monitor_generator(compaction_group_view& table_s, use_backlog_tracker use_backlog_tracker = use_backlog_tracker::yes)
         : _table_s(table_s), _use_backlog_tracker(use_backlog_tracker) {}
 
@@ -524,6 +649,7 @@ struct compaction_read_monitor_generator final : public sstables::read_monitor_g
 private:
     compaction_group_view& _table_s;
     std::unordered_map<sstables::generation_type, compaction_read_monitor> _generated_monitors;
+    std::deque<range_generator> _range_generators;
     use_backlog_tracker _use_backlog_tracker;
 
     friend class compaction_progress_monitor;
@@ -576,6 +702,7 @@ class compaction {
     uint64_t _bloom_filter_checks = 0;
     combined_reader_statistics _reader_statistics;
     tombstone_purge_stats _tombstone_purge_stats;
+    compaction_cpu_time_sampler _cpu_time_sampler;
     db::replay_position _rp;
     encoding_stats_collector _stats_collector;
     const bool _can_split_large_partition = false;
@@ -601,6 +728,19 @@ class compaction {
     // optional tombstone_gc_state that is used when gc has to check only the compacting sstables to collect tombstones.
     std::optional<tombstone_gc_state> _tombstone_gc_state_with_commitlog_check_disabled;
     int64_t _output_repaired_at = 0;
+    // Token ranges covered by the cached index pages of the input sstables,
+    // whose index pages are read into the cache of the output sstables if
+    // compaction_preheat_key_cache is set.
+    dht::token_range_vector _index_cache_preheat_ranges;
+    // Input sstables which are copied through to the output, paired with
+    // the output sstables they are copied to, see select_copy_through_sstables().
+    std::vector<std::pair<sstables::shared_sstable, sstables::shared_sstable>> _copy_through;
+    const unsigned _token_range_parallelism;
+    // Disjoint token ranges which are compacted concurrently, if the input is
+    // split, see split_into_parallel_ranges(), and the max purgeable selectors
+    // of each range.
+    std::vector<dht::partition_range> _parallel_ranges;
+    std::vector<std::optional<sstables::sstable_set::incremental_selector>> _parallel_range_selectors;
 private:
     // Keeps track of monitors for input sstable.
     // If _update_backlog_tracker is set to true, monitors are responsible for adjusting backlog as compaction progresses.
@@ -650,6 +790,7 @@ class compaction {
         , _sharder(descriptor.sharder)
         , _owned_ranges_checker(_owned_ranges ? std::optional<dht::incremental_owned_ranges_checker>(*_owned_ranges) : std::nullopt)
         , _tombstone_gc_state_with_commitlog_check_disabled(descriptor.gc_check_only_compacting_sstables ? std::make_optional(_table_s.get_tombstone_gc_state().with_commitlog_check_disabled()) : std::nullopt)
+        , _token_range_parallelism(descriptor.token_range_parallelism)
         , _progress_monitor(progress_monitor)
     {
         std::unordered_set<sstables::run_id> ssts_run_ids;
@@ -670,6 +811,8 @@ class compaction {
         // some tests use _max_sstable_size == 0 for force many one partition per sstable
         auto max_sstable_size = std::max<uint64_t>(_max_sstable_size, 1);
         uint64_t estimated_sstables = std::max(1UL, uint64_t(ceil(double(_compacting_data_file_size) / max_sstable_size)));
+        // Each of the parallel token ranges is written into sstables of its own.
+        estimated_sstables = std::max<uint64_t>(estimated_sstables, _parallel_ranges.size());
         return std::min(uint64_t(ceil(double(_estimated_partitions) / estimated_sstables)),
                         _table_s.get_compaction_strategy().adjust_partition_estimate(_ms_metadata, _estimated_partitions, _schema));
     }
@@ -686,11 +829,24 @@ class compaction {
         writer->writer.set_repaired_at(_output_repaired_at);
         writer->writer.consume_end_of_stream();
         writer->sst->open_data().get();
+        preheat_index_cache(writer->sst);
         _end_size += writer->sst->bytes_on_disk();
         _new_unused_sstables.push_back(writer->sst);
         _new_partial_sstables.erase(writer->sst);
     }
 
+    // Called in a seastar thread
+    void preheat_index_cache(const sstables::shared_sstable& sst) {
+        if (_index_cache_preheat_ranges.empty()) {
+            return;
+        }
+        try {
+            sst->populate_index_cache(_index_cache_preheat_ranges).get();
+        } catch (...) {
+            log_debug("Failed to preheat the index cache of {}: {}", sst->get_filename(), std::current_exception());
+        }
+    }
+
     sstables::sstable_writer_config make_sstable_writer_config(compaction_type type) {
         auto s = compaction_name(type);
         std::transform(s.begin(), s.end(), s.begin(), [] (char c) {
@@ -779,8 +935,28 @@ class compaction {
         return _used_garbage_collected_sstables;
     }
 
+    // Incremental compaction is disabled when compacting by parallel token
+    // ranges: an input sstable is only exhausted once all ranges are done.
     virtual bool enable_garbage_collected_sstable_writer() const noexcept {
-        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && bool(_replacer);
+        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && bool(_replacer)
+                && _parallel_ranges.empty();
+    }
+
+    // Called by setup() with the fully expired input sstables, before the
+    // inputs are inspected. Inputs erased from _sstables are left untouched.
+    virtual void filter_input_sstables(const std::unordered_set<sstables::shared_sstable>& fully_expired) {
+    }
+
+    // Whether input sstables which need no rewrite can be copied through to
+    // the output, see select_copy_through_sstables().
+    virtual bool enable_copy_through() const noexcept {
+        return false;
+    }
+
+    // Whether the input can be split into token ranges compacted
+    // concurrently, see split_into_parallel_ranges().
+    virtual bool enable_parallel_token_ranges() const noexcept {
+        return false;
     }
 public:
     compaction& operator=(const compaction&) = delete;
@@ -800,20 +976,22 @@ class compaction {
                                                         const query::partition_slice& slice,
                                                         tracing::trace_state_ptr,
                                                         streamed_mutation::forwarding fwd,
-                                                        mutation_reader::forwarding) = 0;
+                                                        mutation_reader::forwarding,
+                                                        sstables::read_monitor_generator& monitor_generator) = 0;
 
-    mutation_reader setup_sstable_reader() {
+    mutation_reader setup_sstable_reader(const dht::partition_range& range, sstables::read_monitor_generator& monitor_generator) {
         if (!_owned_ranges_checker) {
             return make_sstable_reader(_schema,
                                        _permit,
-                                       query::full_partition_range,
+                                       range,
                                        _schema->full_slice(),
                                        tracing::trace_state_ptr(),
                                        ::streamed_mutation::forwarding::no,
-                                       ::mutation_reader::forwarding::no);
+                                       ::mutation_reader::forwarding::no,
+                                       monitor_generator);
         }
 
-        auto source = mutation_source([this] (schema_ptr s,
+        auto source = mutation_source([this, &monitor_generator] (schema_ptr s,
                 reader_permit permit,
                 const dht::partition_range& range,
                 const query::partition_slice& slice,
@@ -827,7 +1005,8 @@ class compaction {
                                        slice,
                                        std::move(trace_state),
                                        fwd,
-                                       fwd_mr);
+                                       fwd_mr,
+                                       monitor_generator);
         });
 
         auto owned_range_generator = [this] () -> std::optional<dht::partition_range> {
@@ -853,9 +1032,143 @@ class compaction {
         return _tombstone_gc_state_with_commitlog_check_disabled ? _tombstone_gc_state_with_commitlog_check_disabled.value() : _table_s.get_tombstone_gc_state();
     }
 
+    // Whether sst has nothing which compaction could change, other than
+    // its level, if it doesn't overlap any other input.
+    bool can_copy_through(const sstables::shared_sstable& sst, gc_clock::time_point compaction_time) const {
+        // Copying through sstables which stay at the same level would make no
+        // progress, and the strategy could pick the copies again.
+        if (sst->get_sstable_level() == _sstable_level || sst->data_size() > _max_sstable_size) {
+            return false;
+        }
+        if (sst->is_shared() || !sst->get_storage().supports_snapshot()) {
+            return false;
+        }
+        // Let compaction apply changes of the compression parameters.
+        const auto& compression = sst->get_compression();
+        const auto& params = _schema->get_compressor_params();
+        if (bool(compression) != params.compression_enabled()) {
+            return false;
+        }
+        if (compression) {
+            auto sst_params = compression_parameters(sstables::options_from_compression(compression));
+            if (sst_params.get_algorithm() != params.get_algorithm()
+                    || sst_params.chunk_length() != params.chunk_length()
+                    || sst_params.zstd_compression_level() != params.zstd_compression_level()) {
+                return false;
+            }
+        }
+        if (!tombstone_expiration_enabled()) {
+            return true;
+        }
+        // Nothing can be purged if all tombstones and expiring cells were
+        // written after gc_before.
+        auto range = dht::token_range::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+        auto gc_before = get_tombstone_gc_state().get_gc_before_for_range(_schema, range, compaction_time).max_gc_before;
+        return sst->get_min_local_deletion_time() >= gc_before;
+    }
+
+    // Selects the input sstables which are copied through to the output, by
+    // linking their components under a new generation, instead of being
+    // rewritten. That's the case for sstables which are only moved to another
+    // level, e.g. by LCS promotions: they don't overlap any other input, so
+    // there is nothing to merge, and they have nothing to purge.
+    //
+    // The sstables must have the format of the output sstables, so upgrade
+    // compactions always rewrite them.
+    void select_copy_through_sstables(const std::unordered_set<sstables::shared_sstable>& fully_expired, gc_clock::time_point compaction_time) {
+        if (!enable_copy_through() || _owned_ranges) {
+            return;
+        }
+        auto inputs = _sstables
+                | std::views::filter([&] (const sstables::shared_sstable& sst) { return !fully_expired.contains(sst); })
+                | std::ranges::to<std::vector>();
+        std::ranges::sort(inputs, [this] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(*_schema, b->get_first_decorated_key()) < 0;
+        });
+        const dht::decorated_key* max_last_key = nullptr;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const auto& sst = inputs[i];
+            bool overlaps = (max_last_key && max_last_key->tri_compare(*_schema, sst->get_first_decorated_key()) >= 0)
+                    || (i + 1 < inputs.size() && inputs[i + 1]->get_first_decorated_key().tri_compare(*_schema, sst->get_last_decorated_key()) <= 0);
+            if (!max_last_key || max_last_key->tri_compare(*_schema, sst->get_last_decorated_key()) < 0) {
+                max_last_key = &sst->get_last_decorated_key();
+            }
+            if (overlaps || !can_copy_through(sst, compaction_time)) {
+                continue;
+            }
+            auto out = _sstable_creator(this_shard_id());
+            if (out->get_version() != sst->get_version() || out->get_storage().prefix() != sst->get_storage().prefix()) {
+                return;
+            }
+            _copy_through.emplace_back(sst, std::move(out));
+        }
+    }
+
+    // Called in a seastar thread
+    void copy_through_sstables() {
+        for (auto& [sst, out] : _copy_through) {
+            _all_new_sstables.push_back(out);
+            _new_partial_sstables.insert(out);
+            sst->clone(out->generation()).get();
+            sstables::sstable_open_config cfg;
+            cfg.current_shard_as_sstable_owner = true;
+            out->load(_schema->get_sharder(), cfg).get();
+            out->mutate_sstable_level(_sstable_level).get();
+            out->mutate_run_identifier(_run_identifier).get();
+            log_debug("Copied {} through to {}", sst->get_filename(), out->get_filename());
+            _end_size += out->bytes_on_disk();
+            _new_unused_sstables.push_back(out);
+            _new_partial_sstables.erase(out);
+        }
+    }
+
+    // Splits the token range spanned by the input into _token_range_parallelism
+    // ranges of equal width, which are compacted concurrently. Tokens are
+    // uniformly distributed, so the ranges hold similar amounts of data.
+    //
+    // The merges of the ranges share the shard and its compaction scheduling
+    // group, so their CPU usage is still bounded by the shares of the group,
+    // but the reads and writes of a range can proceed while another range
+    // uses the CPU.
+    void split_into_parallel_ranges() {
+        if (_token_range_parallelism <= 1 || !enable_parallel_token_ranges() || _owned_ranges || _compacting->empty()) {
+            return;
+        }
+        auto all = _compacting->all();
+        auto first = std::ranges::min(*all | std::views::transform([] (const sstables::shared_sstable& sst) {
+            return sst->get_first_decorated_key().token();
+        })).unbias();
+        auto last = std::ranges::max(*all | std::views::transform([] (const sstables::shared_sstable& sst) {
+            return sst->get_last_decorated_key().token();
+        })).unbias();
+        if (last - first < _token_range_parallelism) {
+            return;
+        }
+        auto width = (last - first) / _token_range_parallelism;
+        std::vector<dht::token> boundaries;
+        for (unsigned i = 1; i < _token_range_parallelism; ++i) {
+            boundaries.push_back(dht::token::bias(first + i * width));
+        }
+        _parallel_ranges.push_back(dht::to_partition_range(dht::token_range::make_ending_with({boundaries.front(), true})));
+        for (size_t i = 1; i < boundaries.size(); ++i) {
+            _parallel_ranges.push_back(dht::to_partition_range(dht::token_range::make({boundaries[i - 1], false}, {boundaries[i], true})));
+        }
+        _parallel_ranges.push_back(dht::to_partition_range(dht::token_range::make_starting_with({boundaries.back(), false})));
+        _parallel_range_selectors.resize(_parallel_ranges.size());
+        if (_sstable_set) {
+            for (auto& selector : _parallel_range_selectors) {
+                selector.emplace(_sstable_set->make_incremental_selector());
+            }
+        }
+        log_debug("Compacting {} token ranges in parallel", _parallel_ranges.size());
+    }
+
     future<> setup() {
         auto ssts = make_lw_shared<sstables::sstable_set>(make_sstable_set_for_input());
         auto fully_expired = _table_s.fully_expired_sstables(_sstables, gc_clock::now());
+        filter_input_sstables(fully_expired);
+        select_copy_through_sstables(fully_expired, gc_clock::now());
+        auto copied_through = _copy_through | std::views::keys | std::ranges::to<std::unordered_set>();
         min_max_tracker<api::timestamp_type> timestamp_tracker;
 
         double sum_of_estimated_droppable_tombstone_ratio = 0;
@@ -885,6 +1198,9 @@ class compaction {
                 log_debug("Fully expired sstable {} will be dropped on compaction completion", sst->get_filename());
                 continue;
             }
+            if (copied_through.contains(sst)) {
+                continue;
+            }
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
 
             compaction_size += sst->data_size();
@@ -896,6 +1212,9 @@ class compaction {
             _estimated_partitions += sst->get_estimated_key_count();
             sum_of_estimated_droppable_tombstone_ratio += sst->estimate_droppable_tombstone_ratio(gc_clock::now(), get_tombstone_gc_state(), _schema);
             _compacting_data_file_size += sst->ondisk_data_size();
+            if (sst->manager().config().compaction_preheat_key_cache()) {
+                std::ranges::move(sst->cached_index_token_ranges(), std::back_inserter(_index_cache_preheat_ranges));
+            }
             _compacting_max_timestamp = std::max(_compacting_max_timestamp, sst->get_stats_metadata().max_timestamp);
             if (sst->originated_on_this_node().value_or(false) && sst_stats.position.shard_id() == this_shard_id()) {
                 _rp = std::max(_rp, sst_stats.position);
@@ -915,6 +1234,7 @@ class compaction {
         _estimated_droppable_tombstone_ratio = std::min(1.0, sum_of_estimated_droppable_tombstone_ratio / ssts->size());
 
         _compacting = std::move(ssts);
+        split_into_parallel_ranges();
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
@@ -923,7 +1243,7 @@ class compaction {
     // This consumer will perform mutation compaction on producer side using
     // compacting_reader. It's useful for allowing data from different buckets
     // to be compacted together.
-    future<> consume_without_gc_writer(gc_clock::time_point compaction_time) {
+    future<> consume_without_gc_writer(gc_clock::time_point compaction_time, mutation_reader sstable_reader, max_purgeable_fn max_purgeable) {
         auto consumer = make_interposer_consumer([this] (mutation_reader reader) mutable {
             return seastar::async([this, reader = std::move(reader)] () mutable {
                 auto close_reader = deferred_close(reader);
@@ -932,27 +1252,28 @@ class compaction {
             });
         });
         const auto& gc_state = get_tombstone_gc_state();
-        return consumer(make_compacting_reader(setup_sstable_reader(), compaction_time, max_purgeable_func(), gc_state,
+        return consumer(make_compacting_reader(std::move(sstable_reader), compaction_time, std::move(max_purgeable), gc_state,
                                                streamed_mutation::forwarding::no, &_tombstone_purge_stats));
     }
 
-    future<> consume() {
+    future<> consume(const dht::partition_range& range, sstables::read_monitor_generator& monitor_generator,
+            std::optional<sstables::sstable_set::incremental_selector>& selector) {
         auto now = gc_clock::now();
         // consume_without_gc_writer(), which uses compacting_reader, is ~3% slower.
         // let's only use it when GC writer is disabled and interposer consumer is enabled, as we
         // wouldn't like others to pay the penalty for something they don't need.
         if (!enable_garbage_collected_sstable_writer() && use_interposer_consumer()) {
-            return consume_without_gc_writer(now);
+            return consume_without_gc_writer(now, setup_sstable_reader(range, monitor_generator), max_purgeable_func(selector));
         }
-        auto consumer = make_interposer_consumer([this, now] (mutation_reader reader) mutable
+        auto consumer = make_interposer_consumer([this, now, &selector] (mutation_reader reader) mutable
         {
-            return seastar::async([this, reader = std::move(reader), now] () mutable {
+            return seastar::async([this, reader = std::move(reader), now, &selector] () mutable {
                 auto close_reader = deferred_close(reader);
 
                 if (enable_garbage_collected_sstable_writer()) {
                     using compact_mutations = compact_for_compaction<compacted_fragments_writer, compacted_fragments_writer>;
                     auto cfc = compact_mutations(*schema(), now,
-                        max_purgeable_func(),
+                        max_purgeable_func(selector),
                         get_tombstone_gc_state(),
                         get_compacted_fragments_writer(),
                         get_gc_compacted_fragments_writer(),
@@ -963,7 +1284,7 @@ class compaction {
                 }
                 using compact_mutations = compact_for_compaction<compacted_fragments_writer, noop_compacted_fragments_consumer>;
                 auto cfc = compact_mutations(*schema(), now,
-                    max_purgeable_func(),
+                    max_purgeable_func(selector),
                     get_tombstone_gc_state(),
                     get_compacted_fragments_writer(),
                     noop_compacted_fragments_consumer(),
@@ -971,7 +1292,19 @@ class compaction {
                 reader.consume_in_thread(std::move(cfc));
             });
         });
-        return consumer(setup_sstable_reader());
+        return consumer(setup_sstable_reader(range, monitor_generator));
+    }
+
+    future<> consume() {
+        if (_parallel_ranges.empty()) {
+            return consume(query::full_partition_range, unwrap_monitor_generator(), _selector);
+        }
+        // Each range has its own writers, so the output sstables of a range
+        // don't overlap the ones of other ranges.
+        auto& generator = dynamic_cast<compaction_read_monitor_generator&>(unwrap_monitor_generator());
+        return parallel_for_each(std::views::iota(size_t(0), _parallel_ranges.size()), [this, &generator] (size_t i) {
+            return consume(_parallel_ranges[i], generator.make_range_generator(), _parallel_range_selectors[i]);
+        });
     }
 
     // based on the specified policies, the `compaction` base class designates
@@ -1013,6 +1346,7 @@ class compaction {
                 .bloom_filter_checks = _bloom_filter_checks,
                 .reader_statistics = std::move(_reader_statistics),
                 .tombstone_purge_stats = std::move(_tombstone_purge_stats),
+                .estimated_cpu_time = _cpu_time_sampler.estimated_cpu_time(),
             },
         };
 
@@ -1045,12 +1379,14 @@ class compaction {
     virtual std::string_view report_start_desc() const = 0;
     virtual std::string_view report_finish_desc() const = 0;
 
-    max_purgeable_fn max_purgeable_func() {
+    // The selector has to be used for increasing keys only, so each of the
+    // parallel token ranges has its own.
+    max_purgeable_fn max_purgeable_func(std::optional<sstables::sstable_set::incremental_selector>& selector) {
         if (!tombstone_expiration_enabled()) {
             return can_never_purge;
         }
-        return [this] (const dht::decorated_key& dk, is_shadowable is_shadowable) {
-            return get_max_purgeable_timestamp(_table_s, *_selector, _compacting_for_max_purgeable_func, dk, _bloom_filter_checks, _compacting_max_timestamp, _tombstone_gc_state_with_commitlog_check_disabled.has_value(), is_shadowable);
+        return [this, &selector] (const dht::decorated_key& dk, is_shadowable is_shadowable) {
+            return get_max_purgeable_timestamp(_table_s, *selector, _compacting_for_max_purgeable_func, dk, _bloom_filter_checks, _compacting_max_timestamp, _tombstone_gc_state_with_commitlog_check_disabled.has_value(), is_shadowable);
         };
     }
 
@@ -1189,6 +1525,7 @@ void compacted_fragments_writer::do_consume_new_partition(const dht::decorated_k
     }
 
     _c.on_new_partition();
+    _c._cpu_time_sampler.on_fragment();
     _compaction_writer->writer.consume_new_partition(dk);
     _unclosed_partition = true;
 }
@@ -1217,6 +1554,7 @@ void compacted_fragments_writer::consume(tombstone t) {
 
 stop_iteration compacted_fragments_writer::consume(clustering_row&& cr, row_tombstone, bool) {
     maybe_abort_compaction();
+    _c._cpu_time_sampler.on_fragment();
     if (_current_partition.is_splitting_partition) [[unlikely]] {
         split_large_partition();
     }
@@ -1230,6 +1568,7 @@ stop_iteration compacted_fragments_writer::consume(clustering_row&& cr, row_tomb
 
 stop_iteration compacted_fragments_writer::consume(range_tombstone_change&& rtc) {
     maybe_abort_compaction();
+    _c._cpu_time_sampler.on_fragment();
     _current_partition.current_emitted_tombstone = rtc.tombstone();
     track_last_position(rtc.position());
     return _compaction_writer->writer.consume(std::move(rtc));
@@ -1264,7 +1603,8 @@ class regular_compaction : public compaction {
                                                 const query::partition_slice& slice,
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
-                                                mutation_reader::forwarding mr_fwd) override {
+                                                mutation_reader::forwarding mr_fwd,
+                                                sstables::read_monitor_generator& monitor_generator) override {
         return _compacting->make_local_shard_sstable_reader(std::move(s),
                 std::move(permit),
                 range,
@@ -1272,7 +1612,7 @@ class regular_compaction : public compaction {
                 std::move(trace),
                 sm_fwd,
                 mr_fwd,
-                unwrap_monitor_generator(),
+                monitor_generator,
                 sstables::default_sstable_predicate(),
                 &_reader_statistics,
                 sstables::integrity_check::yes);
@@ -1310,6 +1650,14 @@ class regular_compaction : public compaction {
     virtual void on_end_of_compaction() override {
         replace_remaining_exhausted_sstables();
     }
+
+    virtual bool enable_copy_through() const noexcept override {
+        return _type == compaction_type::Compaction;
+    }
+
+    virtual bool enable_parallel_token_ranges() const noexcept override {
+        return _type == compaction_type::Compaction || _type == compaction_type::Major;
+    }
 private:
     void maybe_replace_exhausted_sstables_by_sst(sstables::shared_sstable sst) {
         // Skip earlier replacement of exhausted sstables if compaction works with only single-fragment runs,
@@ -1386,6 +1734,9 @@ class regular_compaction : public compaction {
             }
         }
         _selector.emplace(_sstable_set->make_incremental_selector());
+        for (auto& selector : _parallel_range_selectors) {
+            selector.emplace(_sstable_set->make_incremental_selector());
+        }
     }
 };
 
@@ -1414,7 +1765,8 @@ class reshape_compaction : public regular_compaction {
                                                 const query::partition_slice& slice,
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
-                                                mutation_reader::forwarding mr_fwd) override {
+                                                mutation_reader::forwarding mr_fwd,
+                                                sstables::read_monitor_generator& monitor_generator) override {
         return _compacting->make_local_shard_sstable_reader(std::move(s),
                 std::move(permit),
                 range,
@@ -1422,7 +1774,7 @@ class reshape_compaction : public regular_compaction {
                 std::move(trace),
                 sm_fwd,
                 mr_fwd,
-                unwrap_monitor_generator(),
+                monitor_generator,
                 sstables::default_sstable_predicate(),
                 nullptr,
                 sstables::integrity_check::yes);
@@ -1477,6 +1829,36 @@ class cleanup_compaction final : public regular_compaction {
     }
 };
 
+// Drops fully expired sstables, see compaction_manager::perform_garbage_collection().
+// Nothing is written: setup() skips the fully expired inputs, and the inputs
+// which are no longer fully expired, e.g. because sstables with older data
+// were added since they were picked, are left to regular compaction.
+class garbage_collection_compaction final : public regular_compaction {
+public:
+    garbage_collection_compaction(compaction_group_view& table_s, compaction_descriptor descriptor, compaction_data& cdata, compaction_progress_monitor& progress_monitor)
+        : regular_compaction(table_s, std::move(descriptor), cdata, progress_monitor)
+    {
+    }
+
+    void filter_input_sstables(const std::unordered_set<sstables::shared_sstable>& fully_expired) override {
+        std::erase_if(_sstables, [&] (const sstables::shared_sstable& sst) {
+            if (tombstone_expiration_enabled() && fully_expired.contains(sst)) {
+                return false;
+            }
+            log_debug("Sstable {} can no longer be dropped, skipping", sst->get_filename());
+            return true;
+        });
+    }
+
+    std::string_view report_start_desc() const override {
+        return "Garbage collecting";
+    }
+
+    std::string_view report_finish_desc() const override {
+        return "Garbage collected";
+    }
+};
+
 class split_compaction final : public regular_compaction {
     compaction_type_options::split _options;
 public:
@@ -1830,11 +2212,12 @@ class scrub_compaction final : public regular_compaction {
                                                 const query::partition_slice& slice,
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
-                                                mutation_reader::forwarding mr_fwd) override {
+                                                mutation_reader::forwarding mr_fwd,
+                                                sstables::read_monitor_generator& monitor_generator) override {
         if (!range.is_full()) {
             on_internal_error(clogger, fmt::format("Scrub compaction in mode {} expected full partition range, but got {} instead", _options.operation_mode, range));
         }
-        auto full_scan_reader = _compacting->make_full_scan_reader(std::move(s), std::move(permit), nullptr, unwrap_monitor_generator(), sstables::integrity_check::yes);
+        auto full_scan_reader = _compacting->make_full_scan_reader(std::move(s), std::move(permit), nullptr, monitor_generator, sstables::integrity_check::yes);
         return make_mutation_reader<reader>(std::move(full_scan_reader), _options.operation_mode, _validation_errors, _failed_to_fix_sstable, _options.drop_unfixable);
     }
 
@@ -1965,7 +2348,8 @@ class resharding_compaction final : public compaction {
                                                 const query::partition_slice& slice,
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
-                                                mutation_reader::forwarding mr_fwd) override {
+                                                mutation_reader::forwarding mr_fwd,
+                                                sstables::read_monitor_generator& monitor_generator) override {
         return _compacting->make_range_sstable_reader(std::move(s),
                 std::move(permit),
                 range,
@@ -1973,7 +2357,7 @@ class resharding_compaction final : public compaction {
                 nullptr,
                 sm_fwd,
                 mr_fwd,
-                unwrap_monitor_generator(),
+                monitor_generator,
                 sstables::integrity_check::yes);
 
     }
@@ -2022,11 +2406,11 @@ class resharding_compaction final : public compaction {
 future<compaction_result> compaction::run(std::unique_ptr<compaction> c) {
     return seastar::async([c = std::move(c)] () mutable {
         c->setup().get();
-        auto consumer = c->consume();
 
         auto start_time = db_clock::now();
         try {
-           consumer.get();
+           c->copy_through_sstables();
+           c->consume().get();
         } catch (...) {
             c->on_interrupt(std::current_exception());
             c = nullptr; // make sure writers are stopped while running in thread context. This is because of calls to file.close().get();
@@ -2048,6 +2432,7 @@ compaction_type compaction_type_options::type() const {
         compaction_type::Reshape,
         compaction_type::Split,
         compaction_type::Major,
+        compaction_type::Garbage_collection,
     };
     static_assert(std::variant_size_v<compaction_type_options::options_variant> == std::size(index_to_type));
     return index_to_type[_options.index()];
@@ -2084,6 +2469,9 @@ static std::unique_ptr<compaction> make_compaction(compaction_group_view& table_
         std::unique_ptr<compaction> operator()(compaction_type_options::split split_options) {
             return std::make_unique<split_compaction>(table_s, std::move(descriptor), cdata, std::move(split_options), progress_monitor);
         }
+        std::unique_ptr<compaction> operator()(compaction_type_options::garbage_collection) {
+            return std::make_unique<garbage_collection_compaction>(table_s, std::move(descriptor), cdata, progress_monitor);
+        }
     } visitor_factory{table_s, std::move(descriptor), cdata, progress_monitor};
 
     return descriptor.options.visit(visitor_factory);
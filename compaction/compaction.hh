@@ -82,6 +82,8 @@ struct compaction_stats {
     uint64_t bloom_filter_checks = 0;
     combined_reader_statistics reader_statistics;
     tombstone_purge_stats tombstone_purge_stats;
+    // Estimated CPU time spent by the compaction, zero if unknown.
+    std::chrono::nanoseconds estimated_cpu_time{0};
 
     compaction_stats& operator+=(const compaction_stats& r) {
         started_at = std::max(started_at, r.started_at);
@@ -91,6 +93,7 @@ struct compaction_stats {
         validation_errors += r.validation_errors;
         bloom_filter_checks += r.bloom_filter_checks;
         tombstone_purge_stats += r.tombstone_purge_stats;
+        estimated_cpu_time += r.estimated_cpu_time;
         return *this;
     }
     friend compaction_stats operator+(const compaction_stats& l, const compaction_stats& r) {
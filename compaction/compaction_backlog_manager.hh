@@ -10,8 +10,11 @@
 
 #include <unordered_set>
 #include <memory>
+#include <seastar/core/shared_ptr.hh>
 #include "sstables/shared_sstable.hh"
 #include "mutation/timestamp.hh"
+#include "compaction_cost_model.hh"
+#include "utils/updateable_value.hh"
 
 class compaction_controller;
 
@@ -80,6 +83,14 @@ class compaction_backlog_tracker {
     void register_compacting_sstable(sstables::shared_sstable sst, backlog_read_progress_manager& rp);
     void copy_ongoing_charges(compaction_backlog_tracker& new_bt, bool move_read_charges = true) const;
     void revert_charges(sstables::shared_sstable sst);
+    // The cost model of the source, by which the backlog manager may scale
+    // the backlog, see compaction_cost_model.
+    void set_cost_model(seastar::lw_shared_ptr<const compaction_cost_model> cost_model) noexcept {
+        _cost_model = std::move(cost_model);
+    }
+    const compaction_cost_model* cost_model() const noexcept {
+        return _cost_model.get();
+    }
 
     void disable() {
         _impl = {};
@@ -95,6 +106,7 @@ class compaction_backlog_tracker {
     // changed in the middle of a compaction.
     ongoing_writes _ongoing_writes;
     ongoing_compactions _ongoing_compactions;
+    seastar::lw_shared_ptr<const compaction_cost_model> _cost_model;
     compaction_backlog_manager* _manager = nullptr;
     friend class compaction_backlog_manager;
 };
@@ -115,10 +127,18 @@ class compaction_backlog_manager {
     std::unordered_set<compaction_backlog_tracker*> _backlog_trackers;
     void remove_backlog_tracker(compaction_backlog_tracker* tracker);
     compaction_controller* _compaction_controller;
+    utils::updateable_value<bool> _scale_by_cost;
     friend class compaction_backlog_tracker;
 public:
     ~compaction_backlog_manager();
-    compaction_backlog_manager(compaction_controller& controller) : _compaction_controller(&controller) {}
+    // If scale_by_cost is set, the backlog of each tracker is scaled by the
+    // cost factor of its table divided by the mean cost factor of the tables,
+    // so that the backlog shifts towards the tables which are more expensive
+    // to compact, while a shard whose tables all cost the same keeps its backlog.
+    compaction_backlog_manager(compaction_controller& controller, utils::updateable_value<bool> scale_by_cost = utils::updateable_value<bool>(false))
+        : _compaction_controller(&controller)
+        , _scale_by_cost(std::move(scale_by_cost))
+    {}
     double backlog() const;
     void register_backlog_tracker(compaction_backlog_tracker& tracker);
 };
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace compaction {
+
+// Estimates the effort of compacting a byte of a table, relative to a
+// reference table, from the CPU time and the bytes read and written by the
+// recent compactions of the table. Like the backlog, the effort is measured
+// per input byte.
+//
+// The backlog of a table is measured in bytes, but the effort of compacting
+// a byte varies a lot between tables: compactions of many small cells are
+// CPU-bound, while compactions of large blobs are I/O-bound and barely use
+// the CPU shares they get. If enabled, the backlog manager scales the backlog
+// of a table by its cost_factor() relative to the mean of the tables of the
+// shard, so that the backlog shifts towards the tables which need more effort.
+class compaction_cost_model {
+public:
+    // CPU time per input byte of the reference table, which compacts at
+    // 64MB/s per shard.
+    static constexpr double reference_cpu_seconds_per_byte = 1.0 / (64 << 20);
+    // Bytes read and written per input byte of the reference table, whose
+    // compactions neither purge nor deduplicate data.
+    static constexpr double reference_io_bytes_per_byte = 2.0;
+    // Weight of the last compaction in the moving averages.
+    static constexpr double smoothing_factor = 0.2;
+    static constexpr double min_cost_factor = 0.25;
+    static constexpr double max_cost_factor = 4.0;
+private:
+    std::optional<double> _cpu_seconds_per_byte;
+    std::optional<double> _io_bytes_per_byte;
+
+    static void update_average(std::optional<double>& average, double value) noexcept {
+        average = average ? *average + smoothing_factor * (value - *average) : value;
+    }
+public:
+    // Accounts a compaction which read input_bytes and wrote output_bytes.
+    // cpu_time is the CPU time of the compaction, or zero if unknown.
+    // Compactions which read nothing don't tell the cost per input byte.
+    void update(std::chrono::nanoseconds cpu_time, uint64_t input_bytes, uint64_t output_bytes) noexcept {
+        if (!input_bytes) {
+            return;
+        }
+        if (cpu_time.count() > 0) {
+            update_average(_cpu_seconds_per_byte, std::chrono::duration<double>(cpu_time).count() / input_bytes);
+        }
+        update_average(_io_bytes_per_byte, double(input_bytes + output_bytes) / input_bytes);
+    }
+
+    double cpu_seconds_per_byte() const noexcept {
+        return _cpu_seconds_per_byte.value_or(reference_cpu_seconds_per_byte);
+    }
+
+    double io_bytes_per_byte() const noexcept {
+        return _io_bytes_per_byte.value_or(reference_io_bytes_per_byte);
+    }
+
+    // Returns the effort of compacting a byte of the table, relative to the
+    // reference table. CPU and I/O are weighted equally, since the backlog
+    // controller sets both the CPU and the I/O shares of compaction.
+    double cost_factor() const noexcept {
+        auto cost = 0.5 * cpu_seconds_per_byte() / reference_cpu_seconds_per_byte + 0.5 * io_bytes_per_byte() / reference_io_bytes_per_byte;
+        return std::clamp(cost, min_cost_factor, max_cost_factor);
+    }
+};
+
+}
@@ -30,6 +30,7 @@ enum class compaction_type {
     Reshape = 7,
     Split = 8,
     Major = 9,
+    Garbage_collection = 10, // Drops fully expired sstables, without rewriting live data
 };
 
 struct compaction_completion_desc {
@@ -90,8 +91,10 @@ class compaction_type_options {
     struct split {
         mutation_writer::classify_by_token_group classifier;
     };
+    struct garbage_collection {
+    };
 private:
-    using options_variant = std::variant<regular, cleanup, upgrade, scrub, reshard, reshape, split, major>;
+    using options_variant = std::variant<regular, cleanup, upgrade, scrub, reshard, reshape, split, major, garbage_collection>;
 
 private:
     options_variant _options;
@@ -133,6 +136,10 @@ class compaction_type_options {
         return compaction_type_options(split{std::move(classifier)});
     }
 
+    static compaction_type_options make_garbage_collection() {
+        return compaction_type_options(garbage_collection{});
+    }
+
     template <typename... Visitor>
     auto visit(Visitor&&... visitor) const {
         return std::visit(std::forward<Visitor>(visitor)..., _options);
@@ -193,6 +200,15 @@ struct compaction_descriptor {
     // timestamp comparison, similar to memtables, is performed.
     bool gc_check_only_compacting_sstables = false;
 
+    // Number of disjoint token ranges the input is split into, to be compacted
+    // concurrently. Each range is written into its own sstables, which all
+    // belong to the output run. Only regular and major compactions are split.
+    unsigned token_range_parallelism = 1;
+
+    // Set for jobs which compact the sstables overlapping a token range
+    // dense in droppable tombstones, see compaction_strategy_impl::get_tombstone_purge_job().
+    bool tombstone_purge = false;
+
     compaction_descriptor() = default;
 
     static constexpr int default_level = 0;
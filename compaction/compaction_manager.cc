@@ -31,6 +31,7 @@
 #include "tombstone_gc-internals.hh"
 #include <cmath>
 #include "utils/labels.hh"
+#include "utils/pretty_printers.hh"
 
 static logging::logger cmlog("compaction_manager");
 using namespace std::chrono_literals;
@@ -457,7 +458,12 @@ future<compaction_result> compaction_task_executor::compact_sstables(compaction_
         }
     }
 
-    co_return co_await ::compaction::compact_sstables(std::move(descriptor), cdata, t, _progress_monitor);
+    auto res = co_await ::compaction::compact_sstables(std::move(descriptor), cdata, t, _progress_monitor);
+    // The table may have been dropped while it was compacted.
+    if (auto cost_model = _cm.find_cost_model(t.schema()->id())) {
+        cost_model->update(res.stats.estimated_cpu_time, res.stats.start_size, res.stats.end_size);
+    }
+    co_return res;
 }
 future<> compaction_task_executor::update_history(compaction_group_view& t, compaction_result&& res, const ::compaction::compaction_data& cdata) {
     auto started_at = std::chrono::duration_cast<std::chrono::milliseconds>(res.stats.started_at.time_since_epoch());
@@ -540,6 +546,9 @@ class sstables_task_executor : public compaction_task_executor, public sstables_
     }
 };
 
+// Minimum amount of input data of each of the token ranges a major compaction is split into.
+static constexpr uint64_t min_major_token_range_size = 1024 * 1024 * 1024;
+
 class major_compaction_task_executor : public compaction_task_executor, public major_compaction_task_impl {
 public:
     major_compaction_task_executor(compaction_manager& mgr,
@@ -586,6 +595,9 @@ class major_compaction_task_executor : public compaction_task_executor, public m
         compaction_strategy cs = t->get_compaction_strategy();
         compaction_descriptor descriptor = cs.get_major_compaction_job(*t, co_await _cm.get_candidates(*t));
         descriptor.gc_check_only_compacting_sstables = _consider_only_existing_data;
+        // Don't split the input into ranges smaller than min_major_token_range_size.
+        descriptor.token_range_parallelism = std::clamp<uint64_t>(descriptor.sstables_size() / min_major_token_range_size,
+                1, std::max(_cm.major_token_range_parallelism(), 1u));
         auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(t), descriptor.sstables);
         auto on_replace = compacting.update_on_sstable_replacement();
         setup_new_compaction(descriptor.run_identifier);
@@ -1026,7 +1038,7 @@ compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task
         }
         return b;
     }))
-    , _backlog_manager(_compaction_controller)
+    , _backlog_manager(_compaction_controller, _cfg.scale_backlog_by_cost)
     , _early_abort_subscription(as.subscribe([this] () noexcept {
         do_stop();
     }))
@@ -1102,6 +1114,10 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_counter("tombstone_purge_compactions", [this] { return _stats.tombstone_purge_compactions; },
+                       sm::description("Holds the number of completed compactions of sstables overlapping token ranges dense in droppable tombstones.")),
+        sm::make_counter("tombstone_purge_bytes_reclaimed", [this] { return _stats.tombstone_purge_bytes_reclaimed; },
+                       sm::description("Holds the number of bytes by which tombstone purge compactions shrank their input.")),
     });
 }
 
@@ -1444,7 +1460,14 @@ class regular_compaction_task_executor : public compaction_task_executor, public
 
             try {
                 bool should_update_history = this->should_update_history(descriptor.options.type());
+                bool tombstone_purge = descriptor.tombstone_purge;
                 compaction_result res = co_await compact_sstables(std::move(descriptor), _compaction_data, on_replace);
+                if (tombstone_purge) {
+                    auto reclaimed = res.stats.start_size - std::min(res.stats.start_size, res.stats.end_size);
+                    cmlog.info("{}: tombstone purge compaction reclaimed {}", *this, utils::pretty_printed_data_size(reclaimed));
+                    _cm._stats.tombstone_purge_compactions++;
+                    _cm._stats.tombstone_purge_bytes_reclaimed += reclaimed;
+                }
                 cmlog.debug("Finished minor compaction old_sstables={} new_sstables={} sstables_reapired_at={} range={} uuid={} compaction_uuid={}",
                         old_sstables, res.new_sstables, compacting_table()->get_sstables_repaired_at(), compacting_table()->token_range(), uuid, _compaction_data.compaction_uuid);
                 finish_compaction();
@@ -1846,6 +1869,27 @@ class split_compaction_task_executor final : public rewrite_sstables_compaction_
     }
 };
 
+class garbage_collection_compaction_task_executor final : public rewrite_sstables_compaction_task_executor {
+public:
+    garbage_collection_compaction_task_executor(compaction_manager& mgr,
+                                       throw_if_stopping do_throw_if_stopping,
+                                       compaction_group_view* t,
+                                       tasks::task_id parent_id,
+                                       compaction_type_options options,
+                                       owned_ranges_ptr owned_ranges,
+                                       std::vector<sstables::shared_sstable> sstables,
+                                       compacting_sstable_registration compacting)
+            : rewrite_sstables_compaction_task_executor(mgr, do_throw_if_stopping, t, parent_id, std::move(options), std::move(owned_ranges),
+                std::move(sstables), std::move(compacting), compaction_manager::can_purge_tombstones::yes)
+    {}
+protected:
+    compaction_descriptor make_descriptor(const sstables::shared_sstable& sst) const override {
+        auto descriptor = compaction_descriptor(has_only_fully_expired::yes, { sst });
+        descriptor.options = compaction_type_options::make_garbage_collection();
+        return descriptor;
+    }
+};
+
 template<typename TaskType, typename... Args>
 requires std::derived_from<TaskType, compaction_task_executor> &&
          std::derived_from<TaskType, compaction_task_impl>
@@ -2268,6 +2312,20 @@ future<> compaction_manager::perform_sstable_upgrade(owned_ranges_ptr sorted_own
     co_await rewrite_sstables(t, compaction_type_options::make_upgrade(), std::move(sorted_owned_ranges), std::move(get_sstables), info).discard_result();
 }
 
+future<compaction_manager::compaction_stats_opt> compaction_manager::perform_garbage_collection(compaction_group_view& t, tasks::task_info info) {
+    auto get_sstables = [this, &t] () -> future<std::vector<sstables::shared_sstable>> {
+        if (!t.tombstone_gc_enabled()) {
+            co_return std::vector<sstables::shared_sstable>{};
+        }
+        // Only sstables which contain nothing but expired data, which
+        // doesn't shadow data in any other sstable, can be dropped as a whole.
+        auto expired = t.fully_expired_sstables(co_await get_candidates(t), gc_clock::now());
+        co_return std::vector<sstables::shared_sstable>(expired.begin(), expired.end());
+    };
+    co_return co_await perform_task_on_all_files<garbage_collection_compaction_task_executor>("garbage collection", info, t, compaction_type_options::make_garbage_collection(), {},
+            std::move(get_sstables), throw_if_stopping::no);
+}
+
 future<compaction_manager::compaction_stats_opt> compaction_manager::perform_split_compaction(compaction_group_view& t, compaction_type_options::split opt, tasks::task_info info) {
     auto get_sstables = [this, &t] () -> future<std::vector<sstables::shared_sstable>> {
         return get_candidates(t);
@@ -2465,7 +2523,10 @@ future<> compaction_manager::unplug_system_keyspace() noexcept {
 }
 
 double compaction_backlog_tracker::backlog() const {
-    return disabled() ? compaction_controller::disable_backlog : _impl->backlog(_ongoing_writes, _ongoing_compactions);
+    if (disabled()) {
+        return compaction_controller::disable_backlog;
+    }
+    return _impl->backlog(_ongoing_writes, _ongoing_compactions);
 }
 
 void compaction_backlog_tracker::replace_sstables(const std::vector<sstables::shared_sstable>& old_ssts, const std::vector<sstables::shared_sstable>& new_ssts) {
@@ -2545,6 +2606,7 @@ compaction_backlog_tracker::compaction_backlog_tracker(compaction_backlog_tracke
         : _impl(std::move(other._impl))
         , _ongoing_writes(std::move(other._ongoing_writes))
         , _ongoing_compactions(std::move(other._ongoing_compactions))
+        , _cost_model(std::move(other._cost_model))
 {
     if (other._manager) {
         on_internal_error(cmlog, "compaction_backlog_tracker is moved while registered");
@@ -2564,15 +2626,31 @@ void compaction_backlog_manager::remove_backlog_tracker(compaction_backlog_track
 double compaction_backlog_manager::backlog() const {
     try {
         double backlog = 0;
+        double scaled_backlog = 0;
+        // Cost models are shared by the compaction groups of a table.
+        std::unordered_set<const compaction_cost_model*> cost_models;
+        double cost_factor_sum = 0;
+        bool scale_by_cost = _scale_by_cost();
 
         for (auto& tracker: _backlog_trackers) {
-            backlog += tracker->backlog();
+            auto tracker_backlog = tracker->backlog();
+            backlog += tracker_backlog;
+            if (scale_by_cost) {
+                auto* cost_model = tracker->cost_model();
+                auto cost_factor = cost_model ? cost_model->cost_factor() : 1.0;
+                scaled_backlog += tracker_backlog * cost_factor;
+                if (cost_model && cost_models.insert(cost_model).second) {
+                    cost_factor_sum += cost_factor;
+                }
+            }
         }
         if (compaction_controller::backlog_disabled(backlog)) {
             return compaction_controller::disable_backlog;
-        } else {
-            return backlog;
         }
+        if (scale_by_cost && cost_factor_sum > 0) {
+            backlog = scaled_backlog * cost_models.size() / cost_factor_sum;
+        }
+        return backlog;
     } catch (...) {
         return _compaction_controller->backlog_of_shares(1000);
     }
@@ -2593,4 +2671,17 @@ compaction_backlog_tracker& compaction_manager::get_backlog_tracker(compaction_g
     return t.get_backlog_tracker();
 }
 
+lw_shared_ptr<compaction_cost_model> compaction_manager::get_cost_model(table_id id) {
+    auto& cost_model = _cost_models[id];
+    if (!cost_model) {
+        cost_model = make_lw_shared<compaction_cost_model>();
+    }
+    return cost_model;
+}
+
+lw_shared_ptr<compaction_cost_model> compaction_manager::find_cost_model(table_id id) const noexcept {
+    auto it = _cost_models.find(id);
+    return it != _cost_models.end() ? it->second : nullptr;
+}
+
 }
@@ -56,6 +56,7 @@ class regular_compaction_task_executor;
 class offstrategy_compaction_task_executor;
 class rewrite_sstables_compaction_task_executor;
 class split_compaction_task_executor;
+class garbage_collection_compaction_task_executor;
 class cleanup_sstables_compaction_task_executor;
 class validate_sstables_compaction_task_executor;
 
@@ -73,6 +74,9 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         int64_t completed_tasks = 0;
         uint64_t active_tasks = 0; // Number of compaction going on.
         int64_t errors = 0;
+        uint64_t tombstone_purge_compactions = 0;
+        // Bytes by which tombstone purge compactions shrank their input.
+        uint64_t tombstone_purge_bytes_reclaimed = 0;
     };
     using scheduling_group = backlog_controller::scheduling_group;
     struct config {
@@ -82,6 +86,8 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
         std::chrono::seconds flush_all_tables_before_major = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::days(1));
+        utils::updateable_value<uint32_t> major_token_range_parallelism = utils::updateable_value<uint32_t>(1);
+        utils::updateable_value<bool> scale_backlog_by_cost = utils::updateable_value<bool>(false);
     };
 
 public:
@@ -160,6 +166,8 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     serialized_action _update_compaction_static_shares_action;
     utils::observer<float> _compaction_static_shares_observer;
     uint64_t _validation_errors = 0;
+    // Compaction cost model of each table, see get_cost_model().
+    std::unordered_map<table_id, lw_shared_ptr<compaction_cost_model>> _cost_models;
 
     class strategy_control;
     std::unique_ptr<strategy_control> _strategy_control;
@@ -299,6 +307,10 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         return _cfg.flush_all_tables_before_major;
     }
 
+    uint32_t major_token_range_parallelism() const noexcept {
+        return _cfg.major_token_range_parallelism.get();
+    }
+
     void register_metrics();
 
     // enable the compaction manager.
@@ -355,6 +367,12 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     // Submit a table to be upgraded and wait for its termination.
     future<> perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, compaction::compaction_group_view& t, bool exclude_current_version, tasks::task_info info);
 
+    // Submit a table to have its fully expired sstables dropped and wait for
+    // its termination. Unlike other compactions, live data is never rewritten:
+    // sstables which contain any live data, or tombstones which may shadow
+    // data in other sstables, are left untouched.
+    future<compaction_stats_opt> perform_garbage_collection(compaction::compaction_group_view& t, tasks::task_info info);
+
     // Submit a table to be scrubbed and wait for its termination.
     future<compaction_stats_opt> perform_sstable_scrub(compaction::compaction_group_view& t, compaction_type_options::scrub opts, tasks::task_info info);
 
@@ -439,10 +457,24 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         return _backlog_manager.backlog();
     }
 
-    void register_backlog_tracker(compaction_backlog_tracker& backlog_tracker) {
+    // Registers the backlog tracker of a compaction group of the given table.
+    // The backlog of the tracker may be scaled by the cost model of the table,
+    // see compaction_backlog_manager.
+    void register_backlog_tracker(compaction_backlog_tracker& backlog_tracker, table_id id) {
+        backlog_tracker.set_cost_model(get_cost_model(id));
         _backlog_manager.register_backlog_tracker(backlog_tracker);
     }
 
+    // Returns the compaction cost model shared by the compaction groups of the given table.
+    lw_shared_ptr<compaction_cost_model> get_cost_model(table_id id);
+    // Like get_cost_model(), but returns nullptr instead of creating a model
+    // for tables which have none, e.g. because they were dropped.
+    lw_shared_ptr<compaction_cost_model> find_cost_model(table_id id) const noexcept;
+    // Called when the table is dropped.
+    void forget_cost_model(table_id id) noexcept {
+        _cost_models.erase(id);
+    }
+
     compaction_backlog_tracker& get_backlog_tracker(compaction::compaction_group_view& t);
 
     static compaction_data create_compaction_data();
@@ -478,6 +510,7 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     friend class compaction::sstables_task_executor;
     friend class compaction::major_compaction_task_executor;
     friend class compaction::split_compaction_task_executor;
+    friend class compaction::garbage_collection_compaction_task_executor;
     friend class compaction::custom_compaction_task_executor;
     friend class compaction::regular_compaction_task_executor;
     friend class compaction::offstrategy_compaction_task_executor;
@@ -76,6 +76,116 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const sstables::shared_
     return droppable_ratio >= _tombstone_threshold;
 }
 
+static uint64_t count_tombstones(const sstables::token_range_tombstone_histogram& h) {
+    uint64_t tombstones = 0;
+    for (auto& b : h.histogram.elements) {
+        tombstones += b.count;
+    }
+    return tombstones;
+}
+
+// Returns the number of entries of the sstable.
+// Dead and expiring cells are counted both as cells and as tombstones,
+// but partition, row and range tombstones are only counted as tombstones.
+// So the larger of the two is used as the number of entries of a range.
+//
+// For sstables written without tombstone histograms, only the cells are counted.
+static double estimate_entries(const sstables::shared_sstable& sst) {
+    if (auto* histograms = sst->get_tombstone_histograms()) {
+        uint64_t entries = 0;
+        for (auto& h : histograms->elements) {
+            entries += std::max(h.cells_count, count_tombstones(h));
+        }
+        return entries;
+    }
+    auto& cells = sst->get_stats_metadata().estimated_cells_count;
+    return double(cells.mean()) * cells.count();
+}
+
+compaction_descriptor compaction_strategy_impl::get_tombstone_purge_job(const std::vector<sstables::shared_sstable>& candidates,
+        gc_clock::time_point compaction_time, const compaction_group_view& t, size_t max_sstables) {
+    if (_disable_tombstone_compaction) {
+        return compaction_descriptor();
+    }
+    struct token_range_stats {
+        double droppable = 0;
+        int64_t first_token = std::numeric_limits<int64_t>::max();
+        int64_t last_token = std::numeric_limits<int64_t>::min();
+    };
+    std::array<token_range_stats, sstables::tombstone_histogram_token_ranges> ranges;
+    // Droppable tombstones of each candidate, in all its token ranges.
+    std::vector<double> droppable_per_sstable(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        auto& sst = candidates[i];
+        // Like worth_dropping_tombstones(), ignore recently created sstables,
+        // so that a purge which couldn't drop the tombstones isn't retried
+        // in a loop on its own output.
+        if (db_clock::now() - _tombstone_compaction_interval < sst->data_file_write_time()) {
+            continue;
+        }
+        auto* histograms = sst->get_tombstone_histograms();
+        if (!histograms) {
+            continue;
+        }
+        auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time, t.get_tombstone_gc_state(), t.schema());
+        for (auto& h : histograms->elements) {
+            if (h.token_range >= ranges.size()) {
+                continue;
+            }
+            std::map<double, uint64_t> bins;
+            for (auto& b : h.histogram.elements) {
+                bins.emplace(b.deletion_time, b.count);
+            }
+            auto droppable = utils::streaming_histogram(bins.size(), std::move(bins)).sum(gc_before.time_since_epoch().count());
+            if (droppable > 0) {
+                auto& r = ranges[h.token_range];
+                r.droppable += droppable;
+                r.first_token = std::min(r.first_token, h.first_token);
+                r.last_token = std::max(r.last_token, h.last_token);
+                droppable_per_sstable[i] += droppable;
+            }
+        }
+    }
+
+    // The token range picks the candidates to compact together, but they are
+    // rewritten whole. So the droppable tombstones of all their token ranges
+    // are weighed against all their entries, including the entries of the
+    // candidates whose tombstones aren't considered, so that tombstones dense
+    // in one range don't trigger the rewrite of an sstable which is live
+    // everywhere else.
+    double best_ratio = 0;
+    std::vector<sstables::shared_sstable> best;
+    for (auto& r : ranges) {
+        if (r.droppable <= 0) {
+            continue;
+        }
+        auto first = dht::token::from_int64(r.first_token);
+        auto last = dht::token::from_int64(r.last_token);
+        std::vector<sstables::shared_sstable> overlapping;
+        double droppable = 0;
+        double entries = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            auto& sst = candidates[i];
+            if (sst->get_first_decorated_key().token() <= last && sst->get_last_decorated_key().token() >= first) {
+                overlapping.push_back(sst);
+                droppable += droppable_per_sstable[i];
+                entries += estimate_entries(sst);
+            }
+        }
+        auto ratio = droppable / std::max(entries, droppable);
+        if (ratio > best_ratio) {
+            best_ratio = ratio;
+            best = std::move(overlapping);
+        }
+    }
+    if (best.empty() || best_ratio < _tombstone_threshold || best.size() > max_sstables) {
+        return compaction_descriptor();
+    }
+    auto desc = compaction_descriptor(std::move(best));
+    desc.tombstone_purge = true;
+    return desc;
+}
+
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const {
     return partition_estimate;
 }
@@ -647,7 +757,6 @@ time_window_compaction_strategy::time_window_compaction_strategy(const std::map<
     } else {
         clogger.debug("Enabling tombstone compactions for TWCS");
     }
-    _use_clustering_key_filter = true;
 }
 
 // options is a map of compaction strategy options and their values.
@@ -718,10 +827,6 @@ future<int64_t> compaction_strategy::estimated_pending_compactions(compaction_gr
     return _compaction_strategy_impl->estimated_pending_compactions(table_s);
 }
 
-bool compaction_strategy::use_clustering_key_filter() const {
-    return _compaction_strategy_impl->use_clustering_key_filter();
-}
-
 compaction_backlog_tracker compaction_strategy::make_backlog_tracker() const {
     return compaction_backlog_tracker(_compaction_strategy_impl->make_backlog_tracker());
 }
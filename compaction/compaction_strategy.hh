@@ -55,9 +55,6 @@ class compaction_strategy {
     // Return if parallel compaction is allowed by strategy.
     bool parallel_compaction() const;
 
-    // Return if optimization to rule out sstables based on clustering key filter should be applied.
-    bool use_clustering_key_filter() const;
-
     // An estimation of number of compaction for strategy to be satisfied.
     future<int64_t> estimated_pending_compactions(compaction_group_view& table_s) const;
 
@@ -29,7 +29,6 @@ class compaction_strategy_impl {
     static constexpr auto TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
     static constexpr auto UNCHECKED_TOMBSTONE_COMPACTION_OPTION = "unchecked_tombstone_compaction";
 protected:
-    bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
@@ -60,13 +59,19 @@ class compaction_strategy_impl {
     virtual future<int64_t> estimated_pending_compactions(compaction_group_view& table_s) const = 0;
     virtual std::unique_ptr<sstables::sstable_set_impl> make_sstable_set(const compaction_group_view& ts) const;
 
-    bool use_clustering_key_filter() const {
-        return _use_clustering_key_filter;
-    }
-
     // Check if a given sstable is entitled for tombstone compaction based on its
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const sstables::shared_sstable& sst, gc_clock::time_point compaction_time, const compaction_group_view& t);
+    // Returns a job which compacts together all the candidates overlapping the
+    // tombstones of a token range, picking the range whose candidates have the
+    // highest ratio of droppable tombstones to entries, counted over the whole
+    // sstables according to their tombstone histograms, if the ratio reaches
+    // the tombstone threshold. Unlike a single sstable tombstone compaction, it can
+    // purge tombstones which shadow data in other sstables. Returns an empty
+    // descriptor if there is no such range, or if more than max_sstables
+    // candidates overlap it.
+    compaction_descriptor get_tombstone_purge_job(const std::vector<sstables::shared_sstable>& candidates,
+            gc_clock::time_point compaction_time, const compaction_group_view& t, size_t max_sstables);
 
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const = 0;
 
@@ -234,6 +234,12 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(compaction_group_vi
         co_return compaction_descriptor();
     }
 
+    // Compact together the sstables overlapping a token range dense in droppable tombstones,
+    // so that tombstones which shadow data in other sstables can be purged too.
+    if (auto desc = get_tombstone_purge_job(candidates, compaction_time, table_s, max_threshold); !desc.sstables.empty()) {
+        co_return desc;
+    }
+
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
     // ratio is greater than threshold.
     // prefer oldest sstables from biggest size tiers because they will be easier to satisfy conditions for
@@ -699,6 +699,54 @@ future<std::optional<double>> table_upgrade_sstables_compaction_task_impl::expec
     co_return _expected_workload = _expected_workload ? _expected_workload : co_await get_table_task_workload(_db, _ti);
 }
 
+tasks::is_user_task garbage_collection_compaction_task_impl::is_user_task() const noexcept {
+    return tasks::is_user_task::yes;
+}
+
+future<> garbage_collection_compaction_task_impl::run() {
+    co_await _db.invoke_on_all([&] (replica::database& db) -> future<> {
+        tasks::task_info parent_info{_status.id, _status.shard};
+        auto& compaction_module = db.get_compaction_manager().get_task_manager_module();
+        auto task = co_await compaction_module.make_and_start_task<shard_garbage_collection_compaction_task_impl>(parent_info, _status.keyspace, _status.id, db, _table_infos);
+        co_await task->done();
+    });
+}
+
+future<std::optional<double>> garbage_collection_compaction_task_impl::expected_total_workload() const {
+    co_return _expected_workload = _expected_workload ? _expected_workload : co_await get_keyspace_task_workload(_db, _table_infos);
+}
+
+future<> shard_garbage_collection_compaction_task_impl::run() {
+    seastar::condition_variable cv;
+    current_task_type current_task;
+    tasks::task_info parent_info{_status.id, _status.shard};
+    std::vector<table_tasks_info> table_tasks;
+    for (auto& ti : _table_infos) {
+        table_tasks.emplace_back(co_await _module->make_and_start_task<table_garbage_collection_compaction_task_impl>(parent_info, _status.keyspace, ti.name, _status.id, _db, ti, cv, current_task), ti);
+    }
+
+    co_await run_table_tasks(_db, std::move(table_tasks), cv, current_task, false);
+}
+
+future<std::optional<double>> shard_garbage_collection_compaction_task_impl::expected_total_workload() const {
+    co_return _expected_workload = _expected_workload ? _expected_workload : co_await get_shard_task_workload(_db, _table_infos);
+}
+
+future<> table_garbage_collection_compaction_task_impl::run() {
+    co_await wait_for_your_turn(_cv, _current_task, _status.id);
+    tasks::task_info info{_status.id, _status.shard};
+    co_await run_on_table("garbage_collection", _db, _status.keyspace, _ti, [&] (replica::table& t) -> future<> {
+        return t.parallel_foreach_compaction_group_view([&] (compaction::compaction_group_view& ts) -> future<> {
+            auto lock_holder = co_await t.get_compaction_manager().get_incremental_repair_read_lock(ts, "garbage_collection_compaction");
+            co_await t.get_compaction_manager().perform_garbage_collection(ts, info);
+        });
+    });
+}
+
+future<std::optional<double>> table_garbage_collection_compaction_task_impl::expected_total_workload() const {
+    co_return _expected_workload = _expected_workload ? _expected_workload : co_await get_table_task_workload(_db, _ti);
+}
+
 tasks::is_user_task scrub_sstables_compaction_task_impl::is_user_task() const noexcept {
     return tasks::is_user_task::yes;
 }
@@ -500,6 +500,83 @@ class table_upgrade_sstables_compaction_task_impl : public sstables_compaction_t
     virtual future<std::optional<double>> expected_total_workload() const override;
 };
 
+class garbage_collection_compaction_task_impl : public sstables_compaction_task_impl {
+private:
+    sharded<replica::database>& _db;
+    std::vector<table_info> _table_infos;
+public:
+    garbage_collection_compaction_task_impl(tasks::task_manager::module_ptr module,
+            std::string keyspace,
+            sharded<replica::database>& db,
+            std::vector<table_info> table_infos) noexcept
+        : sstables_compaction_task_impl(module, tasks::task_id::create_random_id(), module->new_sequence_number(), "keyspace", std::move(keyspace), "", "", tasks::task_id::create_null_id())
+        , _db(db)
+        , _table_infos(std::move(table_infos))
+    {}
+
+    virtual std::string type() const override {
+        return "garbage collection " + sstables_compaction_task_impl::type();
+    }
+
+    tasks::is_user_task is_user_task() const noexcept override;
+protected:
+    virtual future<> run() override;
+    virtual future<std::optional<double>> expected_total_workload() const override;
+};
+
+class shard_garbage_collection_compaction_task_impl : public sstables_compaction_task_impl {
+private:
+    replica::database& _db;
+    std::vector<table_info> _table_infos;
+public:
+    shard_garbage_collection_compaction_task_impl(tasks::task_manager::module_ptr module,
+            std::string keyspace,
+            tasks::task_id parent_id,
+            replica::database& db,
+            std::vector<table_info> table_infos) noexcept
+        : sstables_compaction_task_impl(module, tasks::task_id::create_random_id(), 0, "shard", std::move(keyspace), "", "", parent_id)
+        , _db(db)
+        , _table_infos(std::move(table_infos))
+    {}
+
+    virtual std::string type() const override {
+        return "garbage collection " + sstables_compaction_task_impl::type();
+    }
+protected:
+    virtual future<> run() override;
+    virtual future<std::optional<double>> expected_total_workload() const override;
+};
+
+class table_garbage_collection_compaction_task_impl : public sstables_compaction_task_impl {
+private:
+    replica::database& _db;
+    table_info _ti;
+    seastar::condition_variable& _cv;
+    current_task_type& _current_task;
+public:
+    table_garbage_collection_compaction_task_impl(tasks::task_manager::module_ptr module,
+            std::string keyspace,
+            std::string table,
+            tasks::task_id parent_id,
+            replica::database& db,
+            table_info ti,
+            seastar::condition_variable& cv,
+            current_task_type& current_task) noexcept
+        : sstables_compaction_task_impl(module, tasks::task_id::create_random_id(), 0, "table", std::move(keyspace), std::move(table), "", parent_id)
+        , _db(db)
+        , _ti(std::move(ti))
+        , _cv(cv)
+        , _current_task(current_task)
+    {}
+
+    virtual std::string type() const override {
+        return "garbage collection " + sstables_compaction_task_impl::type();
+    }
+protected:
+    virtual future<> run() override;
+    virtual future<std::optional<double>> expected_total_workload() const override;
+};
+
 class scrub_sstables_compaction_task_impl : public sstables_compaction_task_impl {
 private:
     sharded<replica::database>& _db;
@@ -449,6 +449,7 @@ scylla_tests = set([
     'test/boost/allocation_strategy_test',
     'test/boost/alternator_unit_test',
     'test/boost/anchorless_list_test',
+    'test/boost/array_search_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
     'test/boost/big_decimal_test',
@@ -598,6 +599,7 @@ scylla_tests = set([
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
     'test/perf/perf_commitlog',
+    'test/perf/perf_compaction_index_preheat',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
@@ -622,6 +624,7 @@ perf_tests = set([
     'test/perf/perf_big_decimal',
     'test/perf/perf_bti_key_translation',
     'test/perf/perf_sort_by_proximity',
+    'test/perf/perf_sstable_set',
 ])
 
 perf_standalone_tests = set([
@@ -888,6 +891,8 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/random_access_reader.cc',
                 'sstables/metadata_collector.cc',
                 'sstables/writer.cc',
+                'sstables/row_hash_index.cc',
+                'sstables/data_readahead.cc',
                 'sstables/trie/bti_key_translation.cc',
                 'sstables/trie/bti_index_reader.cc',
                 'sstables/trie/bti_node_reader.cc',
@@ -1042,6 +1047,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/per_partition_rate_limit_options.cc',
                 'db/rate_limiter.cc',
                 'db/row_cache.cc',
+                'db/cache_cold_tier.cc',
                 'db/schema_applier.cc',
                 'db/schema_tables.cc',
                 'db/size_estimates_virtual_reader.cc',
@@ -1068,6 +1074,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/UUID_gen.cc',
                 'utils/i_filter.cc',
                 'utils/bloom_filter.cc',
+                'utils/xor_filter.cc',
                 'utils/bloom_calculations.cc',
                 'utils/rate_limiter.cc',
                 'utils/file_lock.cc',
@@ -1448,6 +1455,7 @@ deps = {
 
 pure_boost_tests = set([
     'test/boost/anchorless_list_test',
+    'test/boost/array_search_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
     'test/boost/big_decimal_test',
@@ -1489,6 +1497,7 @@ tests_not_using_seastar_test_framework = set([
     'test/manual/message',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_compaction_index_preheat',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
@@ -1628,6 +1637,7 @@ deps['test/boost/reusable_buffer_test'] = [
     "test/lib/log.cc",
 ]
 deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'test/boost/utf8_test.cc']
+deps['test/boost/array_search_test'] = ['utils/array-search.cc', 'test/boost/array_search_test.cc']
 deps['test/boost/small_vector_test'] = ['test/boost/small_vector_test.cc']
 deps['test/boost/vint_serialization_test'] = ['test/boost/vint_serialization_test.cc', 'vint-serialization.cc', 'bytes.cc']
 deps['test/boost/linearizing_input_stream_test'] = [
@@ -15,6 +15,12 @@
 namespace cql3 {
 class untyped_result_set;
 
+// Visits the rows of a query::result as the selection sees them.
+//
+// Cell values are passed to the visitor as views into the result, which
+// live as long as the generator. Values of key columns are exploded from the
+// keys into temporaries, and are passed as bytes_view, valid only during the
+// call to accept_value().
 class result_generator {
     schema_ptr _schema;
     foreign_ptr<lw_shared_ptr<query::result>> _result;
@@ -22,6 +22,7 @@
 #include "tombstone_gc.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "db/sstable_filter_extension.hh"
 #include "db/tablet_options.hh"
 #include "utils/bloom_calculations.hh"
 #include "utils/overloaded_functor.hh"
@@ -156,6 +157,16 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
 
+    auto sstable_filter = get_sstable_filter(schema_extensions);
+    if (sstable_filter && *sstable_filter == db::sstable_filter_type::xor_filter && !db.features().xor_sstable_filter) {
+        throw exceptions::configuration_exception("XOR sstable filters are not supported yet by the whole cluster");
+    }
+
+    auto caching_options = get_caching_options();
+    if (caching_options && caching_options->pin_index() && !db.features().pin_index_caching_option) {
+        throw exceptions::configuration_exception("The pin_index caching option is not supported yet by the whole cluster");
+    }
+
     validate_minimum_int(KW_DEFAULT_TIME_TO_LIVE, 0, DEFAULT_DEFAULT_TIME_TO_LIVE);
     validate_minimum_int(KW_PAXOSGRACESECONDS, 0, DEFAULT_GC_GRACE_SECONDS);
 
@@ -286,6 +297,16 @@ const db::per_partition_rate_limit_options* cf_prop_defs::get_per_partition_rate
     return &ext->get_options();
 }
 
+std::optional<db::sstable_filter_type> cf_prop_defs::get_sstable_filter(const schema::extensions_map& schema_exts) const {
+    auto it = schema_exts.find(db::sstable_filter_extension::NAME);
+    if (it == schema_exts.end()) {
+        return std::nullopt;
+    }
+
+    auto ext = dynamic_pointer_cast<db::sstable_filter_extension>(it->second);
+    return ext->get_type();
+}
+
 std::optional<db::tablet_options::map_type> cf_prop_defs::get_tablet_options() const {
     if (auto tablet_options = get_map(KW_TABLETS)) {
         return tablet_options.value();
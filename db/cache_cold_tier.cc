@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+#include <lz4.h>
+
+#include <seastar/core/memory.hh>
+#include <seastar/core/on_internal_error.hh>
+
+#include "db/cache_cold_tier.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
+#include "mutation/mutation_partition_v2.hh"
+#include "utils/log.hh"
+
+namespace cache {
+
+extern logging::logger clogger;
+
+cold_tier::cold_tier(utils::updateable_value<double> memory_fraction)
+    : _memory_fraction(std::move(memory_fraction))
+{ }
+
+cold_tier::~cold_tier() {
+    clear();
+}
+
+cold_tier::invalidation_fence::invalidation_fence(cold_tier& ct, table_id table, const dht::partition_range_vector& ranges) noexcept
+    : _table(table)
+    , _ranges(ranges)
+{
+    ct._fences.push_back(*this);
+}
+
+bool cold_tier::fenced(const schema& s, const dht::decorated_key& key) const noexcept {
+    for (const invalidation_fence& f : _fences) {
+        if (f._table != s.id()) {
+            continue;
+        }
+        for (const dht::partition_range& range : f._ranges) {
+            if (dht::ring_position_tri_compare(s, dht::ring_position_view::for_range_start(range), key) <= 0
+                    && dht::ring_position_tri_compare(s, key, dht::ring_position_view::for_range_end(range)) < 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void cold_tier::clear() noexcept {
+    with_allocator(standard_allocator(), [&] {
+        _lru.clear();
+        _tables.clear();
+    });
+    _stats.partitions = 0;
+    _stats.bytes = 0;
+    _stats.uncompressed_bytes = 0;
+}
+
+size_t cold_tier::memory_limit() const noexcept {
+    return seastar::memory::stats().total_memory() * std::clamp(_memory_fraction.get(), 0.0, 1.0);
+}
+
+size_t cold_tier::entry_memory(const entry& e) const noexcept {
+    return e.blob.size() + e.key->key().external_memory_usage() + sizeof(entries_type::value_type);
+}
+
+void cold_tier::erase(entries_type& entries, entries_type::iterator it) noexcept {
+    _stats.bytes -= entry_memory(it->second);
+    _stats.uncompressed_bytes -= it->second.uncompressed_size;
+    --_stats.partitions;
+    _lru.erase(_lru.iterator_to(it->second));
+    entries.erase(it);
+}
+
+void cold_tier::evict_to_limit(size_t extra) noexcept {
+    auto limit = memory_limit();
+    while (!_lru.empty() && _stats.bytes + extra > limit) {
+        entry& e = _lru.front();
+        auto& entries = _tables.at(e.schema->id());
+        ++_stats.evictions;
+        erase(entries, entries.find(*e.key));
+    }
+}
+
+bool cold_tier::insert(const schema_ptr& s, const dht::decorated_key& key, const mutation_partition_v2& p) noexcept {
+    if (fenced(*s, key)) {
+        return false;
+    }
+    // Called when cache is being evicted from, memory is likely short. Don't make it worse.
+    if (seastar::memory::stats().free_memory() < 2 * seastar::memory::min_free_memory()) {
+        ++_stats.failed_insertions;
+        return false;
+    }
+    try {
+        return with_allocator(standard_allocator(), [&] {
+            auto fm = freeze(mutation(s, key, p.as_mutation_partition(*s)));
+            auto raw = fm.representation().linearize();
+            bytes blob(bytes::initialized_later(), LZ4_compressBound(raw.size()));
+            auto len = LZ4_compress_default(reinterpret_cast<const char*>(raw.data()), reinterpret_cast<char*>(blob.data()),
+                    raw.size(), blob.size());
+            if (len <= 0) {
+                ++_stats.failed_insertions;
+                return false;
+            }
+            blob.resize(len);
+
+            auto& entries = _tables.try_emplace(s->id(), key_less{s}).first->second;
+            if (auto old = entries.find(key); old != entries.end()) {
+                erase(entries, old);
+            }
+            evict_to_limit(blob.size() + key.key().external_memory_usage() + sizeof(entries_type::value_type));
+            auto it = entries.emplace(key, entry{s, nullptr, std::move(blob), uint32_t(raw.size()), {}}).first;
+            it->second.key = &it->first;
+            _lru.push_back(it->second);
+            ++_stats.insertions;
+            ++_stats.partitions;
+            _stats.bytes += entry_memory(it->second);
+            _stats.uncompressed_bytes += it->second.uncompressed_size;
+            return true;
+        });
+    } catch (...) {
+        clogger.trace("Failed to demote partition {} to the cold tier: {}", key, std::current_exception());
+        ++_stats.failed_insertions;
+        return false;
+    }
+}
+
+std::optional<mutation> cold_tier::take(const schema_ptr& s, const dht::decorated_key& key) {
+    auto t = _tables.find(s->id());
+    if (t == _tables.end()) {
+        return std::nullopt;
+    }
+    return with_allocator(standard_allocator(), [&] () -> std::optional<mutation> {
+        auto& entries = t->second;
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return std::nullopt;
+        }
+        auto& e = it->second;
+        bytes raw(bytes::initialized_later(), e.uncompressed_size);
+        auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(e.blob.data()), reinterpret_cast<char*>(raw.data()),
+                e.blob.size(), raw.size());
+        if (ret != int(raw.size())) {
+            erase(entries, it);
+            on_internal_error(clogger, format("Failed to decompress partition {} from the cold tier: {}", key, ret));
+        }
+        bytes_ostream b;
+        b.write(raw);
+        auto m = frozen_mutation(std::move(b)).unfreeze(e.schema);
+        erase(entries, it);
+        ++_stats.hits;
+        if (m.schema() != s) {
+            m.upgrade(s);
+        }
+        return m;
+    });
+}
+
+void cold_tier::erase(table_id table, const dht::decorated_key& key) noexcept {
+    auto t = _tables.find(table);
+    if (t == _tables.end()) {
+        return;
+    }
+    with_allocator(standard_allocator(), [&] {
+        auto it = t->second.find(key);
+        if (it != t->second.end()) {
+            ++_stats.invalidations;
+            erase(t->second, it);
+        }
+    });
+}
+
+void cold_tier::invalidate(table_id table) noexcept {
+    auto t = _tables.find(table);
+    if (t == _tables.end()) {
+        return;
+    }
+    with_allocator(standard_allocator(), [&] {
+        auto& entries = t->second;
+        while (!entries.empty()) {
+            ++_stats.invalidations;
+            erase(entries, entries.begin());
+        }
+        _tables.erase(t);
+    });
+}
+
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+#include <boost/intrusive/list.hpp>
+
+#include "bytes.hh"
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/ring_position.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/allocation_strategy.hh"
+#include "utils/updateable_value.hh"
+
+class mutation;
+class mutation_partition_v2;
+
+namespace cache {
+
+// Second tier of the row cache, holding lz4-compressed copies of small
+// partitions which were evicted from the row cache.
+//
+// When cache is being evicted from, the partitions at the tail of the LRU
+// are demoted to this tier shortly after (see cache_tracker::demote_some()),
+// provided the cached partition is complete, so that it can be put back into
+// the row cache as a whole on the next single-partition read, without going
+// to sstables.
+//
+// Entries are kept in standard memory, which is limited to a fraction of
+// shard memory. The least recently demoted entries are dropped to stay within
+// the limit.
+//
+// Entries don't take part in the population phases of row_cache, so the
+// owner must erase them whenever the underlying data of the partition
+// changes (see erase() and invalidate()), and keep the partitions of ranges
+// it is invalidating from being inserted meanwhile (see invalidation_fence).
+class cold_tier {
+public:
+    // While alive, insert() refuses partitions of the table which fall
+    // into one of the ranges. The ranges must outlive the fence.
+    class invalidation_fence {
+        friend class cold_tier;
+        boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> _link;
+        table_id _table;
+        const dht::partition_range_vector& _ranges;
+    public:
+        invalidation_fence(cold_tier&, table_id, const dht::partition_range_vector&) noexcept;
+        invalidation_fence(const invalidation_fence&) = delete;
+        invalidation_fence& operator=(const invalidation_fence&) = delete;
+    };
+    struct stats {
+        uint64_t insertions = 0;
+        uint64_t hits = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+        uint64_t failed_insertions = 0;
+        uint64_t partitions = 0;
+        uint64_t bytes = 0;
+        uint64_t uncompressed_bytes = 0;
+    };
+private:
+    struct key_less {
+        schema_ptr s;
+        using is_transparent = void;
+        bool operator()(dht::ring_position_view a, dht::ring_position_view b) const {
+            return dht::ring_position_tri_compare(*s, a, b) < 0;
+        }
+    };
+    struct entry {
+        // The schema with which the partition was frozen.
+        schema_ptr schema;
+        // Points to the key of the map node holding this entry.
+        const dht::decorated_key* key = nullptr;
+        bytes blob;
+        uint32_t uncompressed_size;
+        boost::intrusive::list_member_hook<> lru_link;
+    };
+    using entries_type = std::map<dht::decorated_key, entry, key_less>;
+    using lru_type = boost::intrusive::list<entry,
+        boost::intrusive::member_hook<entry, boost::intrusive::list_member_hook<>, &entry::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+
+    using fences_type = boost::intrusive::list<invalidation_fence,
+        boost::intrusive::member_hook<invalidation_fence, decltype(invalidation_fence::_link), &invalidation_fence::_link>,
+        boost::intrusive::constant_time_size<false>>;
+
+    utils::updateable_value<double> _memory_fraction;
+    std::unordered_map<table_id, entries_type> _tables;
+    lru_type _lru;
+    fences_type _fences;
+    stats _stats;
+private:
+    bool fenced(const schema&, const dht::decorated_key&) const noexcept;
+    size_t memory_limit() const noexcept;
+    size_t entry_memory(const entry&) const noexcept;
+    void erase(entries_type&, entries_type::iterator) noexcept;
+    void evict_to_limit(size_t extra) noexcept;
+public:
+    // Partitions larger than this are not demoted.
+    static constexpr size_t max_partition_rows = 128;
+
+    explicit cold_tier(utils::updateable_value<double> memory_fraction = utils::updateable_value<double>(0));
+    ~cold_tier();
+
+    bool enabled() const noexcept { return _memory_fraction.get() > 0; }
+
+    // Stores a compressed copy of the partition, replacing the previous one.
+    // Must be given a fully continuous partition. Returns false if the copy
+    // could not be made, e.g. due to lack of memory, or if the partition is
+    // being invalidated.
+    bool insert(const schema_ptr&, const dht::decorated_key&, const mutation_partition_v2&) noexcept;
+
+    // Removes the partition from the tier and returns it, upgraded to the given schema.
+    std::optional<mutation> take(const schema_ptr&, const dht::decorated_key&);
+
+    void erase(table_id, const dht::decorated_key&) noexcept;
+    // Erases the partitions of the table in the range for which filter returns true.
+    template <typename Filter>
+    void invalidate(table_id, const dht::partition_range& range, Filter&& filter) noexcept;
+    // Erases all partitions of the table.
+    void invalidate(table_id) noexcept;
+    void clear() noexcept;
+
+    void set_memory_fraction(utils::updateable_value<double> fraction) { _memory_fraction = std::move(fraction); }
+    const stats& get_stats() const noexcept { return _stats; }
+};
+
+template <typename Filter>
+void cold_tier::invalidate(table_id table, const dht::partition_range& range, Filter&& filter) noexcept {
+    auto t = _tables.find(table);
+    if (t == _tables.end()) {
+        return;
+    }
+    with_allocator(standard_allocator(), [&] {
+        auto& entries = t->second;
+        auto it = entries.lower_bound(dht::ring_position_view::for_range_start(range));
+        auto end = entries.lower_bound(dht::ring_position_view::for_range_end(range));
+        while (it != end) {
+            auto next = std::next(it);
+            if (filter(it->first)) {
+                ++_stats.invalidations;
+                erase(entries, it);
+            }
+            it = next;
+        }
+    });
+}
+
+}
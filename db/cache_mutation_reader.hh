@@ -123,6 +123,9 @@ class cache_mutation_reader final : public mutation_reader::impl {
     mutation_reader_opt _underlying_holder;
 
     gc_clock::time_point _read_time;
+    // False if rows populated by this read go on probation, either because of
+    // the admission filter or because the read is a scan.
+    bool _admitted;
     std::optional<gc_clock::time_point> _gc_before;
 
     std::optional<max_purgeable> _max_purgeable;
@@ -164,6 +167,18 @@ class cache_mutation_reader final : public mutation_reader::impl {
     void maybe_set_static_row_continuous();
     void set_rows_entry_continuous(rows_entry& e);
     void restore_continuity_after_insertion(const mutation_partition::rows_type::iterator&);
+    void insert_row(rows_entry& e) noexcept {
+        // Probation rows are evicted early, which would break the "older versions
+        // are evicted first" rule if there were older versions than ours.
+        if (_admitted || !_snp->at_latest_version() || !_snp->at_oldest_version()) {
+            _snp->tracker()->insert(e);
+        } else {
+            _snp->tracker()->insert_probation(e);
+            if (_read_context.is_scan()) {
+                ++_read_context.cache()._stats.scan_probation_insertions;
+            }
+        }
+    }
     void finish_reader() {
         push_mutation_fragment(*_schema, _permit, partition_end());
         _end_of_stream = true;
@@ -243,6 +258,9 @@ class cache_mutation_reader final : public mutation_reader::impl {
         , _read_context(ctx)    // ctx is owned by the caller, who's responsible for closing it.
         , _next_row(*_schema, *_snp, false, _read_context.is_reversed())
         , _read_time(get_read_time())
+        // Scans are not counted by the admission filter, they would make
+        // every partition they read look popular.
+        , _admitted(!_read_context.is_scan() && _snp->tracker()->on_partition_access(_dk.token()))
     {
         clogger.trace("csm {}: table={}.{}, dk={}, reversed={}, snap={}",
                 fmt::ptr(this),
@@ -481,7 +499,7 @@ future<> cache_mutation_reader::read_from_underlying() {
                                         cmp);
                                 if (insert_result.second) {
                                     auto it = insert_result.first;
-                                    _snp->tracker()->insert(*it);
+                                    insert_row(*it);
                                     auto next = std::next(it);
                                     // Also works in reverse read mode.
                                     // It preserves the continuity of the range the entry falls into.
@@ -501,7 +519,7 @@ future<> cache_mutation_reader::read_from_underlying() {
                                         cmp);
                                 if (insert_result.second) {
                                     clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, _upper_bound);
-                                    _snp->tracker()->insert(*insert_result.first);
+                                    insert_row(*insert_result.first);
                                     restore_continuity_after_insertion(insert_result.first);
                                 }
                                 if (_read_context.is_reversed()) [[unlikely]] {
@@ -589,7 +607,7 @@ void cache_mutation_reader::maybe_update_continuity() {
                         auto insert_result = rows.insert(std::move(e2), table_cmp);
                         if (insert_result.second) {
                             clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, insert_result.first->position());
-                            _snp->tracker()->insert(*insert_result.first);
+                            insert_row(*insert_result.first);
                         }
                         clogger.trace("csm {}: set_continuous({}), prev={}, rt={}", fmt::ptr(this), insert_result.first->position(),
                                       _last_row.position(), _current_tombstone);
@@ -617,7 +635,7 @@ void cache_mutation_reader::maybe_update_continuity() {
                         auto insert_result = rows.insert_before_hint(_next_row.get_iterator_in_latest_version(), std::move(e2), table_cmp);
                         if (insert_result.second) {
                             clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, insert_result.first->position());
-                            _snp->tracker()->insert(*insert_result.first);
+                            insert_row(*insert_result.first);
                             clogger.trace("csm {}: set_continuous({}), prev={}, rt={}", fmt::ptr(this), insert_result.first->position(),
                                           _last_row.position(), _current_tombstone);
                             set_rows_entry_continuous(*insert_result.first);
@@ -664,7 +682,7 @@ void cache_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
         auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
         it = insert_result.first;
         if (insert_result.second) {
-            _snp->tracker()->insert(*it);
+            insert_row(*it);
             restore_continuity_after_insertion(it);
         }
 
@@ -729,7 +747,7 @@ bool cache_mutation_reader::maybe_add_to_cache(const range_tombstone_change& rtc
         auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
         it = insert_result.first;
         if (insert_result.second) {
-            _snp->tracker()->insert(*it);
+            insert_row(*it);
             restore_continuity_after_insertion(it);
         }
 
@@ -935,7 +953,7 @@ void cache_mutation_reader::move_to_range(query::clustering_row_ranges::const_it
                 });
                 auto it = insert_result.first;
                 if (insert_result.second) {
-                    _snp->tracker()->insert(*it);
+                    insert_row(*it);
                 }
                 _last_row = partition_snapshot_row_weakref(*_snp, it, true);
             } else {
@@ -14,14 +14,22 @@
 #include "mutation/partition_version.hh"
 #include "mutation/mutation_cleaner.hh"
 #include "utils/cached_file_stats.hh"
+#include "utils/frequency_sketch.hh"
+#include "db/cache_cold_tier.hh"
 #include "sstables/partition_index_cache_stats.hh"
 
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
 
 #include <stdint.h>
 
 class cache_entry;
 
+namespace dht {
+class token;
+}
+
 namespace cache {
 
 class autoupdating_underlying_reader;
@@ -47,6 +55,7 @@ class cache_tracker final {
         uint64_t row_misses;
         uint64_t partition_insertions;
         uint64_t row_insertions;
+        uint64_t row_probation_insertions;
         uint64_t static_row_insertions;
         uint64_t concurrent_misses_same_key;
         uint64_t partition_merges;
@@ -89,8 +98,33 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    // Absolute limit on the memory used by index caches, in addition to
+    // _index_cache_fraction. 0 means no limit.
+    utils::updateable_value<uint32_t> _index_cache_size_in_mb{0};
+    // TinyLFU admission: rows of partitions which were not read recently
+    // enough go to the LRU on probation, see lru::add_probation().
+    utils::updateable_value<bool> _admission_filter{false};
+    std::unique_ptr<utils::frequency_sketch> _admission_sketch;
+    static constexpr size_t admission_sketch_keys = 256 * 1024;
+    // Partitions read at least this many times recently are admitted.
+    static constexpr unsigned admission_threshold = 2;
+    // Range reads which entered more partitions than this are treated as
+    // scans, which populate cache on probation. 0 disables the detection.
+    utils::updateable_value<uint32_t> _scan_detection_threshold{0};
+    cache::cold_tier _cold_tier;
+    // Demotion to the cold tier allocates, so it's not done by the reclaimer,
+    // which arms this timer instead. See demote_some().
+    seastar::timer<seastar::lowres_clock> _demotion_timer;
+    // Partitions demoted per tick of _demotion_timer, at most.
+    static constexpr size_t demotion_batch = 64;
+    // LRU entries looked at when searching for a partition to demote.
+    static constexpr size_t demotion_scan_limit = 256;
 private:
     void setup_metrics();
+    // If the partition of e can be compressed into the cold tier, does so
+    // and evicts the whole partition. Returns true iff e was evicted.
+    bool try_demote(rows_entry& e) noexcept;
+    utils::frequency_sketch* admission_sketch() noexcept;
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(utils::updateable_value<double> index_cache_fraction, mutation_application_stats&, register_metrics);
@@ -100,10 +134,15 @@ class cache_tracker final {
     void clear();
     void touch(rows_entry&);
     void insert(cache_entry&);
+    // Inserts the entry's rows on probation regardless of the admission filter.
+    void insert_probation(cache_entry&);
     void insert(partition_entry&) noexcept;
     void insert(partition_version&) noexcept;
     void insert(mutation_partition_v2&) noexcept;
     void insert(rows_entry&) noexcept;
+    // Like insert(rows_entry&), but the entry is evicted before those which
+    // are not on probation, unless touched first.
+    void insert_probation(rows_entry&) noexcept;
     void remove(rows_entry&) noexcept;
     // Inserts e such that it will be evicted right before more_recent in the absence of later touches.
     void insert(rows_entry& more_recent, rows_entry& e) noexcept;
@@ -112,6 +151,12 @@ class cache_tracker final {
     void on_partition_merge() noexcept;
     void on_partition_hit() noexcept;
     void on_partition_miss() noexcept;
+    // Counts a read of the partition for the admission filter. Returns false
+    // if rows populated by the read should be inserted on probation.
+    bool on_partition_access(const dht::token&) noexcept;
+    // Whether an entry created for the partition by a read, which was not
+    // counted by on_partition_access() yet, should be admitted.
+    bool admits(const dht::token&) noexcept;
     void on_partition_eviction() noexcept;
     void on_row_eviction() noexcept;
     void on_row_hit() noexcept;
@@ -136,6 +181,17 @@ class cache_tracker final {
     const stats& get_stats() const noexcept { return _stats; }
     stats& get_stats() noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+    void set_admission_filter(utils::updateable_value<bool> enabled) { _admission_filter = std::move(enabled); }
+    void set_scan_detection_threshold(utils::updateable_value<uint32_t> partitions) { _scan_detection_threshold = std::move(partitions); }
+    uint32_t scan_detection_threshold() const noexcept { return _scan_detection_threshold.get(); }
+    void set_cold_tier_fraction(utils::updateable_value<double> fraction) { _cold_tier.set_memory_fraction(std::move(fraction)); }
+    cache::cold_tier& cold_tier() noexcept { return _cold_tier; }
+    void set_index_cache_size_in_mb(utils::updateable_value<uint32_t> size) { _index_cache_size_in_mb = std::move(size); }
+    // Whether the sstable index caches use more memory than they are allowed to.
+    bool index_cache_over_limit() const noexcept;
+    // Moves up to max_partitions partitions from the cold end of the LRU
+    // into the cold tier. Returns the number of partitions demoted.
+    size_t demote_some(size_t max_partitions) noexcept;
     lru& get_lru() { return _lru; }
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
@@ -158,6 +214,14 @@ void cache_tracker::insert(rows_entry& entry) noexcept {
     _lru.add(entry);
 }
 
+inline
+void cache_tracker::insert_probation(rows_entry& entry) noexcept {
+    ++_stats.row_insertions;
+    ++_stats.row_probation_insertions;
+    ++_stats.rows;
+    _lru.add_probation(entry);
+}
+
 inline
 void cache_tracker::insert(rows_entry& more_recent, rows_entry& entry) noexcept {
     ++_stats.row_insertions;
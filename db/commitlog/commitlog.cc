@@ -53,6 +53,7 @@
 #include "utils/log.hh"
 #include "commitlog_entry.hh"
 #include "commitlog_extensions.hh"
+#include "message/shared_dict.hh"
 
 #include "utils/checked-file-impl.hh"
 #include "utils/disk-error-handler.hh"
@@ -88,6 +89,82 @@ class crc32_nbo {
     }
 };
 
+/*
+ * Compresses and decompresses single commitlog entries, optionally with
+ * a dictionary. Keeps the zstd contexts around between calls, so it is
+ * meant to be used by one shard.
+ */
+class entry_codec {
+    using compression_type = db::commitlog::compression_type;
+
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> _zstd_cctx{nullptr, ZSTD_freeCCtx};
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> _zstd_dctx{nullptr, ZSTD_freeDCtx};
+    std::unique_ptr<LZ4_stream_t, decltype(&LZ4_freeStream)> _lz4_stream{nullptr, LZ4_freeStream};
+
+    static constexpr int zstd_level = 1;
+public:
+    // Returns the compressed size, or 0 if the result would not fit in `out`.
+    size_t compress(compression_type c, const netw::shared_dict* dict, std::span<const char> in, std::span<char> out) {
+        switch (c) {
+        case compression_type::none:
+            break;
+        case compression_type::lz4: {
+            if (!dict) {
+                return std::max(LZ4_compress_default(in.data(), out.data(), in.size(), out.size()), 0);
+            }
+            if (!_lz4_stream) {
+                _lz4_stream.reset(LZ4_createStream());
+            }
+            LZ4_resetStream_fast(_lz4_stream.get());
+            LZ4_attach_dictionary(_lz4_stream.get(), dict->lz4_cdict.get());
+            return std::max(LZ4_compress_fast_continue(_lz4_stream.get(), in.data(), out.data(), in.size(), out.size(), 1), 0);
+        }
+        case compression_type::zstd: {
+            if (!_zstd_cctx) {
+                _zstd_cctx.reset(ZSTD_createCCtx());
+            }
+            auto ret = dict
+                    ? ZSTD_compress_usingCDict(_zstd_cctx.get(), out.data(), out.size(), in.data(), in.size(), dict->zstd_cdict.get())
+                    : ZSTD_compressCCtx(_zstd_cctx.get(), out.data(), out.size(), in.data(), in.size(), zstd_level);
+            return ZSTD_isError(ret) ? 0 : ret;
+        }
+        }
+        return 0;
+    }
+
+    // Throws if `in` does not decompress to exactly out.size() bytes.
+    void decompress(compression_type c, const netw::shared_dict* dict, std::span<const char> in, std::span<char> out) {
+        switch (c) {
+        case compression_type::none:
+            break;
+        case compression_type::lz4: {
+            auto ret = dict
+                    ? LZ4_decompress_safe_usingDict(in.data(), out.data(), in.size(), out.size(),
+                            reinterpret_cast<const char*>(dict->lz4_ddict.data()), dict->lz4_ddict.size())
+                    : LZ4_decompress_safe(in.data(), out.data(), in.size(), out.size());
+            if (ret < 0 || size_t(ret) != out.size()) {
+                throw std::runtime_error(fmt::format("LZ4 decompression of commitlog entry failed: {}", ret));
+            }
+            return;
+        }
+        case compression_type::zstd: {
+            if (!_zstd_dctx) {
+                _zstd_dctx.reset(ZSTD_createDCtx());
+            }
+            auto ret = dict
+                    ? ZSTD_decompress_usingDDict(_zstd_dctx.get(), out.data(), out.size(), in.data(), in.size(), dict->zstd_ddict.get())
+                    : ZSTD_decompressDCtx(_zstd_dctx.get(), out.data(), out.size(), in.data(), in.size());
+            if (ZSTD_isError(ret) || ret != out.size()) {
+                throw std::runtime_error(fmt::format("zstd decompression of commitlog entry failed: {}",
+                        ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch"));
+            }
+            return;
+        }
+        }
+        throw std::runtime_error(fmt::format("Unknown commitlog entry compression {}", int(c)));
+    }
+};
+
 class db::cf_holder {
 public:
     virtual ~cf_holder() {};
@@ -103,11 +180,21 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_total_space_in_mb = cfg.commitlog_total_space_in_mb() >= 0 ? cfg.commitlog_total_space_in_mb() : (shard_available_memory * smp::count) >> 20;
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
+    c.commitlog_group_commit_window_in_us = cfg.commitlog_group_commit_window_in_us();
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.preallocate_segments = cfg.commitlog_preallocate_segments();
     c.allow_going_over_size_limit = false;
 
+    if (cfg.commitlog_compression() == "lz4") {
+        c.compression = compression_type::lz4;
+    } else if (cfg.commitlog_compression() == "zstd") {
+        c.compression = compression_type::zstd;
+    } else if (cfg.commitlog_compression() != "none") {
+        throw std::invalid_argument(fmt::format("Invalid commitlog_compression '{}': must be one of none, lz4 or zstd", cfg.commitlog_compression()));
+    }
+
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
         c.commitlog_flush_threshold_in_mb = cfg.commitlog_flush_threshold_in_mb();
     }
@@ -389,6 +476,10 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        // sizes of the entries given to, and produced by, entry compression
+        uint64_t bytes_compression_input = 0;
+        uint64_t bytes_compression_output = 0;
+        uint64_t group_commit_waits = 0;
     };
 
     class scope_increment_counter {
@@ -405,6 +496,10 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     };
 
     stats totals;
+    // Dictionary used for compressing entries of new segments. Each segment
+    // which uses it stores a copy, so that it can be replayed on its own.
+    lw_shared_ptr<const netw::shared_dict> _compression_dict;
+    entry_codec _codec;
     byte_flow<uint64_t> last_bytes;
     byte_flow<double> bytes_rate;
 
@@ -440,6 +535,7 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     future<> init();
     future<sseg_ptr> new_segment();
     future<sseg_ptr> active_segment(db::timeout_clock::time_point timeout);
+    future<> wait_for_group_commit(db::timeout_clock::time_point timeout);
     future<sseg_ptr> allocate_segment();
     future<sseg_ptr> allocate_segment_ex(descriptor, named_file, open_flags);
 
@@ -766,6 +862,11 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     std::unordered_set<table_schema_version> _known_schema_versions;
 
+    // Fixed for the lifetime of the segment.
+    const compression_type _compression;
+    lw_shared_ptr<const netw::shared_dict> _compression_dict;
+    bool _compression_dict_written = false;
+
     friend sstring format_as(const segment& s) {
         return s._desc.filename();
     }
@@ -820,9 +921,39 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     static constexpr size_t segment_overhead_size = 2 * sizeof(uint32_t);
     static constexpr size_t descriptor_header_size = 6 * sizeof(uint32_t);
     static constexpr uint32_t segment_magic = ('S'<<24) |('C'<< 16) | ('L' << 8) | 'C';
+    // Set in the alignment word of the file header of segments written with
+    // preallocate_segments. Only in those is data of a previous use of the
+    // file expected past the end of the segment, see read_log_file().
+    // Introduced with descriptor::segment_version_5, which older versions
+    // refuse to replay rather than read as an alignment.
+    static constexpr uint32_t preallocated_segment_flag = 0x80000000;
     static constexpr uint32_t multi_entry_size_magic = 0xffffffff;
     static constexpr uint32_t fragmented_entry_size_magic = 0xfffffffe;
 
+    // A compressed entry:
+    // header:
+    //      magic     : uint32_t
+    //      size      : uint32_t - of the entry, including header
+    //      raw size  : uint32_t - of the decompressed data
+    //      algorithm : uint32_t - compression_type, | compressed_with_dictionary
+    //      crc       : uint32_t - crc of the above
+    // -> compressed data
+    static constexpr size_t compressed_entry_overhead_size = 5 * sizeof(uint32_t);
+    static constexpr uint32_t compressed_entry_size_magic = 0xfffffffd;
+    static constexpr uint32_t compressed_with_dictionary = 0x100;
+    // Entries smaller than this are not worth compressing.
+    static constexpr size_t min_compressed_entry_size = 64;
+
+    // The compression dictionary, written first in a segment
+    // which compresses with one:
+    // header:
+    //      magic : uint32_t
+    //      size  : uint32_t - of the entry, including header
+    //      crc   : uint32_t - crc of the above
+    // -> dictionary data
+    static constexpr size_t dictionary_entry_overhead_size = 3 * sizeof(uint32_t);
+    static constexpr uint32_t dictionary_entry_magic = 0xfffffffc;
+
     // The commit log (chained) sync marker/header size in bytes (int: length + int: checksum [segmentId, position])
     static constexpr size_t sync_marker_size = 2 * sizeof(uint32_t);
 
@@ -833,6 +964,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             : _segment_manager(std::move(m)), _desc(std::move(d)), _file(std::move(f)),
         _alignment(alignment),
         _sync_time(clock_type::now()), _pending_ops(true) // want exception propagation
+        , _compression(_segment_manager->cfg.compression)
+        , _compression_dict(_compression != compression_type::none ? _segment_manager->_compression_dict : nullptr)
     {
         ++_segment_manager->totals.segments_created;
         clogger.debug("Created new segment {}", *this);
@@ -933,7 +1066,11 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
     
         co_await _pending_ops.close();
-        co_await _file.truncate(_flush_pos);
+        // Keep pre-allocated files whole, so that they can be recycled
+        // after replay without allocating and zeroing them again.
+        if (!_segment_manager->cfg.preallocate_segments) {
+            co_await _file.truncate(_flush_pos);
+        }
         co_await _file.close();
 
         if (p) {
@@ -1100,15 +1237,19 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
         if (off == 0) {
             // first block. write file header.
+            auto alignment_and_flags = uint32_t(_alignment);
+            if (_segment_manager->cfg.preallocate_segments) {
+                alignment_and_flags |= preallocated_segment_flag;
+            }
             write(out, segment_magic);
             write(out, _desc.ver);
             write(out, _desc.id);
-            write(out, uint32_t(_alignment));
+            write(out, alignment_and_flags);
             crc32_nbo crc;
             crc.process(_desc.ver);
             crc.process<int32_t>(_desc.id & 0xffffffff);
             crc.process<int32_t>(_desc.id >> 32);
-            crc.process<uint32_t>(uint32_t(_alignment));
+            crc.process<uint32_t>(alignment_and_flags);
             write(out, crc.checksum());
             header_size = descriptor_header_size;
         }
@@ -1235,6 +1376,12 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         auto fp = _file_pos;
         try {
             co_await _pending_ops.wait_for_pending(timeout);
+            if (fp == _file_pos && _segment_manager->cfg.mode == sync_mode::BATCH) {
+                // Let writes arriving in the group commit window join this
+                // buffer. The first of us to wake up writes it, the others
+                // find it gone and wait for that write below.
+                co_await _segment_manager->wait_for_group_commit(timeout);
+            }
             if (fp != _file_pos) {
                 // some other request already wrote this buffer.
                 // If so, wait for the operation at our intended file offset
@@ -1288,6 +1435,89 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             ; // total size
     }
 
+    struct compressed_entry {
+        temporary_buffer<char> data;
+        uint32_t raw_size;
+        bool compressed;
+    };
+
+    /**
+     * Serializes all entries of the writer, compressing those it is worth
+     * doing for. Calls writer.write() for each entry, in order, as allocate() would.
+     */
+    std::vector<compressed_entry> compress_entries(entry_writer& writer, size_t size) {
+        std::vector<compressed_entry> res;
+        res.reserve(writer.num_entries);
+
+        auto* dict = _compression_dict.get();
+
+        for (size_t entry = 0; entry < writer.num_entries; ++entry) {
+            auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+
+            std::vector<temporary_buffer<char>> raw;
+            raw.emplace_back(entry_size);
+            base_ostream_type raw_out = frag_ostream_type(detail::sector_split_iterator(raw.begin(), raw.end(), entry_size, 0), entry_size);
+            writer.write(*this, raw_out, entry);
+
+            _segment_manager->totals.bytes_compression_input += entry_size;
+
+            if (entry_size >= min_compressed_entry_size) {
+                // Only keep the result if it makes the entry smaller, header included.
+                temporary_buffer<char> c(entry_size - (compressed_entry_overhead_size - entry_overhead_size));
+                auto n = _segment_manager->_codec.compress(_compression, dict,
+                        std::span<const char>(raw.front().get(), entry_size), std::span<char>(c.get_write(), c.size()));
+                if (n != 0) {
+                    c.trim(n);
+                    _segment_manager->totals.bytes_compression_output += n;
+                    res.emplace_back(std::move(c), uint32_t(entry_size), true);
+                    continue;
+                }
+            }
+            _segment_manager->totals.bytes_compression_output += entry_size;
+            res.emplace_back(std::move(raw.front()), uint32_t(entry_size), false);
+        }
+        return res;
+    }
+
+    void write_compressed_entry(base_ostream_type& out, const compressed_entry& ce) {
+        crc32_nbo crc;
+
+        if (ce.compressed) {
+            auto es = uint32_t(ce.data.size() + compressed_entry_overhead_size);
+            auto algorithm = uint32_t(_compression) | (_compression_dict ? compressed_with_dictionary : 0);
+            write<uint32_t>(out, compressed_entry_size_magic);
+            write<uint32_t>(out, es);
+            write<uint32_t>(out, ce.raw_size);
+            write<uint32_t>(out, algorithm);
+            crc.process(uint32_t(compressed_entry_size_magic));
+            crc.process(es);
+            crc.process(ce.raw_size);
+            crc.process(algorithm);
+        } else {
+            auto es = uint32_t(ce.data.size() + entry_overhead_size);
+            write<uint32_t>(out, es);
+            crc.process(es);
+        }
+        write<uint32_t>(out, crc.checksum());
+        out.write(ce.data.get(), ce.data.size());
+    }
+
+    void write_dictionary(base_ostream_type& out) {
+        auto& data = _compression_dict->data;
+        auto size = uint32_t(data.size() + dictionary_entry_overhead_size);
+
+        crc32_nbo crc;
+        crc.process(uint32_t(dictionary_entry_magic));
+        crc.process(size);
+
+        write<uint32_t>(out, dictionary_entry_magic);
+        write<uint32_t>(out, size);
+        write<uint32_t>(out, crc.checksum());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+        _compression_dict_written = true;
+    }
+
     /**
      * Add a "mutation" to the segment.
      * Should only be called from "allocate_when_possible". "this" must be secure in a shared_ptr that will not
@@ -1299,15 +1529,24 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
 
         const auto size = writer.size(*this);
-        const auto s = writer_size(writer, size); // total size
+        auto s = writer_size(writer, size); // total size
 
         if (s > _segment_manager->max_mutation_size) {
             return write_result::too_large;
         }
 
-        if (!is_still_allocating() || next_position(s) > _segment_manager->max_size) { // would we make the file too big?
+        // The dictionary can only go first in the segment. If something else
+        // got there before us, entries are compressed without it.
+        if (_compression_dict && !_compression_dict_written && (writer.fragmented || _file_pos != 0 || !buffer_is_empty())) {
+            _compression_dict = nullptr;
+        }
+        const size_t dict_size = _compression_dict && !_compression_dict_written
+                ? dictionary_entry_overhead_size + _compression_dict->data.size()
+                : 0;
+
+        if (!is_still_allocating() || next_position(s + dict_size) > _segment_manager->max_size) { // would we make the file too big?
             return write_result::no_space;
-        } else if (!_buffer.empty() && (s > _buffer_ostream.size())) {  // enough data?
+        } else if (!_buffer.empty() && (s + dict_size > _buffer_ostream.size())) {  // enough data?
             if (_segment_manager->cfg.mode == sync_mode::BATCH || writer.sync) {
                 // TODO: this could cause starvation if we're really unlucky.
                 // If we run batch mode and find ourselves not fit in a non-empty
@@ -1319,7 +1558,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
 
         if (_buffer.empty()) {
-            new_buffer(s);
+            new_buffer(s + dict_size);
         }
 
         if (_closed) {
@@ -1329,6 +1568,22 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         auto pos = buffer_position();
         auto& out = _buffer_ostream;
 
+        if (dict_size) {
+            write_dictionary(out);
+        }
+
+        // Compressed entries are serialized up front, since the headers
+        // (and the size of the multi-entry below) depend on the result.
+        // Fragmented entries are always written as is.
+        std::vector<compressed_entry> compressed;
+        if (_compression != compression_type::none && !writer.fragmented) {
+            compressed = compress_entries(writer, size);
+            s = writer.num_entries > 1 ? multi_entry_overhead_size : 0;
+            for (auto& ce : compressed) {
+                s += ce.data.size() + (ce.compressed ? compressed_entry_overhead_size : entry_overhead_size);
+            }
+        }
+
         std::optional<crc32_nbo> mecrc;
 
         // if this is multi-entry write, we need to add an extra header + crc
@@ -1350,6 +1605,17 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         for (size_t entry = 0; entry < writer.num_entries; ++entry) {
             replay_position rp(_desc.id, position());
             auto id = writer.id(entry);
+
+            if (!compressed.empty()) {
+                _cf_dirty[id]++; // increase use count for cf.
+                _cf_min_time.emplace(id, gc_clock::now()); // if value already exists this does nothing.
+
+                rp_handle h(static_pointer_cast<cf_holder>(shared_from_this()), std::move(id), rp);
+                write_compressed_entry(out, compressed[entry]);
+                writer.result(entry, std::move(h));
+                continue;
+            }
+
             auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
             auto es = entry_size + entry_overhead_size;
 
@@ -1394,8 +1660,15 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         // When released (notify_memory_written), it will be based on bytes on disk.
         // Do this account based on "disk bytes" (buffer really), i.e. accounting for
         // sector boundaries and CRC overhead.
-        auto buf_memory = npos - pos - permit.release(); /* size in permit was already subtracted from sem count - ignore it here */
-        _segment_manager->account_memory_usage(buf_memory);
+        /* size in permit was already subtracted from sem count - ignore it here */
+        auto buf_memory = npos - pos;
+        auto permit_memory = permit.release();
+        if (buf_memory >= permit_memory) {
+            _segment_manager->account_memory_usage(buf_memory - permit_memory);
+        } else {
+            // compressed to less than the mutation size.
+            _segment_manager->notify_memory_written(permit_memory - buf_memory);
+        }
 
         ++_segment_manager->totals.allocation_count;
         ++_num_allocs;
@@ -1943,6 +2216,9 @@ void db::commitlog::segment_manager::update_configuration(const config& new_cfg)
     this->cfg.allow_fragmented_entries = new_cfg.allow_fragmented_entries;
     this->cfg.allow_going_over_size_limit = new_cfg.allow_going_over_size_limit;
     this->cfg.warn_about_segments_left_on_disk_after_shutdown = new_cfg.warn_about_segments_left_on_disk_after_shutdown;
+    // only affects segments created after this.
+    this->cfg.compression = new_cfg.compression;
+    this->cfg.commitlog_group_commit_window_in_us = new_cfg.commitlog_group_commit_window_in_us;
     
     // should be ok to update in runtime.
     this->cfg.extensions = new_cfg.extensions;
@@ -1950,6 +2226,27 @@ void db::commitlog::segment_manager::update_configuration(const config& new_cfg)
 } 
 
 
+future<> db::commitlog::segment_manager::wait_for_group_commit(db::timeout_clock::time_point timeout) {
+    if (!cfg.commitlog_group_commit_window_in_us) {
+        co_return;
+    }
+    // This only batches the writes of this shard: each shard still syncs its
+    // own segment. Windows are aligned to the (system wide) monotonic clock
+    // rather than started by the first write, so that the shards writing to
+    // the same disk at least issue their syncs at about the same time.
+    auto window = std::chrono::microseconds(cfg.commitlog_group_commit_window_in_us);
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    std::chrono::nanoseconds delay = window - now % window;
+    // Don't let the window eat the time the write has left, flush early instead.
+    auto timeout_now = db::timeout_clock::now();
+    if (timeout <= timeout_now) {
+        co_return;
+    }
+    delay = std::min<std::chrono::nanoseconds>(delay, timeout - timeout_now);
+    ++totals.group_commit_waits;
+    co_await seastar::sleep(delay);
+}
+
 size_t db::commitlog::segment_manager::max_request_controller_units() const {
     return max_mutation_size + db::commitlog::segment::default_size;
 }
@@ -2140,6 +2437,21 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("active_allocations", totals.active_allocations,
                        sm::description("Current number of active allocations.")),
+
+        sm::make_counter("group_commit_waits", totals.group_commit_waits,
+                       sm::description("Counts number of times a batch mode sync was delayed to the end of the group commit window.")),
+
+        sm::make_counter("compression_input_bytes", totals.bytes_compression_input,
+                       sm::description("Counts number of bytes of entries written to segments with compression enabled, before compression.")),
+
+        sm::make_counter("compression_output_bytes", totals.bytes_compression_output,
+                       sm::description("Counts number of bytes of entries written to segments with compression enabled, after compression. "
+                                       "Entries which do not compress well are stored as is.")),
+
+        sm::make_gauge("compression_ratio", [this] {
+                           return totals.bytes_compression_input ? double(totals.bytes_compression_output) / totals.bytes_compression_input : 1.0;
+                       },
+                       sm::description("Holds the ratio of compression_output_bytes to compression_input_bytes. Lower is better.")),
     });
 }
 
@@ -2305,7 +2617,7 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
         auto is_overwrite = false;
         auto existing_size = f.known_size();
 
-        if ((flags & open_flags::dsync) != open_flags{}) {
+        if ((flags & open_flags::dsync) != open_flags{} || cfg.preallocate_segments) {
             is_overwrite = true;
             // would be super nice if we just could mmap(/dev/zero) and do sendto
             // instead of this, but for now we must do explicit buffer writes.
@@ -3182,6 +3494,22 @@ void db::commitlog::update_configuration(const config& cfg) {
     _segment_manager->update_configuration(cfg);
 }
 
+void db::commitlog::set_compression_dictionary(std::span<const std::byte> data) {
+    if (data.empty()) {
+        _segment_manager->_compression_dict = nullptr;
+        return;
+    }
+    // The dictionary goes into the first buffer of each segment, so it must
+    // leave plenty of room for actual entries.
+    if (data.size() > _segment_manager->max_mutation_size / 4) {
+        clogger.warn("Not using a {} bytes compression dictionary, which is too large for {} bytes segments",
+                data.size(), _segment_manager->max_size);
+        _segment_manager->_compression_dict = nullptr;
+        return;
+    }
+    _segment_manager->_compression_dict = make_lw_shared<netw::shared_dict>(data, 0, utils::UUID{});
+}
+
 future<db::commitlog> db::commitlog::create_commitlog(config cfg) {
     commitlog c(std::move(cfg));
     co_await c._segment_manager->init();
@@ -3336,11 +3664,15 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
         size_t file_size = 0;
         size_t corrupt_size = 0;
         size_t alignment = 0;
+        bool preallocated = false;
         bool eof = false;
         bool header = true;
         bool failed = false;
         fragmented_temporary_buffer::reader frag_reader;
         fragmented_temporary_buffer buffer, initial;
+        // set if the segment starts with a compression dictionary
+        lw_shared_ptr<const netw::shared_dict> dict;
+        entry_codec codec;
 
         work(file f, descriptor din, commit_load_reader_func fn, replay_state::impl& sn, position_type o = 0)
                 : f(f), d(din), func(std::move(fn)), fin(make_file_input_stream(f, make_file_input_stream_options())), state(sn), start_off(o) {
@@ -3431,7 +3763,7 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
             if (magic != segment::segment_magic) {
                 throw invalid_segment_format();
             }
-            if (ver != descriptor::current_version) {
+            if (ver != descriptor::current_version && ver != descriptor::segment_version_4) {
                 throw std::invalid_argument("Cannot replay old commitlog segments");
             }
 
@@ -3448,12 +3780,19 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
 
             this->id = id;
             this->next = 0;
-            this->alignment = alignment;
+            if (ver == descriptor::segment_version_4) {
+                // Written before the flag existed.
+                this->alignment = alignment;
+                this->preallocated = false;
+            } else {
+                this->alignment = alignment & ~segment::preallocated_segment_flag;
+                this->preallocated = alignment & segment::preallocated_segment_flag;
+            }
             this->initial = std::move(buf);
             this->pos = this->initial.size_bytes();
         }
 
-        future<fragmented_temporary_buffer> read_data(size_t size) {
+        future<fragmented_temporary_buffer> read_data(size_t size, bool chunk_start = false) {
             auto rem = buffer.size_bytes();
             auto buf_vec = std::move(buffer).release();
             auto block_boundry = align_up(pos - initial.size_bytes(), alignment);
@@ -3516,6 +3855,15 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
                         throw segment_data_corruption_error(std::move(reason), alignment);
                     }
                     if (id != this->id) {
+                        // Chunks start at sector boundaries. If the first sector of a chunk
+                        // of a preallocated segment was written with an older segment id, it
+                        // is left over from a previous use of this (recycled) file, and the
+                        // data of this segment ends here. Elsewhere it's a truncation.
+                        if (preallocated && chunk_start && rem == 0 && id < this->id) {
+                            clogger.debug("Stale sector from segment {} at {}. End of segment {}.", id, pos, this->id);
+                            stop();
+                            co_return fragmented_temporary_buffer();
+                        }
                         auto reason = fmt::format("IDs do not match: {} vs. {}. rem={}, size={}",
                                 id, this->id, rem, size);
                         throw segment_truncation(std::move(reason), pos + rem);
@@ -3568,7 +3916,10 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
         future<> read_chunk() {
             clogger.debug("read_chunk {}", pos);
             auto start = pos;
-            auto buf = co_await read_data(segment::segment_overhead_size); 
+            auto buf = co_await read_data(segment::segment_overhead_size, true);
+            if (buf.empty()) {
+                co_return;
+            }
             auto in = buf.get_istream();
             auto next = read<uint32_t>(in);
             auto checksum = read<uint32_t>(in);
@@ -3597,6 +3948,10 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
             this->next = next;
 
             if (start_off >= next) {
+                // Entries we do not skip may need the dictionary at the start of the first chunk.
+                if (start == segment::descriptor_header_size && !end_of_chunk()) {
+                    co_await read_entry(true);
+                }
                 co_return co_await skip_to_chunk(next);
             }
 
@@ -3628,7 +3983,74 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
             clogger.trace("Pos {} -> {} ({})", old, pos, off);
         }
 
-        future<> read_entry() {
+        future<> read_dictionary(replay_position rp, uint32_t actual_size, crc32_nbo crc) {
+            auto buf = co_await read_data(sizeof(uint32_t));
+            auto in = buf.get_istream();
+            auto checksum = read<uint32_t>(in);
+
+            crc.process(actual_size);
+
+            if (actual_size < segment::dictionary_entry_overhead_size || crc.checksum() != checksum) {
+                auto slack = next - pos;
+                clogger.debug("Segment dictionary at {} has broken header. Skipping to next chunk ({} bytes)", rp, slack);
+                corrupt_size += slack;
+                co_await skip_to_chunk(next);
+                co_return;
+            }
+
+            buf = co_await read_data(actual_size - segment::dictionary_entry_overhead_size);
+            auto data = linearized(fragmented_temporary_buffer::view(buf));
+            dict = make_lw_shared<netw::shared_dict>(std::as_bytes(std::span(data.data(), data.size())), 0, utils::UUID{});
+        }
+
+        future<> read_compressed_entry(replay_position rp, uint32_t actual_size, crc32_nbo crc) {
+            auto buf = co_await read_data(segment::compressed_entry_overhead_size - segment::entry_overhead_size);
+            auto in = buf.get_istream();
+            auto raw_size = read<uint32_t>(in);
+            auto algorithm = read<uint32_t>(in);
+            auto checksum = read<uint32_t>(in);
+
+            crc.process(actual_size);
+            crc.process(raw_size);
+            crc.process(algorithm);
+
+            if (actual_size < segment::compressed_entry_overhead_size || crc.checksum() != checksum) {
+                auto slack = next - pos;
+                clogger.debug("Compressed segment entry at {} has broken header. Skipping to next chunk ({} bytes)", rp, slack);
+                corrupt_size += slack;
+                co_await skip_to_chunk(next);
+                co_return;
+            }
+
+            buf = co_await read_data(actual_size - segment::compressed_entry_overhead_size);
+
+            auto with_dict = bool(algorithm & segment::compressed_with_dictionary);
+            if (with_dict && !dict) {
+                clogger.debug("Compressed segment entry at {} needs a dictionary, which segment does not have. Skipping ({} bytes)", rp, actual_size);
+                corrupt_size += actual_size;
+                co_return;
+            }
+
+            auto data = linearized(fragmented_temporary_buffer::view(buf));
+            temporary_buffer<char> raw(raw_size);
+            try {
+                codec.decompress(db::commitlog::compression_type(algorithm & ~segment::compressed_with_dictionary),
+                        with_dict ? dict.get() : nullptr,
+                        std::span<const char>(reinterpret_cast<const char*>(data.data()), data.size()), std::span<char>(raw.get_write(), raw.size()));
+            } catch (...) {
+                clogger.debug("Failed to decompress segment entry at {}: {}. Skipping ({} bytes)", rp, std::current_exception(), actual_size);
+                corrupt_size += actual_size;
+                co_return;
+            }
+
+            std::vector<temporary_buffer<char>> frags;
+            frags.emplace_back(std::move(raw));
+            co_await func({fragmented_temporary_buffer(std::move(frags), raw_size), rp});
+        }
+
+        // If dictionary_only is set, only a dictionary entry is consumed, and
+        // anything else skips to the next chunk.
+        future<> read_entry(bool dictionary_only = false) {
             static constexpr size_t entry_header_size = segment::entry_overhead_size;
 
             clogger.debug("read_entry {}", pos);
@@ -3654,6 +4076,16 @@ db::commitlog::read_log_file(const replay_state& state, sstring filename, sstrin
             crc32_nbo crc;
             crc.process(size);
 
+            if (size == segment::dictionary_entry_magic) {
+                co_return co_await read_dictionary(rp, checksum, crc);
+            }
+            if (dictionary_only) {
+                co_return co_await skip_to_chunk(next);
+            }
+            if (size == segment::compressed_entry_size_magic) {
+                co_return co_await read_compressed_entry(rp, checksum, crc);
+            }
+
             // check for multi-entry
             if (size == segment::multi_entry_size_magic) {
                 auto actual_size = checksum;
@@ -3907,6 +4339,14 @@ uint64_t db::commitlog::get_num_active_allocations() const {
     return _segment_manager->totals.active_allocations;
 }
 
+uint64_t db::commitlog::get_compression_input_bytes() const {
+    return _segment_manager->totals.bytes_compression_input;
+}
+
+uint64_t db::commitlog::get_compression_output_bytes() const {
+    return _segment_manager->totals.bytes_compression_output;
+}
+
 future<std::vector<db::commitlog::descriptor>> db::commitlog::list_existing_descriptors() const {
     return list_existing_descriptors(active_config().commit_log_location);
 }
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/simple-stream.hh>
@@ -82,6 +83,11 @@ class commitlog {
     enum class sync_mode {
         PERIODIC, BATCH
     };
+    // Compression of the entries written to new segments. The values are
+    // stored in the headers of compressed entries.
+    enum class compression_type : uint8_t {
+        none = 0, lz4 = 1, zstd = 2,
+    };
     using force_sync = commitlog_entry_writer::force_sync;
     struct config {
         config() = default;
@@ -96,6 +102,10 @@ class commitlog {
         std::optional<uint64_t> commitlog_data_max_lifetime_in_seconds = {};
         uint64_t commitlog_segment_size_in_mb = 32;
         uint64_t commitlog_sync_period_in_ms = 10 * 1000; //TODO: verify default!
+        // In BATCH mode, delay syncs to the end of the current window of the
+        // monotonic clock, so that the writes of a window share one write +
+        // flush, and shards sharing a disk flush together. 0 disables.
+        uint64_t commitlog_group_commit_window_in_us = 0;
         // Max number of segments to keep in pre-alloc reserve.
         // Not (yet) configurable from scylla.conf.
         uint64_t max_reserve_segments = 12;
@@ -107,9 +117,16 @@ class commitlog {
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        // Fully allocate and zero new segment files, even without O_DSYNC,
+        // and keep them at full size on shutdown. Recycled files are then
+        // overwritten in place, without extent allocation or size changes.
+        // Stale data past the end of a recycled segment is told apart by
+        // the segment id written in each sector.
+        bool preallocate_segments = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = false;
         bool allow_fragmented_entries = false;
+        compression_type compression = compression_type::none;
 
         // The base segment ID to use.
         // The segment IDs of newly allocated segments will be issued sequentially
@@ -136,7 +153,9 @@ class commitlog {
         static inline constexpr uint32_t segment_version_2 = 2u;
         static inline constexpr uint32_t segment_version_3 = 3u;
         static inline constexpr uint32_t segment_version_4 = 4u;
-        static inline constexpr uint32_t current_version = segment_version_4;
+        // Adds segment::preallocated_segment_flag to the file header.
+        static inline constexpr uint32_t segment_version_5 = 5u;
+        static inline constexpr uint32_t current_version = segment_version_5;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
@@ -169,6 +188,14 @@ class commitlog {
      */
     void update_configuration(const config&);
 
+    /**
+     * Sets the dictionary used to compress entries of segments created from
+     * now on (see config::compression). An empty dictionary unsets it.
+     * Each segment stores the dictionary it was compressed with, so that it
+     * can be replayed on its own.
+     */
+    void set_compression_dictionary(std::span<const std::byte>);
+
     /**
      * Note: To be able to keep impl out of header file,
      * actual data writing is done via a std::function.
@@ -315,6 +342,9 @@ class commitlog {
     uint64_t get_num_segments_destroyed() const;
     uint64_t get_num_blocked_on_new_segment() const;
     uint64_t get_num_active_allocations() const;
+    // Bytes of entries before and after compression, see config::compression.
+    uint64_t get_compression_input_bytes() const;
+    uint64_t get_compression_output_bytes() const;
 
 
     /**
@@ -29,6 +29,7 @@
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/sstable_filter_extension.hh"
 #include "db/tags/extension.hh"
 #include "db/object_storage_endpoint_param.hh"
 #include "config.hh"
@@ -636,6 +637,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Set the minimum interval in seconds between flushing all tables before each major compaction (default is 86400)."
         "This option is useful for maximizing tombstone garbage collection by releasing all active commitlog segments."
         "Set to 0 to disable automatic flushing all tables before major compaction.")
+    , compaction_major_token_range_parallelism(this, "compaction_major_token_range_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of disjoint token ranges a major compaction is split into, which are compacted concurrently. "
+        "Each range holds at least 1GB of input data. Set to 1 (default) to compact the whole token range sequentially.")
+    , compaction_scale_backlog_by_cost(this, "compaction_scale_backlog_by_cost", liveness::LiveUpdate, value_status::Used, false,
+        "Scale the compaction backlog of each table by the estimated CPU and I/O cost of compacting a byte of the table, "
+        "relative to the mean cost of the tables of the shard. The backlog shifts towards the tables which are expensive to compact, "
+        "but stays the same if all tables cost the same.")
     /**
     * @Group Initialization properties
     * @GroupDescription The minimal properties needed for configuring a cluster.
@@ -812,6 +820,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in ``batch`` mode.")
+    , commitlog_group_commit_window_in_us(this, "commitlog_group_commit_window_in_us", value_status::Used, 0,
+        "Batching window for ``batch`` mode, in microseconds. Syncs are delayed to the end of the current window, so that the writes a shard "
+        "does within a window are written and flushed together, with one sync of its segment. Each shard still syncs its own segment, "
+        "but the windows are aligned across shards, so shards sharing a disk issue their syncs at about the same time. "
+        "Larger windows mean fewer and larger I/Os, at the cost of write latency. A few hundred microseconds is a good start for NVMe disks. 0 (the default) disables it.")
     , commitlog_max_data_lifetime_in_seconds(this, "commitlog_max_data_lifetime_in_seconds", liveness::LiveUpdate, value_status::Used, 24*60*60,
         "Controls how long data remains in commit log before the system tries to evict it to sstable, regardless of usage pressure. (0 disables)")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
@@ -825,16 +838,26 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Threshold for commitlog disk usage. When used disk space goes above this value, Scylla initiates flushes of memtables to disk for the oldest commitlog segments, removing those log segments. Adjusting this affects disk usage vs. write latency. Default is (approximately) commitlog_total_space_in_mb - <num shards>*commitlog_segment_size_in_mb.")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_preallocate_segments(this, "commitlog_preallocate_segments", value_status::Used, false,
+        "Whether or not to fully allocate and zero commitlog segment files when they are created, also without O_DSYNC, and keep them at full size on shutdown. "
+        "Recycled segments are then overwritten in place, so that writes never allocate extents or update the file size.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Deprecated, true,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas disabling this can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, "none",
+        "Compression of the entries written to commitlog segments:\n"
+        "* none: Entries are written uncompressed.\n"
+        "* lz4: Entries are compressed with LZ4.\n"
+        "* zstd: Entries are compressed with zstd (level 1).\n"
+        "Once the RPC compression dictionary is trained, it is also used for the commitlog and stored in each segment using it. "
+        "Older versions cannot replay compressed segments, so drain the node before downgrading.")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
     */
-    , compaction_preheat_key_cache(this, "compaction_preheat_key_cache", value_status::Unused, true,
-        "When set to true , cached row keys are tracked during compaction, and re-cached to their new positions in the compacted SSTable. If you have extremely large key caches for tables, set the value to false ; see Global row and key caches properties.")
+    , compaction_preheat_key_cache(this, "compaction_preheat_key_cache", liveness::LiveUpdate, value_status::Used, false,
+        "When set to true, the index cache occupancy of the compacted SSTables is carried over to the SSTables written by compaction: the index pages covering the token ranges of the index pages which were cached in the input SSTables are read into the cache of the new SSTables before they replace the input ones. Only SSTables with an Index.db component are preheated. Has no effect when cache_index_pages is false.")
     , concurrent_compactors(this, "concurrent_compactors", value_status::Invalid, 0,
         "Sets the number of concurrent compaction processes allowed to run simultaneously on a node, not including validation compactions for anti-entropy repair. Simultaneous compactions help preserve read performance in a mixed read-write workload by mitigating the tendency of small SSTables to accumulate during a single long-running compaction. If compactions run too slowly or too fast, change compaction_throughput_mb_per_sec first.")
     , in_memory_compaction_limit_in_mb(this, "in_memory_compaction_limit_in_mb", value_status::Invalid, 64,
@@ -872,6 +895,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Granularity of the index of rows within a partition. For huge rows, decrease this setting to improve seek time. If you use key cache, be careful not to make this setting too large because key cache will be overwhelmed. If you're unsure of the size of the rows, it's best to use the default setting.")
     , column_index_auto_scale_threshold_in_kb(this, "column_index_auto_scale_threshold_in_kb", liveness::LiveUpdate, value_status::Used, 10240,
         "Auto-reduce the promoted index granularity by half when reaching this threshold, to prevent promoted index bloating due to partitions with too many rows. Set to 0 to disable this feature.")
+    , row_hash_index_min_partition_size_in_kb(this, "row_hash_index_min_partition_size_in_kb", liveness::LiveUpdate, value_status::Used, 0,
+        "Write a row hash index (RowHashes.db) for partitions larger than this, mapping full clustering keys to row positions, so that single row reads skip the promoted index search and the scan of a promoted index block. "
+        "Applies to sstables with the BIG index format of tables whose clustering key types have a single serialized form for each value. Set to 0 to disable this feature.")
     , index_summary_capacity_in_mb(this, "index_summary_capacity_in_mb", value_status::Unused, 0,
         "Fixed memory pool size in MB for SSTable index summaries. If the memory usage of all index summaries exceeds this limit, any SSTables with low read rates shrink their index summaries to meet this limit. This is a best-effort process. In extreme conditions, Cassandra may need to use more than this amount of memory.")
     , index_summary_resize_interval_in_minutes(this, "index_summary_resize_interval_in_minutes", value_status::Unused, 60,
@@ -1310,6 +1336,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , sstable_split_block_bloom_filter(this, "sstable_split_block_bloom_filter", liveness::LiveUpdate, value_status::Used, false, "Write the bloom filter of new sstables in the cache-line-blocked (split block) format, which costs at most one cache miss per lookup."
+        " Takes effect only once all nodes in the cluster support the format. Existing sstables are read in whichever format they were written.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Unused, true, "Enable cpu scheduling.")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
@@ -1471,6 +1499,17 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , cache_admission_filter(this, "cache_admission_filter", liveness::LiveUpdate, value_status::Used, false,
+        "Use a TinyLFU admission filter in front of the row cache. Rows of partitions which were not read recently are cached on probation, and are evicted before other rows unless read again. Protects the frequently read data from being evicted by scans and reads of cold partitions.")
+    , cache_scan_detection_threshold(this, "cache_scan_detection_threshold", liveness::LiveUpdate, value_status::Used, 0,
+        "Range reads which go through more than this many partitions are considered scans. Data which scans populate into the row cache is cached on probation, and is evicted before other data unless read again. Set to 0 to disable.")
+    , cache_cold_tier_fraction(this, "cache_cold_tier_fraction", liveness::LiveUpdate, value_status::Used, 0.0,
+        "Fraction of shard memory which can be used by the cold tier of the row cache. Small partitions evicted from the cache are kept there lz4-compressed, and are decompressed back into the cache when read again. Trades CPU on hits to the cold tier for a larger effective cache size. Set to 0 to disable.")
+    , index_cache_size_in_mb(this, "index_cache_size_in_mb", liveness::LiveUpdate, value_status::Used, 0,
+        "The maximum amount of memory per shard, in megabytes, permitted for use by the SSTable index cache, in addition to the limit set by ``index_cache_fraction``. The lower of the two limits applies. When index pages have to be evicted, pages which are cheaper to read back, per byte, are preferred among the least recently used ones, e.g. pages of local SSTables over those on object storage. Set to 0 to only use ``index_cache_fraction``.")
+    , pinned_index_memory_fraction(this, "pinned_index_memory_fraction", liveness::LiveUpdate, value_status::Used, 0.05,
+        "The maximum fraction of the memory available to the database on a shard which can be used by SSTable indexes of tables with the ``pin_index`` caching option, like ``components_memory_reclaim_threshold``. User and system tables have separate budgets of this size. Such indexes are loaded into memory in full when the SSTable is opened, and are never evicted. Indexes which do not fit are cached as usual. "
+        "Changing ``pin_index`` with ALTER TABLE only affects SSTables opened afterwards, e.g. those written by flushes and compactions.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Used, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.  Note: gossip topology changes are incompatible with tablets.")
     , recovery_leader(this, "recovery_leader", liveness::LiveUpdate, value_status::Used, utils::null_uuid(), "Host ID of the node restarted first while performing the Manual Raft-based Recovery Procedure. Warning: this option disables some guardrails for the needs of the Manual Raft-based Recovery Procedure. Make sure you unset it at the end of the procedure.")
@@ -1582,12 +1621,17 @@ void db::config::add_paxos_grace_seconds_extension() {
     _extensions->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
 }
 
+void db::config::add_sstable_filter_extension() {
+    _extensions->add_schema_extension<db::sstable_filter_extension>(db::sstable_filter_extension::NAME);
+}
+
 void db::config::add_all_default_extensions() {
     add_cdc_extension();
     add_per_partition_rate_limit_extension();
     add_tags_extension();
     add_tombstone_gc_extension();
     add_paxos_grace_seconds_extension();
+    add_sstable_filter_extension();
 }
 
 void db::config::setup_directories() {
@@ -154,6 +154,7 @@ class config final : public utils::config_file {
     void add_tags_extension();
     void add_tombstone_gc_extension();
     void add_paxos_grace_seconds_extension();
+    void add_sstable_filter_extension();
 
     void add_all_default_extensions();
 
@@ -191,6 +192,8 @@ class config final : public utils::config_file {
     named_value<float> compaction_static_shares;
     named_value<bool> compaction_enforce_min_threshold;
     named_value<uint32_t> compaction_flush_all_tables_before_major_seconds;
+    named_value<uint32_t> compaction_major_token_range_parallelism;
+    named_value<bool> compaction_scale_backlog_by_cost;
     named_value<sstring> cluster_name;
     named_value<sstring> listen_address;
     named_value<sstring> listen_interface;
@@ -230,13 +233,16 @@ class config final : public utils::config_file {
     named_value<uint32_t> schema_commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_group_commit_window_in_us;
     named_value<uint32_t> commitlog_max_data_lifetime_in_seconds;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
     named_value<int64_t> commitlog_flush_threshold_in_mb;
     named_value<bool> commitlog_use_o_dsync;
+    named_value<bool> commitlog_preallocate_segments;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<sstring> commitlog_compression;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -252,6 +258,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> memtable_offheap_space_in_mb;
     named_value<uint32_t> column_index_size_in_kb;
     named_value<uint32_t> column_index_auto_scale_threshold_in_kb;
+    named_value<uint32_t> row_hash_index_min_partition_size_in_kb;
     named_value<uint32_t> index_summary_capacity_in_mb;
     named_value<uint32_t> index_summary_resize_interval_in_minutes;
     named_value<double> reduce_cache_capacity_to;
@@ -406,6 +413,7 @@ class config final : public utils::config_file {
     named_value<bool> enable_node_aggregated_table_metrics;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<bool> sstable_split_block_bloom_filter;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
     named_value<bool> enable_sstables_mc_format;
@@ -493,6 +501,11 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<bool> cache_admission_filter;
+    named_value<uint32_t> cache_scan_detection_threshold;
+    named_value<double> cache_cold_tier_fraction;
+    named_value<uint32_t> index_cache_size_in_mb;
+    named_value<double> pinned_index_memory_fraction;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
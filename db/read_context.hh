@@ -143,6 +143,16 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
     std::optional<dht::decorated_key> _key;
     bool _partition_exists;
     row_cache::phase_type _phase;
+    // Partitions entered so far, used to detect scans.
+    uint64_t _partitions_entered = 0;
+    bool _scan = false;
+
+    void on_partition_entered() noexcept {
+        auto threshold = _cache._tracker.scan_detection_threshold();
+        if (_range_query && threshold && ++_partitions_entered > threshold) {
+            _scan = true;
+        }
+    }
 public:
     read_context(row_cache& cache,
             schema_ptr schema,
@@ -191,6 +201,10 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
     tracing::trace_state_ptr trace_state() const { return _trace_state; }
     mutation_reader::forwarding fwd_mr() const { return _fwd_mr; }
     bool is_range_query() const { return _range_query; }
+    // True for range reads which went through more than cache_tracker::scan_detection_threshold()
+    // partitions. Data populated by such reads is unlikely to be read again soon, so it goes to
+    // the LRU on probation and doesn't push out the working set of other reads.
+    bool is_scan() const { return _scan; }
     autoupdating_underlying_reader& underlying() { return _underlying; }
     row_cache::phase_type phase() const { return _phase; }
     const dht::decorated_key& key() const { return *_key; }
@@ -218,6 +232,7 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
 public:
     future<> create_underlying();
     void enter_partition(const dht::decorated_key& dk, mutation_source& snapshot, row_cache::phase_type phase) {
+        on_partition_entered();
         _phase = phase;
         _underlying_snapshot = snapshot;
         _key = dk;
@@ -225,6 +240,7 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
     // Precondition: each caller needs to make sure that partition with |dk| key
     //               exists in underlying before calling this function.
     void enter_partition(const dht::decorated_key& dk, row_cache::phase_type phase) {
+        on_partition_entered();
         _phase = phase;
         _underlying_snapshot = {};
         _key = dk;
@@ -72,6 +72,7 @@ cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fractio
     , _memtable_cleaner(_region, nullptr, app_stats)
     , _app_stats(app_stats)
     , _index_cache_fraction(std::move(index_cache_fraction))
+    , _demotion_timer([this] { demote_some(demotion_batch); })
 {
     if (with_metrics) {
         setup_metrics();
@@ -111,12 +112,14 @@ cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fractio
             //    for both extremes, although it might be suboptimal for non-extremes.
             // 3. The parameter is trivially live-updateable.
             //
+            // The index cache can also be capped with an absolute size (index_cache_size_in_mb),
+            // the lower of the two limits applies.
+            //
             // Perhaps this logic should be encapsulated somewhere else, maybe in `class lru` itself.
-            size_t total_cache_space = _region.occupancy().total_space();
-            size_t index_cache_space = _partition_index_cache_stats.used_bytes + _index_cached_file_stats.cached_bytes;
-            bool should_evict_index = index_cache_space > total_cache_space * _index_cache_fraction.get();
-
-            return _lru.evict(should_evict_index);
+            if (_cold_tier.enabled() && !_demotion_timer.armed()) {
+                _demotion_timer.arm(std::chrono::milliseconds(10));
+            }
+            return _lru.evict(index_cache_over_limit());
         });
     });
 }
@@ -125,6 +128,16 @@ cache_tracker::~cache_tracker() {
     clear();
 }
 
+bool cache_tracker::index_cache_over_limit() const noexcept {
+    size_t total_cache_space = _region.occupancy().total_space();
+    // Pinned index pages can't be evicted, don't make the other index entries pay for them.
+    size_t index_cache_space = _partition_index_cache_stats.used_bytes
+            + _index_cached_file_stats.cached_bytes - _index_cached_file_stats.pinned_bytes;
+    size_t limit_in_mb = _index_cache_size_in_mb.get();
+    return index_cache_space > total_cache_space * _index_cache_fraction.get()
+        || (limit_in_mb && index_cache_space > limit_in_mb << 20);
+}
+
 memory::reclaiming_result cache_tracker::evict_from_lru_shallow() noexcept {
     return with_allocator(_region.allocator(), [this] () noexcept {
         current_tracker = this;
@@ -155,6 +168,7 @@ cache_tracker::setup_metrics() {
         sm::make_counter("dummy_row_hits", sm::description("total number of dummy rows touched by reads in cache"), _stats.dummy_row_hits),
         sm::make_counter("row_misses", sm::description("total number of rows needed by reads and missing in cache"), _stats.row_misses)(basic_level),
         sm::make_counter("row_insertions", sm::description("total number of rows added to cache"), _stats.row_insertions)(basic_level),
+        sm::make_counter("row_probation_insertions", sm::description("total number of rows added to cache on probation by the admission filter or by scans, included in row_insertions"), _stats.row_probation_insertions),
         sm::make_counter("row_evictions", sm::description("total number of rows evicted from cache"), _stats.row_evictions)(basic_level),
         sm::make_counter("row_removals", sm::description("total number of invalidated rows"), _stats.row_removals)(basic_level),
         sm::make_counter("rows_dropped_by_tombstones", _app_stats.rows_dropped_by_tombstones, sm::description("Number of rows dropped in cache by a tombstone write")),
@@ -188,6 +202,22 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of attempts to compact expired rows during read")),
         sm::make_counter("rows_compacted_away", _stats.rows_compacted_away,
             sm::description("total amount of compacted and removed rows during read")),
+        sm::make_counter("cold_tier_insertions", [this] { return _cold_tier.get_stats().insertions; },
+            sm::description("total number of partitions evicted from cache which were compressed into the cold tier")),
+        sm::make_counter("cold_tier_hits", [this] { return _cold_tier.get_stats().hits; },
+            sm::description("total number of partitions moved back to cache from the cold tier by reads")),
+        sm::make_counter("cold_tier_evictions", [this] { return _cold_tier.get_stats().evictions; },
+            sm::description("total number of partitions dropped from the cold tier to stay within its memory limit")),
+        sm::make_counter("cold_tier_invalidations", [this] { return _cold_tier.get_stats().invalidations; },
+            sm::description("total number of partitions dropped from the cold tier because of updates")),
+        sm::make_counter("cold_tier_failed_insertions", [this] { return _cold_tier.get_stats().failed_insertions; },
+            sm::description("total number of partitions which could not be compressed into the cold tier, e.g. due to lack of memory")),
+        sm::make_gauge("cold_tier_partitions", [this] { return _cold_tier.get_stats().partitions; },
+            sm::description("number of partitions in the cold tier")),
+        sm::make_gauge("cold_tier_bytes", [this] { return _cold_tier.get_stats().bytes; },
+            sm::description("memory used by the cold tier")),
+        sm::make_gauge("cold_tier_uncompressed_bytes", [this] { return _cold_tier.get_stats().uncompressed_bytes; },
+            sm::description("serialized size of the partitions in the cold tier before compression")),
     });
     sstables::register_index_page_cache_metrics(_metrics, _index_cached_file_stats);
     sstables::register_index_page_metrics(_metrics, _partition_index_cache_stats);
@@ -207,6 +237,7 @@ void cache_tracker::clear() {
         _garbage.clear();
         _memtable_cleaner.clear();
     });
+    _cold_tier.clear();
     _stats.partition_removals += partitions_before;
     _stats.row_removals += rows_before;
     allocator().invalidate_references();
@@ -220,7 +251,40 @@ void cache_tracker::touch(rows_entry& e) {
     _lru.add(e);
 }
 
+utils::frequency_sketch* cache_tracker::admission_sketch() noexcept {
+    if (!_admission_filter.get()) {
+        return nullptr;
+    }
+    if (!_admission_sketch) [[unlikely]] {
+        try {
+            _admission_sketch = std::make_unique<utils::frequency_sketch>(admission_sketch_keys);
+        } catch (...) {
+            // Admit everything, try again next time.
+            return nullptr;
+        }
+    }
+    return _admission_sketch.get();
+}
+
+bool cache_tracker::on_partition_access(const dht::token& t) noexcept {
+    auto* sketch = admission_sketch();
+    if (!sketch) {
+        return true;
+    }
+    sketch->increment(t.raw());
+    return sketch->frequency(t.raw()) >= admission_threshold;
+}
+
+bool cache_tracker::admits(const dht::token& t) noexcept {
+    auto* sketch = admission_sketch();
+    return !sketch || sketch->frequency(t.raw()) + 1 >= admission_threshold;
+}
+
 void cache_tracker::insert(cache_entry& entry) {
+    if (!admits(entry.key().token())) {
+        insert_probation(entry);
+        return;
+    }
     insert(entry.partition());
     ++_stats.partition_insertions;
     ++_stats.partitions;
@@ -228,6 +292,18 @@ void cache_tracker::insert(cache_entry& entry) {
     _region.allocator().invalidate_references();
 }
 
+void cache_tracker::insert_probation(cache_entry& entry) {
+    for (partition_version& pv : entry.partition().versions_from_oldest()) {
+        for (rows_entry& row : pv.partition().clustered_rows()) {
+            insert_probation(row);
+        }
+    }
+    ++_stats.partition_insertions;
+    ++_stats.partitions;
+    // partition_range_cursor depends on this to detect invalidation of _end
+    _region.allocator().invalidate_references();
+}
+
 void cache_tracker::on_partition_erase() noexcept {
     --_stats.partitions;
     ++_stats.partition_removals;
@@ -579,7 +655,8 @@ class range_populating_reader {
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
-                                                               this->can_set_continuity() ? &*_last_key : nullptr);
+                                                               this->can_set_continuity() ? &*_last_key : nullptr,
+                                                               _read_context.is_scan());
                         _last_key = row_cache::previous_entry_pointer(key);
                         return make_ready_future<mutation_reader_opt>(e.read(_cache, _read_context, _reader.creation_phase()));
                     });
@@ -788,6 +865,7 @@ row_cache::make_reader_opt(schema_ptr s,
     if (query::is_single_partition(range) && !fwd_mr) {
         tracing::trace(trace_state, "Querying cache for range {} and slice {}",
                 range, seastar::value_of([&slice] { return slice.get_all_ranges(); }));
+        populate_from_cold_tier(range.start()->value().as_decorated_key());
         auto mr = _read_section(_tracker.region(), [&] () -> mutation_reader_opt {
             dht::ring_position_comparator cmp(*_schema);
             auto&& pos = range.start()->value();
@@ -864,6 +942,7 @@ mutation_reader row_cache::make_nonpopulating_reader(schema_ptr schema, reader_p
 }
 
 void row_cache::clear_on_destruction() noexcept {
+    _tracker.cold_tier().invalidate(_schema->id());
     with_allocator(_tracker.allocator(), [this] {
         _partitions.clear_and_dispose([this] (cache_entry* p) mutable noexcept {
             if (!p->is_dummy_entry()) {
@@ -879,6 +958,7 @@ row_cache::~row_cache() {
 }
 
 void row_cache::clear_now() noexcept {
+    _tracker.cold_tier().invalidate(_schema->id());
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
             _tracker.on_partition_erase();
@@ -922,13 +1002,19 @@ cache_entry& row_cache::do_find_or_create_entry(const dht::decorated_key& key,
     });
 }
 
-cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous) {
+cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous,
+                                                  bool probation) {
     return do_find_or_create_entry(ps.key(), previous, [&] (auto i, const partitions_type::bound_hint& hint) { // create
         // Create an fully discontinuous, except for the partition tombstone, entry
         mutation_partition mp = mutation_partition::make_incomplete(*_schema, ps.partition_tombstone());
         partitions_type::iterator entry = _partitions.emplace_before(i, ps.key().token().raw(), hint,
                 _schema, ps.key(), std::move(mp));
-        _tracker.insert(*entry);
+        if (probation) {
+            _tracker.insert_probation(*entry);
+            ++_stats.scan_probation_insertions;
+        } else {
+            _tracker.insert(*entry);
+        }
         return entry;
     }, [&] (auto i) { // visit
         _tracker.on_miss_already_populated();
@@ -967,6 +1053,31 @@ void row_cache::populate(const mutation& m, const previous_entry_pointer* previo
   });
 }
 
+void row_cache::populate_from_cold_tier(const dht::decorated_key& dk) {
+    std::optional<mutation> m;
+    try {
+        m = _tracker.cold_tier().take(_schema, dk);
+    } catch (...) {
+        clogger.warn("Failed to read partition {} from the cold tier: {}", dk, std::current_exception());
+        return;
+    }
+    if (!m) {
+        return;
+    }
+    _populate_section(_tracker.region(), [&] {
+        do_find_or_create_entry(dk, nullptr, [&] (auto i, const partitions_type::bound_hint& hint) {
+            partitions_type::iterator entry = _partitions.emplace_before(i, dk.token().raw(), hint,
+                    m->schema(), dk, m->partition());
+            _tracker.insert(*entry);
+            entry->set_continuous(i->continuous());
+            upgrade_entry(*entry);
+            return entry;
+        }, [&] (auto i) {
+            // Populated by a range read in the meantime.
+        });
+    });
+}
+
 cache_entry& row_cache::lookup(const dht::decorated_key& key) {
     return do_find_or_create_entry(key, nullptr, [&] (auto i, const partitions_type::bound_hint& hint) {
         throw std::runtime_error(format("cache doesn't contain entry for {}", key));
@@ -1066,6 +1177,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                             if (!update) {
                                 _update_section(_tracker.region(), [&] {
                                     replica::memtable_entry& mem_e = *m.partitions.begin();
+                                    _tracker.cold_tier().erase(_schema->id(), mem_e.key());
                                     size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
                                     partitions_type::bound_hint hint;
                                     auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
@@ -1197,6 +1309,7 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    _tracker.cold_tier().erase(_schema->id(), dk);
     auto pos = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1227,6 +1340,14 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
                 _prev_snapshot = {};
             });
 
+            // The cold tier is not subject to population phases, drop the affected
+            // entries up front, so that no read can bring them back from now on,
+            // and keep the partitions which are yet to be walked from being demoted.
+            cache::cold_tier::invalidation_fence fence(_tracker.cold_tier(), _schema->id(), ranges);
+            for (auto&& range : ranges) {
+                _tracker.cold_tier().invalidate(_schema->id(), range, filter);
+            }
+
             for (auto&& range : ranges) {
                 _prev_snapshot_pos = dht::ring_position_view::for_range_start(range);
                 seastar::thread::maybe_yield();
@@ -1270,6 +1391,7 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
                     // is already invalidated and >= _prev_snapshot_pos is not yet invalidated.
                     seastar::thread::yield();
                 }
+                _tracker.cold_tier().invalidate(_schema->id(), range, filter);
             }
 
             on_failure.cancel();
@@ -1279,6 +1401,7 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
 
 void row_cache::evict() {
     while (_tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something) {}
+    _tracker.cold_tier().invalidate(_schema->id());
 }
 
 row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker, is_continuous cont)
@@ -1357,6 +1480,70 @@ mutation_partition_v2::rows_type::iterator on_evicted_shallow(rows_entry& e, cac
     return it;
 }
 
+bool cache_tracker::try_demote(rows_entry& e) noexcept {
+    // Only small partitions are demoted, find out if e's is one without walking all of it.
+    mutation_partition_v2::rows_type::iterator it(&e);
+    for (size_t n = 0; it && n <= cache::cold_tier::max_partition_rows; ++n) {
+        ++it;
+    }
+    mutation_partition_v2::rows_type* rows = it.tree_if_end();
+    if (!rows) {
+        return false;
+    }
+    partition_version& pv = partition_version::container_of(mutation_partition_v2::container_of(*rows));
+    // Older versions may be needed by snapshots, and the data of the partition
+    // is spread over them.
+    if (!pv.is_referenced_from_entry() || pv.next()) {
+        return false;
+    }
+    partition_entry& pe = partition_entry::container_of(pv);
+    if (pe.is_locked() || !pv.partition().is_fully_continuous()) {
+        return false;
+    }
+    cache_entry& ce = cache_entry::container_of(pe);
+    if (!_cold_tier.insert(pv.get_schema(), ce.key(), pv.partition())) {
+        return false;
+    }
+    ce.on_evicted(*this);
+    return true;
+}
+
+size_t cache_tracker::demote_some(size_t max_partitions) noexcept {
+    if (!_cold_tier.enabled()) {
+        return 0;
+    }
+    size_t demoted = 0;
+    // Demotion allocates standard memory, which may trigger reclamation.
+    // Our region must not be compacted or evicted from while it's being read.
+    logalloc::reclaim_lock rl(_region);
+    with_allocator(_region.allocator(), [&] {
+        current_tracker = this;
+        while (demoted < max_partitions) {
+            size_t scanned = 0;
+            bool progress = false;
+            _lru.for_each_in_eviction_order([&] (evictable& e) {
+                if (++scanned > demotion_scan_limit) {
+                    return stop_iteration::yes;
+                }
+                // The only evictables in the LRU other than index entries are rows.
+                if (e.is_index()) {
+                    return stop_iteration::no;
+                }
+                progress = try_demote(static_cast<rows_entry&>(e));
+                return stop_iteration(progress);
+            });
+            if (!progress) {
+                break;
+            }
+            ++demoted;
+            if (need_preempt()) {
+                break;
+            }
+        }
+    });
+    return demoted;
+}
+
 void rows_entry::on_evicted(cache_tracker& tracker) noexcept {
     auto it = ::on_evicted_shallow(*this, tracker);
 
@@ -210,6 +210,9 @@ class row_cache final {
         utils::timed_rate_moving_average misses;
         utils::timed_rate_moving_average reads_with_misses;
         utils::timed_rate_moving_average reads_with_no_misses;
+        // Entries populated by reads detected as scans, which were inserted
+        // on probation instead of at the hot end of the LRU.
+        uint64_t scan_probation_insertions = 0;
     };
 private:
     cache_tracker& _tracker;
@@ -296,7 +299,11 @@ class row_cache final {
     // The entry which is returned will have the tombstone applied to it.
     //
     // Must be run under reclaim lock
-    cache_entry& find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous = nullptr);
+    // Moves the partition from the cold tier back into cache, if it's there.
+    void populate_from_cold_tier(const dht::decorated_key&);
+    // If probation is true, a newly created entry is inserted on probation, see cache_tracker::insert_probation().
+    cache_entry& find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous = nullptr,
+                                           bool probation = false);
 
     // Creates (or touches) a cache entry for missing partition so that sstables are not
     // poked again for it.
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2026-present ScyllaDB
+ */
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "serializer.hh"
+#include "schema/schema.hh"
+#include "exceptions/exceptions.hh"
+
+namespace db {
+
+enum class sstable_filter_type {
+    bloom,
+    // A static XOR-family filter (utils::filter::xor_filter), which is
+    // smaller than a Bloom filter of the same false-positive rate.
+    xor_filter,
+};
+
+/**
+ * \brief Schema extension which represents the `sstable_filter` per-table option.
+ *
+ * Selects the kind of partition key filter written to the Filter.db component
+ * of new sstables: 'bloom' (the default) or 'xor'. Sstables keep the filter
+ * they were written with, so changing the option only affects sstables written
+ * (flushed or compacted) afterwards.
+ */
+class sstable_filter_extension : public schema_extension {
+    sstable_filter_type _type = sstable_filter_type::bloom;
+public:
+    static constexpr auto NAME = "sstable_filter";
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    sstable_filter_extension() = default;
+
+    explicit sstable_filter_extension(sstable_filter_type type)
+        : _type(type)
+    {}
+
+    explicit sstable_filter_extension(const std::map<sstring, sstring>& map) {
+        throw exceptions::configuration_exception(format("{} must be one of 'bloom' or 'xor'", NAME));
+    }
+
+    explicit sstable_filter_extension(bytes b) : _type(parse(deserialize(b)))
+    {}
+
+    explicit sstable_filter_extension(const sstring& s) : _type(parse(s))
+    {}
+#pragma clang diagnostic pop
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_sstring(_type));
+    }
+
+    std::string options_to_string() const override {
+        return fmt::format("'{}'", to_sstring(_type));
+    }
+
+    static sstring deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, std::type_identity<sstring>());
+    }
+
+    static sstable_filter_type parse(const sstring& s) {
+        if (s == "bloom") {
+            return sstable_filter_type::bloom;
+        }
+        if (s == "xor") {
+            return sstable_filter_type::xor_filter;
+        }
+        throw exceptions::configuration_exception(format("Invalid {} '{}': must be one of 'bloom' or 'xor'", NAME, s));
+    }
+
+    static sstring to_sstring(sstable_filter_type type) {
+        switch (type) {
+        case sstable_filter_type::bloom: return "bloom";
+        case sstable_filter_type::xor_filter: return "xor";
+        }
+        std::abort();
+    }
+
+    sstable_filter_type get_type() const {
+        return _type;
+    }
+};
+
+} // namespace db
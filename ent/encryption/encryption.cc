@@ -662,6 +662,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
                             sstables::component_type::Partitions,
                             sstables::component_type::Rows,
                             sstables::component_type::TemporaryHashes,
+                            sstables::component_type::RowHashes,
             }) {
                 if (mask & (1 << int(c))) {
                     ccs.emplace_back(c);
@@ -706,6 +707,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
     future<file> wrap_file(const sstables::sstable& sst, sstables::component_type type, file f, open_flags flags) override {
         switch (type) {
         case sstables::component_type::Scylla:
+        case sstables::component_type::TemporaryScylla:
         case sstables::component_type::TemporaryTOC:
         case sstables::component_type::TOC:
             co_return file{};
@@ -816,6 +818,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
     future<data_sink> wrap_sink(const sstables::sstable& sst, sstables::component_type type, data_sink sink) override {
         switch (type) {
         case sstables::component_type::Scylla:
+        case sstables::component_type::TemporaryScylla:
         case sstables::component_type::TemporaryTOC:
         case sstables::component_type::TOC:
             co_return sink;
@@ -831,6 +834,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
         case sstables::component_type::Partitions:
         case sstables::component_type::Rows:
         case sstables::component_type::TemporaryHashes:
+        case sstables::component_type::RowHashes:
         case sstables::component_type::Unknown:
             break;
         }
@@ -845,6 +849,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
                                                          data_source src) override {
         switch (type) {
         case sstables::component_type::Scylla:
+        case sstables::component_type::TemporaryScylla:
         case sstables::component_type::TemporaryTOC:
         case sstables::component_type::TOC:
             co_return src;
@@ -860,6 +865,7 @@ class encryption_file_io_extension : public sstables::file_io_extension {
         case sstables::component_type::Rows:
         case sstables::component_type::Partitions:
         case sstables::component_type::TemporaryHashes:
+        case sstables::component_type::RowHashes:
         case sstables::component_type::Unknown:
             auto [id, esx] = get_encryption_schema_extension(sst, type);
             if (esx) {
@@ -176,6 +176,9 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature rack_list_rf { *this, "RACK_LIST_RF"sv };
     gms::feature driver_service_level { *this, "DRIVER_SERVICE_LEVEL"sv };
     gms::feature strongly_consistent_tables { *this, "STRONGLY_CONSISTENT_TABLES"sv };
+    gms::feature split_block_bloom_filter { *this, "SPLIT_BLOCK_BLOOM_FILTER"sv };
+    gms::feature xor_sstable_filter { *this, "XOR_SSTABLE_FILTER"sv };
+    gms::feature pin_index_caching_option { *this, "PIN_INDEX_CACHING_OPTION"sv };
 public:
 
     const std::unordered_map<sstring, std::reference_wrapper<feature>>& registered_features() const;
@@ -1199,6 +1199,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
+                    .major_token_range_parallelism = cfg->compaction_major_token_range_parallelism,
+                    .scale_backlog_by_cost = cfg->compaction_scale_backlog_by_cost,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source()), std::ref(task_manager)).get();
@@ -1729,13 +1731,19 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             auto tablets_per_shard_goal_observer = cfg->tablets_per_shard_goal.observe(notify_topology);
             auto tablets_initial_scale_factor_observer = cfg->tablets_initial_scale_factor.observe(notify_topology);
 
-            auto compression_dict_updated_callback = [&sstable_compressor_factory] (std::string_view name) -> future<> {
+            auto compression_dict_updated_callback = [&sstable_compressor_factory, &db] (std::string_view name) -> future<> {
                 auto dict = co_await sys_ks.local().query_dict(name);
                 auto sstables_prefix = std::string_view("sstables/");
                 if (name.starts_with(sstables_prefix)) {
                     auto table = table_id(utils::UUID(name.substr(sstables_prefix.size())));
                     co_await sstable_compressor_factory.local().set_recommended_dict(table, std::move(dict.data));
                 } else if (name == dictionary_service::rpc_compression_dict_name) {
+                    // The commitlog compresses with the RPC dictionary too, see commitlog_compression.
+                    co_await db.invoke_on_all([&dict] (replica::database& local_db) {
+                        if (auto* cl = local_db.commitlog()) {
+                            cl->set_compression_dictionary(dict.data);
+                        }
+                    });
                     co_await netw::announce_dict_to_shards(compressor_tracker, std::move(dict));
                 }
             };
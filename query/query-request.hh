@@ -204,6 +204,12 @@ class partition_slice {
         // is a lot of dead rows. This flag is needed during rolling upgrades to support
         // old coordinators which do not tolerate pages with no live rows.
         allow_mutation_read_page_without_live_row,
+        // Set by the replica on data queries which don't populate the row
+        // cache, never sent over the wire. Allows sstable readers to return
+        // cells of columns which are not selected by the slice with empty
+        // values, instead of reading the values from disk. Such cells still
+        // contribute to row liveness, but their values must not be used.
+        skip_unselected_cell_values,
     };
     using option_set = enum_set<super_enum<option,
         option::send_clustering_key,
@@ -219,7 +225,8 @@ class partition_slice {
         option::bypass_cache,
         option::always_return_static_content,
         option::range_scan_data_variant,
-        option::allow_mutation_read_page_without_live_row>>;
+        option::allow_mutation_read_page_without_live_row,
+        option::skip_unselected_cell_values>>;
     clustering_row_ranges _row_ranges;
 public:
     column_id_vector static_columns; // TODO: consider using bitmap
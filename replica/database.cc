@@ -456,6 +456,10 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_admission_filter(_cfg.cache_admission_filter.operator utils::updateable_value<bool>());
+    _row_cache_tracker.set_scan_detection_threshold(_cfg.cache_scan_detection_threshold.operator utils::updateable_value<uint32_t>());
+    _row_cache_tracker.set_cold_tier_fraction(_cfg.cache_cold_tier_fraction.operator utils::updateable_value<double>());
+    _row_cache_tracker.set_index_cache_size_in_mb(_cfg.index_cache_size_in_mb.operator utils::updateable_value<uint32_t>());
 
     setup_scylla_memory_diagnostics_producer();
 }
@@ -1151,6 +1155,10 @@ bool database::update_column_family(schema_ptr new_schema) {
 
 void database::remove(table& cf) noexcept {
     cf.deregister_metrics();
+    cf.get_sstables_manager().forget_partition_index_cache_stats(cf.schema()->id());
+    cf.get_sstables_manager().forget_index_file_cache_stats(cf.schema()->id());
+    cf.get_sstables_manager().forget_data_readahead_stats(cf.schema()->id());
+    _compaction_manager.forget_cost_model(cf.schema()->id());
     _tables_metadata.remove_table(*this, cf);
 }
 
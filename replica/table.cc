@@ -1791,7 +1791,53 @@ void table::set_metrics() {
                 ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
                 ms::make_gauge("pending_sstable_deletions",
                         ms::description("Number of tasks waiting to delete sstables from a table"),
-                        [this] { return _stats.pending_sstable_deletions; })(cf)(ks)
+                        [this] { return _stats.pending_sstable_deletions; })(cf)(ks),
+                ms::make_counter("cache_scan_probation_insertions",
+                        ms::description("Number of rows and partitions populated into cache by scans which were inserted on probation, instead of at the hot end of the LRU"),
+                        [this] { return _cache.stats().scan_probation_insertions; })(cf)(ks).set_skip_when_empty()
+        });
+
+        auto index_cache_stats = get_sstables_manager().get_partition_index_cache_stats(_schema->id());
+        _metrics.add_group("column_family", {
+                ms::make_counter("index_page_hits", ms::description("Requests of parsed Index.db pages of this table's sstables which could be satisfied without waiting"),
+                        [index_cache_stats] { return index_cache_stats->hits; })(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("index_page_misses", ms::description("Requests of parsed Index.db pages of this table's sstables which initiated a read from disk"),
+                        [index_cache_stats] { return index_cache_stats->misses; })(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("index_page_evictions", ms::description("Parsed Index.db pages of this table's sstables which got evicted from memory"),
+                        [index_cache_stats] { return index_cache_stats->evictions; })(cf)(ks).set_skip_when_empty(),
+                ms::make_gauge("index_page_used_bytes", ms::description("Amount of bytes used by parsed Index.db pages of this table's sstables in memory"),
+                        [index_cache_stats] { return index_cache_stats->used_bytes; })(cf)(ks),
+        });
+
+        auto index_file_cache_stats = get_sstables_manager().get_index_file_cache_stats(_schema->id());
+        _metrics.add_group("column_family", {
+                ms::make_counter("index_file_page_hits", ms::description("Reads of cached index file pages (Index.db, Partitions.db, Rows.db, RowHashes.db) of this table's sstables"),
+                        [index_file_cache_stats] { return index_file_cache_stats->page_hits; })(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("index_file_page_misses", ms::description("Reads of index file pages of this table's sstables which were not cached"),
+                        [index_file_cache_stats] { return index_file_cache_stats->page_misses; })(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("index_file_page_evictions", ms::description("Index file pages of this table's sstables which got evicted from memory"),
+                        [index_file_cache_stats] { return index_file_cache_stats->page_evictions; })(cf)(ks).set_skip_when_empty(),
+                ms::make_gauge("index_file_page_cached_bytes", ms::description("Amount of bytes used by cached index file pages of this table's sstables"),
+                        [index_file_cache_stats] { return index_file_cache_stats->cached_bytes; })(cf)(ks),
+        });
+
+        auto readahead_stats = get_sstables_manager().get_data_readahead_stats(_schema->id());
+        _metrics.add_group("column_family", {
+                ms::make_counter("data_readahead_bytes_read", ms::description("Bytes read from the data files of this table's sstables by sstable readers"),
+                        [readahead_stats] { return readahead_stats->bytes_read; })(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("data_readahead_bytes_wasted", ms::description("Bytes read ahead from the data files of this table's sstables which the readers didn't consume"),
+                        [readahead_stats] { return readahead_stats->bytes_wasted; })(cf)(ks).set_skip_when_empty(),
+        });
+
+        auto cost_model = _compaction_manager.get_cost_model(_schema->id());
+        _metrics.add_group("column_family", {
+                ms::make_gauge("compaction_cpu_seconds_per_byte", ms::description("Moving average of the CPU time spent by compactions of this table per byte read"),
+                        [cost_model] { return cost_model->cpu_seconds_per_byte(); })(cf)(ks),
+                ms::make_gauge("compaction_io_bytes_per_byte", ms::description("Moving average of the bytes read and written by compactions of this table per byte read"),
+                        [cost_model] { return cost_model->io_bytes_per_byte(); })(cf)(ks),
+                ms::make_gauge("compaction_cost_factor", ms::description("Estimated cost of compacting a byte of this table, relative to a reference table compacting at 64MB/s. "
+                        "With compaction_scale_backlog_by_cost, the backlog of the table is scaled by this factor divided by the mean factor of the tables of the shard"),
+                        [cost_model] { return cost_model->cost_factor(); })(cf)(ks),
         });
 
         // Metrics related to row locking
@@ -3926,7 +3972,13 @@ table::query(schema_ptr query_schema,
 
         if (!querier_opt) {
             querier_base::querier_config conf(_config.tombstone_warn_threshold);
-            querier_opt = querier(as_mutation_source(), query_schema, permit, range, qs.cmd.slice, trace_state, get_compaction_manager().get_tombstone_gc_state(), conf);
+            auto slice = qs.cmd.slice;
+            // Only the selected columns make it to the result. The values of the
+            // other ones can be skipped, unless the read populates the cache.
+            if (!cache_enabled() || slice.options.contains<query::partition_slice::option::bypass_cache>()) {
+                slice.options.set<query::partition_slice::option::skip_unselected_cell_values>();
+            }
+            querier_opt = querier(as_mutation_source(), query_schema, permit, range, std::move(slice), trace_state, get_compaction_manager().get_tombstone_gc_state(), conf);
         }
         auto& q = *querier_opt;
 
@@ -4283,7 +4335,7 @@ compaction::compaction_backlog_tracker& compaction_group::get_backlog_tracker()
 
 void compaction_group::register_backlog_tracker(compaction::compaction_backlog_tracker new_backlog_tracker) {
     _backlog_tracker.emplace(std::move(new_backlog_tracker));
-    get_compaction_manager().register_backlog_tracker(*_backlog_tracker);
+    get_compaction_manager().register_backlog_tracker(*_backlog_tracker, _t.schema()->id());
 }
 
 compaction::compaction_manager& compaction_group::get_compaction_manager() noexcept {
@@ -12,8 +12,8 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, bool pin_index)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _pin_index(pin_index) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
@@ -40,6 +40,9 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_pin_index) {
+        res.insert({"pin_index", "true"});
+    }
     return res;
 }
 
@@ -58,6 +61,7 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    bool pin_index = false;
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +70,13 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "pin_index") {
+            pin_index = p.second == "true";
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, pin_index);
 }
 
 caching_options
@@ -25,7 +25,11 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // Keep the whole partition index of each sstable in memory, out of reach
+    // of cache eviction, see sstable::maybe_pin_index(). Decided when the
+    // sstable is opened, so changing the option doesn't affect open sstables.
+    bool _pin_index = false;
+    caching_options(sstring k, sstring r, bool enabled, bool pin_index = false);
 
     friend class schema;
     caching_options();
@@ -34,6 +38,10 @@ class caching_options {
         return _enabled;
     }
 
+    bool pin_index() const {
+        return _pin_index;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
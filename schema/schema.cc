@@ -32,6 +32,7 @@
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/sstable_filter_extension.hh"
 #include "db/tags/utils.hh"
 #include "db/tags/extension.hh"
 #include "index/target_parser.hh"
@@ -1688,6 +1689,15 @@ const ::tombstone_gc_options& schema::tombstone_gc_options() const {
     return default_tombstone_gc_options;
 }
 
+db::sstable_filter_type schema::sstable_filter() const {
+    const auto& schema_extensions = _raw._extensions;
+
+    if (auto it = schema_extensions.find(db::sstable_filter_extension::NAME); it != schema_extensions.end()) {
+        return dynamic_pointer_cast<db::sstable_filter_extension>(it->second)->get_type();
+    }
+    return db::sstable_filter_type::bloom;
+}
+
 bool schema::has_tablet_options() const noexcept {
     return _raw._tablet_options.has_value();
 }
@@ -1719,6 +1729,11 @@ schema_builder& schema_builder::with_per_partition_rate_limit_options(const db::
     return *this;
 }
 
+schema_builder& schema_builder::with_sstable_filter(db::sstable_filter_type type) {
+    add_extension(db::sstable_filter_extension::NAME, ::make_shared<db::sstable_filter_extension>(type));
+    return *this;
+}
+
 schema_builder& schema_builder::set_paxos_grace_seconds(int32_t seconds) {
     add_extension(db::paxos_grace_seconds_extension::NAME, ::make_shared<db::paxos_grace_seconds_extension>(seconds));
     return *this;
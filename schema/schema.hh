@@ -123,6 +123,7 @@ void read_collections(schema_builder& builder, sstring comparator);
 
 namespace db {
 class extensions;
+enum class sstable_filter_type;
 }
 // make sure these match the order we like columns back from schema
 enum class column_kind { partition_key, clustering_key, static_column, regular_column };
@@ -749,6 +750,9 @@ class schema final : public enable_lw_shared_from_this<schema> {
 
     const ::tombstone_gc_options& tombstone_gc_options() const;
 
+    // The kind of filter to write for new sstables, see db::sstable_filter_extension.
+    db::sstable_filter_type sstable_filter() const;
+
     const db::per_partition_rate_limit_options& per_partition_rate_limit_options() const {
         return _raw._per_partition_rate_limit_options;
     }
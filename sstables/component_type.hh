@@ -30,6 +30,8 @@ enum class component_type {
     Rows,
     Partitions,
     TemporaryHashes,
+    RowHashes,
+    TemporaryScylla,
     Unknown,
 };
 
@@ -82,6 +84,10 @@ struct fmt::formatter<sstables::component_type> : fmt::formatter<string_view> {
             return formatter<string_view>::format("Rows", ctx);
         case TemporaryHashes:
             return formatter<string_view>::format("TemporaryHashes", ctx);
+        case RowHashes:
+            return formatter<string_view>::format("RowHashes", ctx);
+        case TemporaryScylla:
+            return formatter<string_view>::format("TemporaryScylla", ctx);
         case Unknown:
             return formatter<string_view>::format("Unknown", ctx);
         }
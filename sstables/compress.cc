@@ -13,6 +13,7 @@
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/later.hh>
 #include <seastar/core/on_internal_error.hh>
 
 #include "compress.hh"
@@ -314,6 +315,12 @@ class compressed_file_data_source_impl : public data_source_impl {
     uint64_t _pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+    // Reads spanning at least this many chunks decompress the next chunk in
+    // the background, while the consumer parses the current one.
+    static constexpr uint64_t decompress_ahead_min_chunks = 4;
+    bool _decompress_ahead = false;
+    // The chunk following the one last returned, which ends at _pos.
+    std::optional<future<temporary_buffer<char>>> _ahead;
 public:
     compressed_file_data_source_impl(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options,
@@ -357,12 +364,29 @@ class compressed_file_data_source_impl : public data_source_impl {
             return stream_creator(start, length, std::move(options));
         };
         _underlying_pos = start.chunk_start;
+        _decompress_ahead = _end_pos - _beg_pos >= decompress_ahead_min_chunks * _compression_metadata->uncompressed_chunk_length();
     }
-    virtual future<temporary_buffer<char>> get() override {
-        if (_pos >= _end_pos) {
-            co_return temporary_buffer<char>();
+private:
+    future<temporary_buffer<char>> read_ahead() {
+        // Let the consumer get to the chunk we just returned first.
+        co_await seastar::yield();
+        co_return co_await read_chunk();
+    }
+
+    // Starts reading the chunk at _pos in the background, if the read is long enough.
+    void maybe_read_ahead() {
+        if (_decompress_ahead && _pos < _end_pos) {
+            _ahead = read_ahead();
         }
+    }
+
+    future<temporary_buffer<char>> take_ahead() {
+        auto f = std::move(*_ahead);
+        _ahead.reset();
+        return f;
+    }
 
+    future<temporary_buffer<char>> read_chunk() {
         if (!_input_stream) {
             _input_stream = co_await _stream_creator();
         }
@@ -425,12 +449,27 @@ class compressed_file_data_source_impl : public data_source_impl {
         }
         co_return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
     }
+public:
+    virtual future<temporary_buffer<char>> get() override {
+        temporary_buffer<char> buf;
+        if (_ahead) {
+            buf = co_await take_ahead();
+        } else if (_pos < _end_pos) {
+            buf = co_await read_chunk();
+        } else {
+            co_return temporary_buffer<char>();
+        }
+        maybe_read_ahead();
+        co_return buf;
+    }
 
     virtual future<> close() override {
-        if (!_input_stream) {
-            return make_ready_future<>();
+        if (_ahead) {
+            co_await take_ahead().discard_result().handle_exception([] (std::exception_ptr) {});
+        }
+        if (_input_stream) {
+            co_await _input_stream->close();
         }
-        return _input_stream->close();
     }
 
     virtual future<temporary_buffer<char>> skip(uint64_t n) override {
@@ -440,6 +479,16 @@ class compressed_file_data_source_impl : public data_source_impl {
                 _digests.can_calculate_digest = false;
             }
         }
+        if (_ahead) {
+            // Skip into or over the chunk read ahead, which starts where the consumer is.
+            auto buf = co_await take_ahead();
+            if (n < buf.size()) {
+                buf.trim_front(n);
+                maybe_read_ahead();
+                co_return buf;
+            }
+            n -= buf.size();
+        }
         if (_pos + n > _end_pos) {
             on_internal_error(sstables::sstlog, format("Skipping over the end position is disallowed: current pos={}, end pos={}, skip len={}", _pos, _end_pos, n));
         }
@@ -455,6 +504,8 @@ class compressed_file_data_source_impl : public data_source_impl {
             _input_stream = co_await _stream_creator();
         }
         co_await _input_stream->skip(underlying_n);
+        // Don't let the reads following the skip wait for the chunk.
+        maybe_read_ahead();
         co_return temporary_buffer<char>();
     }
 };
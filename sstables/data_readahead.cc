@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "data_readahead.hh"
+#include "reader_concurrency_semaphore.hh"
+
+namespace sstables {
+
+namespace {
+
+class readahead_counting_file_impl : public file_impl {
+    file _file;
+    lw_shared_ptr<uint64_t> _bytes_read;
+public:
+    readahead_counting_file_impl(file f, lw_shared_ptr<uint64_t> bytes_read)
+        : file_impl(*get_file_impl(f))
+        , _file(std::move(f))
+        , _bytes_read(std::move(bytes_read))
+    { }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, intent);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, intent).then([bytes_read = _bytes_read] (size_t size) {
+            *bytes_read += size;
+            return size;
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->read_dma(pos, std::move(iov), intent).then([bytes_read = _bytes_read] (size_t size) {
+            *bytes_read += size;
+            return size;
+        });
+    }
+
+    virtual future<> flush() override {
+        return get_file_impl(_file)->flush();
+    }
+
+    virtual future<struct stat> stat() override {
+        return get_file_impl(_file)->stat();
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    virtual future<uint64_t> size() override {
+        return get_file_impl(_file)->size();
+    }
+
+    virtual future<> close() override {
+        return get_file_impl(_file)->close();
+    }
+
+    virtual std::unique_ptr<file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
+        return get_file_impl(_file)->dma_read_bulk(offset, range_size, intent).then([bytes_read = _bytes_read] (temporary_buffer<uint8_t> buf) {
+            *bytes_read += buf.size();
+            return buf;
+        });
+    }
+};
+
+} // anonymous namespace
+
+file_input_stream_options data_readahead_controller::stream_options(size_t buffer_size, const reader_permit& permit) const {
+    file_input_stream_options options;
+    options.buffer_size = buffer_size;
+    options.dynamic_adjustments = _history;
+
+    // Don't let the window of one reader take more than a quarter of the memory
+    // left for reads, but always allow double buffering.
+    auto available = std::max<ssize_t>(permit.semaphore().available_resources().memory, 0) / 4;
+    auto window_buffers = std::max<size_t>(available / buffer_size, 2);
+    options.read_ahead = std::min<size_t>(_max_read_ahead, window_buffers - 1);
+    return options;
+}
+
+file data_readahead_controller::wrap_file(file f) const {
+    return file(make_shared<readahead_counting_file_impl>(std::move(f), _bytes_read));
+}
+
+void data_readahead_controller::on_skip(uint64_t from, uint64_t to) noexcept {
+    if (_consume_start) {
+        _bytes_consumed += from - *_consume_start;
+    }
+    _consume_start = to;
+}
+
+void data_readahead_controller::on_close(uint64_t pos, double ondisk_ratio, data_readahead_stats& stats) noexcept {
+    if (_consume_start) {
+        _bytes_consumed += pos - *_consume_start;
+        _consume_start.reset();
+    }
+    // Compressed chunks are read whole, so this is only an estimate
+    // of the consumed bytes of compressed sstables.
+    auto consumed_ondisk = uint64_t(_bytes_consumed * ondisk_ratio);
+    stats.bytes_read += *_bytes_read;
+    stats.bytes_wasted += *_bytes_read - std::min(*_bytes_read, consumed_ondisk);
+    *_bytes_read = 0;
+    _bytes_consumed = 0;
+}
+
+} // namespace sstables
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "reader_permit.hh"
+#include "seastarx.hh"
+
+namespace sstables {
+
+// Data file readahead statistics of the sstable readers of a table.
+struct data_readahead_stats {
+    // Bytes read from disk for the Data component.
+    uint64_t bytes_read = 0;
+    // Part of bytes_read which the readers didn't consume: read ahead
+    // past the end of the read, or past a position the reader skipped to.
+    uint64_t bytes_wasted = 0;
+};
+
+// Controls the readahead of the Data file stream of a single sstable reader.
+//
+// The stream gets an input stream history of its own, rather than one shared
+// by all readers of the sstable. So it starts with small buffers and a single
+// read ahead, grows the buffers while the reader consumes them sequentially,
+// adds read ahead while the reader waits for I/O, and falls back to small
+// buffers after a fast-forward. Point reads don't inherit the windows grown
+// by scans of the same sstable, and scans can have more I/O outstanding than
+// point reads.
+//
+// The readahead window is bounded by the memory available to reads in the
+// permit's semaphore.
+//
+// The controller also accounts for the bytes read from disk which the reader
+// didn't consume, see data_readahead_stats.
+class data_readahead_controller {
+public:
+    // Upper bound on the number of read-ahead buffers of scans.
+    static constexpr unsigned max_scan_read_ahead = 8;
+    // Upper bound on the number of read-ahead buffers of single partition reads.
+    static constexpr unsigned max_single_partition_read_ahead = 1;
+private:
+    unsigned _max_read_ahead;
+    lw_shared_ptr<file_input_stream_history> _history = make_lw_shared<file_input_stream_history>();
+    // Updated by the files returned from wrap_file(), which may outlive the controller.
+    lw_shared_ptr<uint64_t> _bytes_read = make_lw_shared<uint64_t>(0);
+    uint64_t _bytes_consumed = 0;
+    // Position at which the reader started consuming the stream after the last skip.
+    std::optional<uint64_t> _consume_start;
+public:
+    explicit data_readahead_controller(bool single_partition_read) noexcept
+        : _max_read_ahead(single_partition_read ? max_single_partition_read_ahead : max_scan_read_ahead)
+    { }
+
+    // Returns options for a Data file stream of the reader.
+    file_input_stream_options stream_options(size_t buffer_size, const reader_permit& permit) const;
+
+    // Returns a file which counts the bytes read from f.
+    file wrap_file(file f) const;
+
+    // Called when the reader starts consuming the stream at pos.
+    void on_start(uint64_t pos) noexcept {
+        _consume_start = pos;
+    }
+    // Called when the reader skips from position from to position to.
+    void on_skip(uint64_t from, uint64_t to) noexcept;
+
+    // Called when the reader is done, at position pos. Accounts the bytes read
+    // by the reader to stats. ondisk_ratio is the ratio of the on-disk size of
+    // the Data component to its uncompressed size.
+    void on_close(uint64_t pos, double ondisk_ratio, data_readahead_stats& stats) noexcept;
+};
+
+} // namespace sstables
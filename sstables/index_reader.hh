@@ -19,6 +19,7 @@
 #include "sstables/mx/bsearch_clustered_cursor.hh"
 #include "sstables/sstables_manager.hh"
 #include "abstract_index_reader.hh"
+#include "sstables/row_hash_index.hh"
 
 namespace sstables {
 
@@ -446,6 +447,10 @@ class index_reader final : public abstract_index_reader {
     logalloc::region& _region;
     use_caching _use_caching;
     bool _single_page_read;
+    // Full clustering key of the only row read by a single row read.
+    std::optional<clustering_key_prefix> _single_row;
+    // Offset in partition of _single_row, as found in the row hash index.
+    std::optional<uint64_t> _single_row_offset;
     abort_source _abort;
 
     future<std::unique_ptr<index_consume_entry_context<index_consumer>>> make_context(uint64_t begin, uint64_t end, index_consumer& consumer) {
@@ -702,6 +707,27 @@ class index_reader final : public abstract_index_reader {
         });
     }
 
+    // Looks up the row of a single row read in the row hash index.
+    // Returns true if the row hash index covers the current partition,
+    // in which case _single_row_offset is the position to read the row from.
+    // Otherwise, resets _single_row, so that the promoted index is used.
+    //
+    // Must be called only when _single_row is engaged, after advancing
+    // to the partition of the read and !eof().
+    future<bool> find_single_row() {
+        if (!_single_row_offset) {
+            co_await read_partition_data();
+            auto e_pos = current_partition_entry().position();
+            _single_row_offset = co_await _sstable->_row_hash_index->find_row(e_pos, *_single_row, _permit);
+            sstlog.trace("index {}: row hash index lookup: {}", fmt::ptr(this), _single_row_offset);
+            if (!_single_row_offset) {
+                _single_row.reset();
+                co_return false;
+            }
+        }
+        co_return true;
+    }
+
 public:
     // Forwards the upper bound cursor to a position which is greater than given position in current partition.
     //
@@ -715,6 +741,20 @@ class index_reader final : public abstract_index_reader {
     future<> advance_upper_past(position_in_partition_view pos) override {
         sstlog.trace("index {}: advance_upper_past({})", fmt::ptr(this), pos);
 
+        if (_single_row) {
+            return find_single_row().then([this, pos] (bool found) {
+                if (!found) {
+                    return advance_upper_past(pos);
+                }
+                // Don't read the promoted index just to narrow down the data file range,
+                // the read ends at the row anyway.
+                if (!_upper_bound) {
+                    _upper_bound = _lower_bound;
+                }
+                return advance_to_next_partition(*_upper_bound);
+            });
+        }
+
         // We advance cursor within the current lower bound partition
         // So need to make sure first that it is read
         if (!partition_data_ready(_lower_bound)) {
@@ -776,7 +816,8 @@ class index_reader final : public abstract_index_reader {
     index_reader(shared_sstable sst, reader_permit permit,
                  tracing::trace_state_ptr trace_state = {},
                  use_caching caching = use_caching::yes,
-                 bool single_partition_read = false)
+                 bool single_partition_read = false,
+                 std::optional<clustering_key_prefix> single_row = {})
         : _sstable(std::move(sst))
         , _permit(std::move(permit))
         , _trace_state(std::move(trace_state))
@@ -788,6 +829,7 @@ class index_reader final : public abstract_index_reader {
         , _region(_sstable->manager().get_cache_tracker().region())
         , _use_caching(caching)
         , _single_page_read(single_partition_read) // all entries for a given partition are within a single page
+        , _single_row(_sstable->_row_hash_index ? std::move(single_row) : std::nullopt)
     {
         if (sstlog.is_enabled(logging::log_level::trace)) {
             sstlog.trace("index {}: index_reader for {}", fmt::ptr(this), _sstable->get_filename());
@@ -894,6 +936,11 @@ class index_reader final : public abstract_index_reader {
     // Must be called only after advanced to some partition and !eof().
     // Must be called for non-decreasing positions.
     future<> prefetch_lower_bound(position_in_partition_view pos) override {
+        if (_single_row) {
+            return find_single_row().then([this, pos] (bool found) {
+                return found ? make_ready_future<>() : prefetch_lower_bound(pos);
+            });
+        }
         clustered_index_cursor *cur = current_clustered_cursor();
         if (cur) {
             return cur->advance_to(pos).discard_result();
@@ -926,6 +973,23 @@ class index_reader final : public abstract_index_reader {
             });
         }
 
+        if (_single_row) {
+            return find_single_row().then([this, pos] (bool found) {
+                if (found && position_in_partition::equal_compare(*_sstable->_schema)(pos, position_in_partition_view::before_key(*_single_row))) {
+                    // Partitions with range tombstones are not in the row hash index,
+                    // so there is no active tombstone.
+                    _lower_bound.end_open_marker.reset();
+                    _lower_bound.data_file_position = current_partition_entry().position() + *_single_row_offset;
+                    _lower_bound.element = indexable_element::cell;
+                    sstlog.trace("index {}: skipped to cell using row hash index, _data_file_position={}", fmt::ptr(this), _lower_bound.data_file_position);
+                    _single_row.reset();
+                    return make_ready_future<>();
+                }
+                _single_row.reset();
+                return advance_to(pos);
+            });
+        }
+
         index_entry& e = current_partition_entry();
         auto e_pos = e.position();
         clustered_index_cursor* cur = current_clustered_cursor(_lower_bound);
@@ -19,11 +19,16 @@
 #include "db/commitlog/replay_position.hh"
 #include "mutation/position_in_partition.hh"
 #include "locator/host_id.hh"
+#include "dht/token.hh"
+
+#include <array>
+#include <bit>
 
 
 namespace sstables {
 
 static constexpr int TOMBSTONE_HISTOGRAM_BIN_SIZE = 100;
+static constexpr int TOKEN_RANGE_TOMBSTONE_HISTOGRAM_BIN_SIZE = 16;
 
 /**
  * ColumnStats holds information about the columns for one partition inside sstable
@@ -148,6 +153,18 @@ class metadata_collector {
     uint64_t _columns_count = 0;
     uint64_t _rows_count = 0;
 
+    struct token_range_tombstone_stats {
+        // Tokens of the first and last partitions of the range.
+        std::optional<dht::token> first_token;
+        dht::token last_token;
+        // Tokens of the first and last partitions of the range with tombstones.
+        std::optional<dht::token> first_tombstone_token;
+        dht::token last_tombstone_token;
+        uint64_t cells_count = 0;
+        utils::streaming_histogram histogram{TOKEN_RANGE_TOMBSTONE_HISTOGRAM_BIN_SIZE};
+    };
+    std::array<token_range_tombstone_stats, tombstone_histogram_token_ranges> _token_range_tombstone_stats;
+
     /**
      * Default cardinality estimation method is to use HyperLogLog++.
      * Parameter here(p=13, sp=25) should give reasonable estimation
@@ -219,7 +236,8 @@ class metadata_collector {
     // pos must be in the clustered region
     void update_min_max_components(position_in_partition_view pos);
 
-    void update(column_stats&& stats) {
+    void update(const dht::token& token, column_stats&& stats) {
+        update_token_range_tombstone_stats(token, stats);
         _timestamp_tracker.update(stats.timestamp_tracker);
         _min_live_timestamp_tracker.update(stats.min_live_timestamp_tracker);
         _min_live_row_marker_timestamp_tracker.update(stats.min_live_row_marker_timestamp_tracker);
@@ -233,6 +251,24 @@ class metadata_collector {
         _rows_count += stats.rows_count;
     }
 
+    void update_token_range_tombstone_stats(const dht::token& token, column_stats& stats) {
+        static_assert(std::has_single_bit(tombstone_histogram_token_ranges));
+        auto& range_stats = _token_range_tombstone_stats[token.unbias() >> (64 - std::countr_zero(tombstone_histogram_token_ranges))];
+        range_stats.cells_count += stats.cells_count;
+        if (!range_stats.first_token) {
+            range_stats.first_token = token;
+        }
+        range_stats.last_token = token;
+        if (stats.tombstone_histogram.bin.empty()) {
+            return;
+        }
+        if (!range_stats.first_tombstone_token) {
+            range_stats.first_tombstone_token = token;
+        }
+        range_stats.last_tombstone_token = token;
+        range_stats.histogram.merge(stats.tombstone_histogram);
+    }
+
     void construct_compaction(compaction_metadata& m) {
         auto cardinality = _cardinality.get_bytes();
         m.cardinality.elements = utils::chunked_vector<uint8_t>(cardinality.get(), cardinality.get() + cardinality.size());
@@ -260,6 +296,28 @@ class metadata_collector {
         m.originating_host_id = _host_id;
     }
 
+    scylla_metadata::tombstone_histograms get_tombstone_histograms() {
+        scylla_metadata::tombstone_histograms histograms;
+        for (uint32_t i = 0; i < _token_range_tombstone_stats.size(); ++i) {
+            auto& range_stats = _token_range_tombstone_stats[i];
+            if (!range_stats.first_token) {
+                continue;
+            }
+            bool has_tombstones = bool(range_stats.first_tombstone_token);
+            token_range_tombstone_histogram h{
+                .token_range = i,
+                .first_token = (has_tombstones ? *range_stats.first_tombstone_token : *range_stats.first_token).raw(),
+                .last_token = (has_tombstones ? range_stats.last_tombstone_token : range_stats.last_token).raw(),
+                .cells_count = range_stats.cells_count,
+            };
+            for (auto [deletion_time, count] : range_stats.histogram.bin) {
+                h.histogram.elements.push_back(tombstone_histogram_bin{deletion_time, count});
+            }
+            histograms.elements.push_back(std::move(h));
+        }
+        return histograms;
+    }
+
     scylla_metadata::ext_timestamp_stats::map_type get_ext_timestamp_stats() {
         return scylla_metadata::ext_timestamp_stats::map_type{
             { ext_timestamp_stats_type::min_live_timestamp, _min_live_timestamp_tracker.get() },
@@ -69,6 +69,12 @@ class mp_row_consumer_m {
     static_row _in_progress_static_row;
     bool _inside_static_row = false;
 
+    // Columns whose cell values are needed, indexed by column id. Disengaged
+    // when values of all columns are needed, see
+    // query::partition_slice::option::skip_unselected_cell_values.
+    std::optional<boost::dynamic_bitset<uint64_t>> _static_columns_with_values;
+    std::optional<boost::dynamic_bitset<uint64_t>> _regular_columns_with_values;
+
     struct cell {
         column_id id;
         atomic_cell_or_collection val;
@@ -204,6 +210,17 @@ class mp_row_consumer_m {
             && (!sst->has_scylla_component() || sst->features().is_enabled(sstable_feature::CorrectStaticCompact))) // See #4139
     {
         _cells.reserve(std::max(_schema->static_columns_count(), _schema->regular_columns_count()));
+        if (_slice.options.contains<query::partition_slice::option::skip_unselected_cell_values>()) {
+            auto make_column_set = [] (size_t count, const query::column_id_vector& selected) {
+                boost::dynamic_bitset<uint64_t> columns(count);
+                for (auto id : selected) {
+                    columns.set(id);
+                }
+                return columns;
+            };
+            _static_columns_with_values = make_column_set(_schema->static_columns_count(), _slice.static_columns);
+            _regular_columns_with_values = make_column_set(_schema->regular_columns_count(), _slice.regular_columns);
+        }
     }
 
     mp_row_consumer_m(mp_row_consumer_reader_mx* reader,
@@ -217,6 +234,22 @@ class mp_row_consumer_m {
 
     ~mp_row_consumer_m() {}
 
+    // Whether the parser has to read the values of cells of the given column.
+    // When it doesn't, it passes empty values to consume_column() instead.
+    // The cells still carry their timestamp, TTL and deletion info, so that
+    // they keep contributing to row liveness.
+    bool needs_cell_values(const column_translation::column_info& column_info, bool is_static) const {
+        if (!column_info.id) {
+            // Dropped column, its cells are ignored.
+            return false;
+        }
+        if (!_regular_columns_with_values || column_info.is_counter) {
+            return true;
+        }
+        const auto& columns = is_static && !_treat_static_row_as_regular ? *_static_columns_with_values : *_regular_columns_with_values;
+        return *column_info.id >= columns.size() || columns.test(*column_info.id);
+    }
+
     // See the RowConsumer concept
     void push_ready_fragments() {
         if (auto rto = std::move(_stored_tombstone)) {
@@ -677,6 +710,7 @@ requires requires(
     { c.consume_complex_column_start(column_info, tomb) } -> std::same_as<data_consumer::proceed>;
     { c.consume_complex_column_end(column_info) } -> std::same_as<data_consumer::proceed>;
     { c.consume_counter_column(column_info, value, timestamp) } -> std::same_as<data_consumer::proceed>;
+    { c.needs_cell_values(column_info, is_deleted) } -> std::same_as<bool>;
     { c.consume_range_tombstone(ck_view, kind, tomb) } -> std::same_as<data_consumer::proceed>;
     { c.consume_range_tombstone(ck_view, kind_m, tomb, tomb) } -> std::same_as<data_consumer::proceed>;
     { c.consume_row_end() } -> std::same_as<data_consumer::proceed>;
@@ -724,6 +758,9 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
 
         // Represents the subset of _all_columns present in current row
         boost::dynamic_bitset<uint64_t> _columns_selector; // size() == _columns.size()
+
+        // Subset of _all_columns whose cell values are skipped, see Consumer::needs_cell_values()
+        boost::dynamic_bitset<uint64_t> _skipped_values;
     };
 
     row_schema _regular_row;
@@ -768,9 +805,15 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         _row = &rs;
         _row->_columns = _row->_all_columns;
     }
-    void setup_columns(row_schema& rs, const std::vector<column_translation::column_info>& columns) {
+    void setup_columns(row_schema& rs, const std::vector<column_translation::column_info>& columns, bool is_static) {
         rs._all_columns = std::ranges::subrange(columns);
         rs._columns_selector = boost::dynamic_bitset<uint64_t>(columns.size());
+        rs._skipped_values = boost::dynamic_bitset<uint64_t>(columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (!_consumer.needs_cell_values(columns[i], is_static)) {
+                rs._skipped_values.set(i);
+            }
+        }
     }
     void skip_absent_columns() {
         size_t pos = _row->_columns_selector.find_first();
@@ -795,6 +838,9 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     std::optional<uint32_t> get_column_value_length() const {
         return _row->_columns.front().value_length;
     }
+    bool is_column_value_skipped() const {
+        return _row->_skipped_values.test(_row->_all_columns.size() - _row->_columns.size());
+    }
     void setup_ck(const std::vector<std::optional<uint32_t>>& column_value_fix_lengths) {
         _row_key.clear();
         _row_key.reserve(column_value_fix_lengths.size());
@@ -1103,6 +1149,17 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             }
             if (!_column_flags.has_value()) {
                 _column_value = fragmented_temporary_buffer();
+            } else if (is_column_value_skipped()) {
+                _column_value = fragmented_temporary_buffer();
+                if (auto len = get_column_value_length()) {
+                    this->_u64 = *len;
+                } else {
+                    co_yield this->read_unsigned_vint(*_processing_data);
+                }
+                auto maybe_skip_bytes = this->skip(*_processing_data, this->_u64);
+                if (std::holds_alternative<skip_bytes>(maybe_skip_bytes)) {
+                    co_yield maybe_skip_bytes;
+                }
             } else {
                 read_status status = read_status::waiting;
                 if (auto len = get_column_value_length()) {
@@ -1201,8 +1258,8 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         , _has_shadowable_tombstones(sst->has_shadowable_tombstones())
         , _gen(do_process_state())
     {
-        setup_columns(_regular_row, _column_translation.regular_columns());
-        setup_columns(_static_row, _column_translation.static_columns());
+        setup_columns(_regular_row, _column_translation.regular_columns(), false);
+        setup_columns(_static_row, _column_translation.static_columns(), true);
     }
 
     void verify_end_state() {
@@ -1273,6 +1330,8 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     read_monitor& _monitor;
     integrity_check _integrity;
     lw_shared_ptr<checksum> _checksum;
+    // Not used by reversed reads, which read the data file through partition_reversing_data_source.
+    data_readahead_controller _readahead;
 
     // For reversed (single partition) reads, points to the current position in the sstable
     // of the reversing data source used underneath (see `partition_reversing_data_source`).
@@ -1308,7 +1367,8 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             , _fwd(fwd)
             , _fwd_mr(fwd_mr)
             , _monitor(mon)
-            , _integrity(integrity) {
+            , _integrity(integrity)
+            , _readahead(_single_partition_read) {
         sstlog.trace("mx_sstable_mutation_reader {}: init with _pr={}", fmt::ptr(this), _pr.get());
         if (reversed()) {
             if (!_single_partition_read) {
@@ -1593,13 +1653,15 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                 _context = std::move(reversed_context.the_context);
                 _reversed_read_sstable_position = &reversed_context.current_position_in_sstable;
             } else {
-                _context = co_await data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end }, _integrity);
+                _context = co_await data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end }, _integrity, &_readahead);
+                _readahead.on_start(begin);
             }
         } else {
             sstable::disk_read_range drr{begin, *end};
             auto last_end = _fwd_mr ? _sst->data_size() : drr.end;
             _read_enabled = bool(drr);
-            _context = co_await data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end, _integrity);
+            _context = co_await data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end, _integrity, &_readahead);
+            _readahead.on_start(begin);
         }
 
         _monitor.on_read_started(_context->reader_position());
@@ -1611,6 +1673,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         if (begin <= _context->position()) {
             return make_ready_future<>();
         }
+        _readahead.on_skip(_context->position(), begin);
         _context->reset(el);
         return _context->skip_to(begin);
     }
@@ -1700,6 +1763,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                             return advance_index_until_unseen_partition().then([this] {
                                 auto [start, end] = _index_reader->data_file_positions();
                                 _read_enabled = true;
+                                _readahead.on_skip(_context->position(), start);
                                 _context->reset(indexable_element::partition);
                                 return _context->fast_forward_to(start, *end);
                             });
@@ -1709,6 +1773,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                         _read_enabled = true;
                         _index_in_current_partition = true;
                         _saved_partition_tombstone.reset();
+                        _readahead.on_skip(_context->position(), start);
                         _context->reset(indexable_element::partition);
                         return _context->fast_forward_to(start, *end);
                     }
@@ -1791,6 +1856,10 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         auto close_context = make_ready_future<>();
         if (_context) {
             _monitor.on_read_completed();
+            if (!reversed()) {
+                auto ondisk_ratio = _sst->get_compression() && _sst->data_size() ? double(_sst->ondisk_data_size()) / _sst->data_size() : 1.0;
+                _readahead.on_close(_context->position(), ondisk_ratio, _sst->get_table_data_readahead_stats());
+            }
             // move _context to prevent double-close from destructor.
             close_context = _context->close().finally([_ = std::move(_context)] {});
         }
@@ -2186,6 +2255,10 @@ class validating_consumer {
         return data_consumer::proceed::yes;
     }
 
+    bool needs_cell_values(const column_translation::column_info& column_info, bool is_static) const {
+        return true;
+    }
+
     data_consumer::proceed consume_range_tombstone(const std::vector<fragmented_temporary_buffer>& ecp, bound_kind kind, tombstone tomb) {
         auto ck = from_fragmented_buffer(ecp);
         _current_pos = position_in_partition(position_in_partition::range_tag_t(), kind, std::move(ck));
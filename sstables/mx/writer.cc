@@ -9,6 +9,7 @@
 #include "sstables/mx/writer.hh"
 #include "sstables/writer.hh"
 #include "sstables/trie/bti_index.hh"
+#include "sstables/row_hash_index.hh"
 #include "encoding_stats.hh"
 #include "schema/schema.hh"
 #include "mutation/mutation_fragment.hh"
@@ -556,6 +557,8 @@ class writer : public sstable_writer::writer_impl {
     bool _delayed_filter = true;
     // The writer of the temporary file used when `_delayed_filter` is true.
     std::unique_ptr<file_writer> _hashes_writer;
+    std::unique_ptr<file_writer> _row_hashes_writer;
+    std::optional<row_hash_index_writer> _row_hash_index_writer;
     bool _tombstone_written = false;
     bool _static_row_written = false;
     // The length of partition header (partition key, partition deletion and static row, if present)
@@ -564,6 +567,7 @@ class writer : public sstable_writer::writer_impl {
     uint64_t _partition_header_length = 0;
     uint64_t _prev_row_start = 0;
     std::optional<key> _partition_key;
+    dht::token _partition_token;
     utils::hashed_key _current_murmur_hash{{0, 0}};
     std::optional<key> _first_key, _last_key;
     index_sampling_state _index_sampling_state;
@@ -826,16 +830,18 @@ class writer : public sstable_writer::writer_impl {
         // exactly what callers used to do anyway.
         estimated_partitions = std::max(uint64_t(1), estimated_partitions);
 
-        _sst.open_sstable(cfg.origin);
+        _sst.open_sstable(cfg.origin, cfg.row_hash_index_min_partition_size != 0);
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
-        _delayed_filter = _sst.has_component(component_type::Filter) && !_sst.has_component(component_type::Index);
+        // XOR filters are built from the complete set of keys, so they are always delayed.
+        _delayed_filter = _sst.has_component(component_type::Filter)
+                && (!_sst.has_component(component_type::Index) || _sst.filter_format() == utils::filter_format::xor_format);
         init_file_writers();
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
         if (!_delayed_filter) {
-            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), _sst.filter_format());
         }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
@@ -871,6 +877,7 @@ writer::~writer() {
     close_writer(_partitions_writer);
     close_writer(_rows_writer);
     close_writer(_hashes_writer);
+    close_writer(_row_hashes_writer);
 }
 
 void writer::maybe_set_pi_first_clustering(const clustering_info& info, tombstone preceding_range_tombstone) {
@@ -963,6 +970,10 @@ void writer::init_file_writers() {
         _hashes_writer = std::make_unique<file_writer>(_sst.make_component_file_writer(component_type::TemporaryHashes, std::move(options),
             open_flags::wo | open_flags::create | open_flags::exclusive).get());
     }
+    if (_sst.has_component(component_type::RowHashes)) {
+        _row_hashes_writer = std::make_unique<file_writer>(_sst.make_component_file_writer(component_type::RowHashes, {}).get());
+        _row_hash_index_writer.emplace(*_row_hashes_writer, _cfg.row_hash_index_min_partition_size);
+    }
 }
 
 std::unique_ptr<file_writer> writer::close_writer(std::unique_ptr<file_writer>& w) {
@@ -987,6 +998,7 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     _prev_row_start = _data_writer->offset();
 
     _partition_key = key::from_partition_key(_schema, dk.key());
+    _partition_token = dk.token();
     maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
 
     _current_murmur_hash = utils::make_hashed_key(bytes_view(*_partition_key));
@@ -1422,6 +1434,9 @@ stop_iteration writer::consume(clustering_row&& cr) {
 
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
+    if (_row_hash_index_writer) {
+        _row_hash_index_writer->add_row(cr.key(), _data_writer->offset() - _c_stats.start_offset);
+    }
     write_clustered(cr, _current_tombstone);
 
     auto can_split_partition_at_clustering_boundary = [this] {
@@ -1527,6 +1542,9 @@ void writer::write_clustered(const rt_marker& marker, uint64_t prev_row_size) {
 }
 
 void writer::consume(rt_marker&& marker, tombstone preceding_range_tombstone) {
+    if (_row_hash_index_writer) {
+        _row_hash_index_writer->add_range_tombstone();
+    }
     write_clustered(marker, preceding_range_tombstone);
 }
 
@@ -1605,10 +1623,14 @@ stop_iteration writer::consume_end_of_partition() {
     // compute size of the current row.
     _c_stats.partition_size = _data_writer->offset() - _c_stats.start_offset;
 
+    if (_row_hash_index_writer) {
+        _row_hash_index_writer->end_partition(_c_stats.start_offset, end_of_partition_position - _c_stats.start_offset, _c_stats.partition_size);
+    }
+
     maybe_record_large_partitions(_sst, *_partition_key, _c_stats.partition_size, _c_stats.rows_count, _c_stats.range_tombstones_count, _c_stats.dead_rows_count);
 
     // update is about merging column_stats with the data being stored by collector.
-    _collector.update(std::move(_c_stats));
+    _collector.update(_partition_token, std::move(_c_stats));
     _c_stats.reset();
 
     if (!_first_key) {
@@ -1655,6 +1677,10 @@ void writer::consume_end_of_stream() {
     if (_hashes_writer) {
         close_writer(_hashes_writer);
     }
+    if (_row_hashes_writer) {
+        _row_hash_index_writer->finish();
+        close_writer(_row_hashes_writer);
+    }
 
     _sst.set_first_and_last_keys();
 
@@ -1695,7 +1721,7 @@ void writer::consume_end_of_stream() {
     std::optional<scylla_metadata::ext_timestamp_stats> ts_stats(scylla_metadata::ext_timestamp_stats{
         .map = _collector.get_ext_timestamp_stats()
     });
-    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats));
+    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats), _collector.get_tombstone_histograms());
     _sst.seal_sstable(_cfg.backup).get();
 }
 
@@ -65,6 +65,10 @@ class partition_index_cache {
 
         void on_evicted() noexcept override;
 
+        float eviction_cost() const noexcept override {
+            return float(_parent->_refetch_cost * parsed_page_cost) / std::max<size_t>(_size_in_allocator, 1);
+        }
+
         // Returns the amount of memory owned by this entry.
         // Always returns the same value for a given state of _page.
         size_t size_in_allocator() const { return _size_in_allocator; }
@@ -153,14 +157,30 @@ class partition_index_cache {
     logalloc::allocating_section _as;
     lru& _lru;
     partition_index_cache_stats& _stats;
+    partition_index_cache_stats* _table_stats;
+    // Relative cost of reading a page of the index back from storage.
+    unsigned _refetch_cost = 1;
+    // Entries are parsed from the index file, so reloading them costs more
+    // than the I/O alone.
+    static constexpr unsigned parsed_page_cost = 2;
+
+    template <typename Func>
+    void update_stats(Func&& f) noexcept {
+        f(_stats);
+        if (_table_stats) {
+            f(*_table_stats);
+        }
+    }
 public:
 
     // Create a cache with a given LRU attached.
-    partition_index_cache(lru& lru_, logalloc::region& r, partition_index_cache_stats& stats)
+    // If table_stats is given, it is updated along with stats.
+    partition_index_cache(lru& lru_, logalloc::region& r, partition_index_cache_stats& stats, partition_index_cache_stats* table_stats = nullptr)
             : _cache(key_less_comparator())
             , _region(r)
             , _lru(lru_)
             , _stats(stats)
+            , _table_stats(table_stats)
     { }
 
     ~partition_index_cache() {
@@ -175,6 +195,12 @@ class partition_index_cache {
     partition_index_cache(partition_index_cache&&) = delete;
     partition_index_cache(const partition_index_cache&) = delete;
 
+    // Sets the cost of re-reading index pages relative to local storage,
+    // which makes eviction prefer other index entries, see lru::evict().
+    void set_refetch_cost(unsigned cost) noexcept {
+        _refetch_cost = cost;
+    }
+
     // Returns a future which resolves with a shared pointer to index_list for given key.
     // Always returns a valid pointer if succeeds. The pointer is never invalidated externally.
     //
@@ -191,18 +217,20 @@ class partition_index_cache {
             entry& cp = *i;
             auto ptr = share(cp);
             if (cp.ready()) {
-                ++_stats.hits;
+                update_stats([] (auto& s) { ++s.hits; });
                 return make_ready_future<entry_ptr>(std::move(ptr));
             } else {
-                ++_stats.blocks;
+                update_stats([] (auto& s) { ++s.blocks; });
                 return ptr.get_entry().promise()->get_shared_future().then([ptr] () mutable {
                     return std::move(ptr);
                 });
             }
         }
 
-        ++_stats.misses;
-        ++_stats.blocks;
+        update_stats([] (auto& s) {
+            ++s.misses;
+            ++s.blocks;
+        });
 
         entry_ptr ptr = _as(_region, [&] {
             return with_allocator(_region.allocator(), [&] {
@@ -226,8 +254,10 @@ class partition_index_cache {
                 partition_index_page&& page = f.get();
                 e.promise()->set_value();
                 e.set_page(std::move(page));
-                _stats.used_bytes += e.size_in_allocator();
-                ++_stats.populations;
+                update_stats([&e] (auto& s) {
+                    s.used_bytes += e.size_in_allocator();
+                    ++s.populations;
+                });
                 return ptr;
             } catch (...) {
                 e.promise()->set_exception(std::current_exception());
@@ -241,8 +271,10 @@ class partition_index_cache {
     }
 
     void on_evicted(entry& p) {
-        _stats.used_bytes -= p.size_in_allocator();
-        ++_stats.evictions;
+        update_stats([&p] (auto& s) {
+            s.used_bytes -= p.size_in_allocator();
+            ++s.evictions;
+        });
     }
 
     // Evicts all unreferenced entries.
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+
+#include "row_hash_index.hh"
+#include "exceptions.hh"
+#include "file_writer.hh"
+#include "schema/schema.hh"
+#include "utils/cached_file.hh"
+#include "utils/murmur_hash.hh"
+
+namespace sstables {
+
+static constexpr uint32_t row_hash_index_magic = 0x52484958; // "RHIX"
+static constexpr size_t slot_size = sizeof(uint32_t) + sizeof(uint64_t);
+static constexpr size_t directory_entry_size = 3 * sizeof(uint64_t) + sizeof(uint32_t);
+static constexpr size_t footer_size = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+bool row_hash_index_supported(const schema& s) {
+    if (s.clustering_key_size() == 0) {
+        return false;
+    }
+    for (const auto& cdef : s.clustering_key_columns()) {
+        if (!cdef.type->is_byte_order_equal()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t row_hash(const clustering_key_prefix& ck) {
+    std::array<uint64_t, 2> result;
+    ck.representation().with_linearized([&] (bytes_view bv) {
+        utils::murmur_hash::hash3_x64_128(bv, 0, result);
+    });
+    return result[0];
+}
+
+static uint32_t fingerprint(uint64_t hash) {
+    // 0 marks empty slots.
+    return std::max<uint32_t>(hash >> 32, 1);
+}
+
+template <std::integral T>
+static void write_be(file_writer& out, T value) {
+    value = net::hton(value);
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+row_hash_index_writer::row_hash_index_writer(file_writer& out, uint64_t min_partition_size)
+    : _out(out)
+    , _min_partition_size(min_partition_size)
+{ }
+
+void row_hash_index_writer::add_row(const clustering_key_prefix& ck, uint64_t offset_in_partition) {
+    if (!_indexable) {
+        return;
+    }
+    if (_rows.size() == max_rows_per_partition) {
+        _indexable = false;
+        _rows = {};
+        return;
+    }
+    _rows.emplace_back(row_hash(ck), offset_in_partition);
+}
+
+void row_hash_index_writer::end_partition(uint64_t partition_position, uint64_t end_of_partition_offset, uint64_t partition_size) {
+    if (_indexable && !_rows.empty() && partition_size >= _min_partition_size) {
+        // Keep the load factor at most 2/3, so that probe sequences are short.
+        uint32_t n_slots = std::bit_ceil(_rows.size() * 3 / 2 + 1);
+        utils::chunked_vector<std::pair<uint32_t, uint64_t>> slots(n_slots);
+        for (auto [hash, offset] : _rows) {
+            auto idx = hash & (n_slots - 1);
+            while (slots[idx].first) {
+                idx = (idx + 1) & (n_slots - 1);
+            }
+            slots[idx] = {fingerprint(hash), offset};
+        }
+        _directory.push_back(row_hash_index_entry{
+            .partition_position = partition_position,
+            .table_offset = _out.offset(),
+            .n_slots = n_slots,
+            .end_of_partition_offset = end_of_partition_offset,
+        });
+        for (auto [fp, offset] : slots) {
+            write_be(_out, fp);
+            write_be(_out, offset);
+        }
+    }
+    _rows.clear();
+    _indexable = true;
+}
+
+void row_hash_index_writer::finish() {
+    uint64_t directory_offset = _out.offset();
+    for (const auto& e : _directory) {
+        write_be(_out, e.partition_position);
+        write_be(_out, e.table_offset);
+        write_be(_out, e.n_slots);
+        write_be(_out, e.end_of_partition_offset);
+    }
+    write_be(_out, directory_offset);
+    write_be(_out, uint32_t(_directory.size()));
+    write_be(_out, row_hash_index_magic);
+}
+
+// Reads len bytes at pos.
+static future<temporary_buffer<char>> read_exactly(cached_file& f, uint64_t pos, size_t len, std::optional<reader_permit> permit) {
+    temporary_buffer<char> result(len);
+    auto s = f.read(pos, std::move(permit), {}, len);
+    size_t done = 0;
+    while (done < len) {
+        auto buf = co_await s.next();
+        if (buf.empty()) {
+            throw malformed_sstable_exception(format("RowHashes.db: unexpected end of file reading {} bytes at {}", len, pos));
+        }
+        auto n = std::min(buf.size(), len - done);
+        std::copy_n(buf.get(), n, result.get_write() + done);
+        done += n;
+    }
+    co_return result;
+}
+
+row_hash_index::row_hash_index(seastar::shared_ptr<cached_file> file, utils::chunked_vector<row_hash_index_entry> directory)
+    : _file(std::move(file))
+    , _directory(std::move(directory))
+{ }
+
+future<utils::chunked_vector<row_hash_index_entry>> row_hash_index::read_directory(cached_file& f) {
+    if (f.size() < footer_size) {
+        throw malformed_sstable_exception(format("RowHashes.db: file too small: {}", f.size()));
+    }
+    auto footer = co_await read_exactly(f, f.size() - footer_size, footer_size, std::nullopt);
+    auto p = footer.get();
+    auto directory_offset = read_be<uint64_t>(p);
+    auto n_entries = read_be<uint32_t>(p + sizeof(uint64_t));
+    auto magic = read_be<uint32_t>(p + sizeof(uint64_t) + sizeof(uint32_t));
+    if (magic != row_hash_index_magic || directory_offset + uint64_t(n_entries) * directory_entry_size + footer_size != f.size()) {
+        throw malformed_sstable_exception(format("RowHashes.db: bad footer: magic={:#x}, directory_offset={}, entries={}, size={}",
+                magic, directory_offset, n_entries, f.size()));
+    }
+    utils::chunked_vector<row_hash_index_entry> directory;
+    directory.reserve(n_entries);
+    auto buf = co_await read_exactly(f, directory_offset, n_entries * directory_entry_size, std::nullopt);
+    for (p = buf.get(); p != buf.end(); p += directory_entry_size) {
+        directory.push_back(row_hash_index_entry{
+            .partition_position = read_be<uint64_t>(p),
+            .table_offset = read_be<uint64_t>(p + 8),
+            .n_slots = read_be<uint32_t>(p + 16),
+            .end_of_partition_offset = read_be<uint64_t>(p + 20),
+        });
+        if (!std::has_single_bit(directory.back().n_slots)) {
+            throw malformed_sstable_exception(format("RowHashes.db: bad number of slots {} for partition at {}",
+                    directory.back().n_slots, directory.back().partition_position));
+        }
+    }
+    co_return directory;
+}
+
+future<> row_hash_index::evict_gently() {
+    return _file->evict_gently();
+}
+
+future<std::optional<uint64_t>> row_hash_index::find_row(uint64_t partition_position, const clustering_key_prefix& ck, reader_permit permit) const {
+    auto it = std::ranges::lower_bound(_directory, partition_position, std::less<>(), &row_hash_index_entry::partition_position);
+    if (it == _directory.end() || it->partition_position != partition_position) {
+        co_return std::nullopt;
+    }
+    const row_hash_index_entry& e = *it;
+    auto hash = row_hash(ck);
+    auto fp = fingerprint(hash);
+    std::optional<uint64_t> result;
+    auto idx = hash & (e.n_slots - 1);
+    // The load factor is below 1, so there is at least one empty slot.
+    for (uint32_t probes = 0; probes < e.n_slots; ++probes) {
+        auto slot = co_await read_exactly(*_file, e.table_offset + idx * slot_size, slot_size, permit);
+        auto slot_fp = read_be<uint32_t>(slot.get());
+        if (!slot_fp) {
+            break;
+        }
+        if (slot_fp == fp) {
+            auto offset = read_be<uint64_t>(slot.get() + sizeof(uint32_t));
+            result = std::min(result.value_or(offset), offset);
+        }
+        idx = (idx + 1) & (e.n_slots - 1);
+    }
+    co_return result.value_or(e.end_of_partition_offset);
+}
+
+} // namespace sstables
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "keys/keys.hh"
+#include "reader_permit.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/chunked_vector.hh"
+
+class cached_file;
+
+namespace sstables {
+
+class file_writer;
+
+// Row hash index (RowHashes.db).
+//
+// Optional component of sstables with the BIG index format, which maps full
+// clustering keys of rows in large partitions to the position of the row in
+// the partition. It lets single row reads skip straight to the row, instead of
+// searching the promoted index and scanning a whole promoted index block, and
+// reads of absent rows skip the clustering rows of the partition altogether.
+//
+// File layout (all integers big-endian):
+//
+//   table*                 one per indexed partition
+//   directory_entry*       sorted by partition position
+//   footer
+//
+//   table = slot[n_slots]  open addressing with linear probing, n_slots is a power of 2
+//   slot = fingerprint: u32 (0 marks an empty slot), offset_in_partition: u64
+//   directory_entry = partition_position: u64, table_offset: u64, n_slots: u32, end_of_partition_offset: u64
+//   footer = directory_offset: u64, n_entries: u32, magic: u32
+//
+// Offsets in partition are relative to the partition start in Data.db.
+// end_of_partition_offset is the offset of the end of partition flag.
+//
+// Partitions with range tombstones are not indexed: jumping into the middle of
+// such a partition would miss the tombstone active at the jump position.
+
+// Whether row hash index can be built for tables with the given schema.
+// Keys are hashed by their serialized form, so all clustering key types
+// must have a single serialized form for each value.
+bool row_hash_index_supported(const schema& s);
+
+uint64_t row_hash(const clustering_key_prefix& ck);
+
+struct row_hash_index_entry {
+    uint64_t partition_position;
+    uint64_t table_offset;
+    uint32_t n_slots;
+    uint64_t end_of_partition_offset;
+};
+
+class row_hash_index_writer {
+public:
+    // Larger partitions are not indexed, to bound the writer's memory.
+    static constexpr size_t max_rows_per_partition = 1 << 20;
+private:
+    file_writer& _out;
+    uint64_t _min_partition_size;
+    utils::chunked_vector<row_hash_index_entry> _directory;
+    utils::chunked_vector<std::pair<uint64_t, uint64_t>> _rows; // (hash, offset in partition)
+    bool _indexable = true;
+public:
+    row_hash_index_writer(file_writer& out, uint64_t min_partition_size);
+
+    void add_row(const clustering_key_prefix& ck, uint64_t offset_in_partition);
+    // The partition can't be indexed, see above.
+    void add_range_tombstone() noexcept {
+        _indexable = false;
+    }
+    // Writes the table of the partition if it's large enough.
+    void end_partition(uint64_t partition_position, uint64_t end_of_partition_offset, uint64_t partition_size);
+    // Writes the directory and the footer.
+    void finish();
+};
+
+class row_hash_index {
+    seastar::shared_ptr<cached_file> _file;
+    utils::chunked_vector<row_hash_index_entry> _directory;
+public:
+    row_hash_index(seastar::shared_ptr<cached_file> file, utils::chunked_vector<row_hash_index_entry> directory);
+
+    // Reads the directory of the RowHashes.db file cached by f.
+    static future<utils::chunked_vector<row_hash_index_entry>> read_directory(cached_file& f);
+
+    size_t memory_usage() const noexcept {
+        return _directory.memory_size();
+    }
+
+    future<> evict_gently();
+
+    // Returns the offset in partition from which the row with given full key
+    // should be read: the position of the row if the key is present, or the
+    // position of the end of partition flag if it's absent. Returns a
+    // disengaged optional if the partition isn't indexed.
+    //
+    // On fingerprint collisions the earliest of the matching positions is
+    // returned. That's never past the row, and the reader skips the rows
+    // which don't match the key.
+    future<std::optional<uint64_t>> find_row(uint64_t partition_position, const clustering_key_prefix& ck, reader_permit permit) const;
+};
+
+} // namespace sstables
@@ -194,6 +194,10 @@ void sstable_directory::filesystem_components_lister::handle(sstables::entry_des
         // and we'll go with it.
         _state->files_for_removal.insert(filename.native());
         break;
+    case component_type::TemporaryScylla:
+        // Same as TemporaryStatistics, for rewrites of the Scylla file.
+        _state->files_for_removal.insert(filename.native());
+        break;
     case component_type::TemporaryHashes:
         // We generate TemporaryHashes when writing the sstable,
         // and it's removed before the sstable is sealed.
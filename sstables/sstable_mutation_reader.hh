@@ -121,14 +121,15 @@ position_in_partition_view get_slice_lower_bound(const schema& s, const query::p
 // heuristics which learn from the usefulness of previous read aheads.
 template <typename DataConsumeRowsContext>
 inline future<std::unique_ptr<DataConsumeRowsContext>> data_consume_rows(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer,
-        sstable::disk_read_range toread, uint64_t last_end, integrity_check integrity) {
+        sstable::disk_read_range toread, uint64_t last_end, integrity_check integrity, data_readahead_controller* readahead) {
     // Although we were only asked to read until toread.end, we'll not limit
     // the underlying file input stream to this end, but rather to last_end.
     // This potentially enables read-ahead beyond end, until last_end, which
     // can be beneficial if the user wants to fast_forward_to() on the
     // returned context, and may make small skips.
     auto input = co_await sst->data_stream(toread.start, last_end - toread.start,
-            consumer.permit(), consumer.trace_state(), sst->_partition_range_history, sstable::raw_stream::no, integrity);
+            consumer.permit(), consumer.trace_state(), sst->_partition_range_history, sstable::raw_stream::no, integrity,
+            throwing_integrity_error_handler, readahead);
     co_return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
 }
 
@@ -161,9 +162,10 @@ inline reversed_context<DataConsumeRowsContext> data_consume_reversed_partition(
 
 template <typename DataConsumeRowsContext>
 inline future<std::unique_ptr<DataConsumeRowsContext>> data_consume_single_partition(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer,
-        sstable::disk_read_range toread, integrity_check integrity) {
+        sstable::disk_read_range toread, integrity_check integrity, data_readahead_controller* readahead) {
     auto input = co_await sst->data_stream(toread.start, toread.end - toread.start,
-            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, integrity);
+            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, integrity,
+            throwing_integrity_error_handler, readahead);
     co_return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
 }
 
@@ -172,7 +174,7 @@ template <typename DataConsumeRowsContext>
 inline future<std::unique_ptr<DataConsumeRowsContext>> data_consume_rows(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer,
         integrity_check integrity) {
     auto data_size = sst->data_size();
-    return data_consume_rows<DataConsumeRowsContext>(s, std::move(sst), consumer, {0, data_size}, data_size, integrity);
+    return data_consume_rows<DataConsumeRowsContext>(s, std::move(sst), consumer, {0, data_size}, data_size, integrity, nullptr);
 }
 
 template<typename T>
@@ -9,10 +9,9 @@
 #include <algorithm>
 
 #include "utils/assert.hh"
+#include <seastar/core/on_internal_error.hh>
 #include <seastar/util/defer.hh>
 
-#include <boost/icl/interval_map.hpp>
-
 #include "sstables.hh"
 
 #include "dht/ring_position.hh"
@@ -218,47 +217,194 @@ sstable_set::make_incremental_selector() const {
     return incremental_selector(std::get<0>(std::move(selector)), std::get<1>(selector));
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema& s, const dht::partition_range& range) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.start()->value())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.end()->value())));
+std::strong_ordering sstable_interval_index::compare(size_t i, dht::ring_position_view pos) const {
+    return dht::ring_position_tri_compare(*_schema, dht::ring_position_view(*_boundaries[i].key), pos);
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const dht::partition_range& range) const {
-    return make_interval(*_schema, range);
+size_t sstable_interval_index::lower_bound_key(dht::ring_position_view pos) const {
+    // Keys sharing a token are rare, so search the tokens first, which are
+    // laid out compactly, and only then compare keys.
+    auto i = size_t(std::ranges::lower_bound(_tokens, pos.token()) - _tokens.begin());
+    while (i < _boundaries.size() && _tokens[i] == pos.token() && compare(i, pos) < 0) {
+        ++i;
+    }
+    return i;
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema_ptr& s, const sstable& sst) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_first_decorated_key())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_last_decorated_key())));
+size_t sstable_interval_index::ensure_boundary(const dht::decorated_key& dk) {
+    auto i = lower_bound_key(dht::ring_position_view(dk));
+    if (i < _boundaries.size() && compare(i, dht::ring_position_view(dk)) == 0) {
+        return i;
+    }
+    // The new key splits the gap it falls into, so both its pieces start
+    // with the sstables of that gap.
+    auto ssts = i ? _boundaries[i - 1].after : sstable_vector();
+    _tokens.insert(_tokens.begin() + i, dk.token());
+    _boundaries.insert(_boundaries.begin() + i, boundary{&dk, ssts, ssts});
+    return i;
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const sstable& sst) {
-    return make_interval(_schema, sst);
+static bool sstable_address_less(const shared_sstable& a, const shared_sstable& b) {
+    return std::less<const sstable*>()(a.get(), b.get());
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::singular(const dht::ring_position& rp) const {
-    // We should use the view here, since this is used for queries.
-    auto rpv = dht::ring_position_view(rp);
-    auto crp = dht::compatible_ring_position_or_view(*_schema, std::move(rpv));
-    return interval_type::closed(crp, crp);
+static void insert_sorted(sstable_interval_index::sstable_vector& v, const shared_sstable& sst) {
+    v.insert(std::ranges::lower_bound(v, sst, sstable_address_less), sst);
 }
 
-std::pair<partitioned_sstable_set::map_iterator, partitioned_sstable_set::map_iterator>
-partitioned_sstable_set::query(const dht::partition_range& range) const {
-    if (range.start() && range.end()) {
-        return _leveled_sstables.equal_range(make_interval(range));
+static void erase_sorted(sstable_interval_index::sstable_vector& v, const shared_sstable& sst) {
+    auto it = std::ranges::lower_bound(v, sst, sstable_address_less);
+    if (it != v.end() && *it == sst) {
+        v.erase(it);
     }
-    else if (range.start() && !range.end()) {
-        auto start = singular(range.start()->value());
-        return { _leveled_sstables.lower_bound(start), _leveled_sstables.end() };
-    } else if (!range.start() && range.end()) {
-        auto end = singular(range.end()->value());
-        return { _leveled_sstables.begin(), _leveled_sstables.upper_bound(end) };
-    } else {
-        return { _leveled_sstables.begin(), _leveled_sstables.end() };
+}
+
+void sstable_interval_index::insert(const shared_sstable& sst) {
+    auto first = ensure_boundary(sst->get_first_decorated_key());
+    auto last = ensure_boundary(sst->get_last_decorated_key());
+    for (auto i = first; i <= last; ++i) {
+        insert_sorted(_boundaries[i].at, sst);
+        if (i != last) {
+            insert_sorted(_boundaries[i].after, sst);
+        }
+    }
+}
+
+void sstable_interval_index::maybe_remove_boundary(size_t i, const shared_sstable& erased) {
+    auto& b = _boundaries[i];
+    static const sstable_vector no_sstables;
+    auto& before = i ? _boundaries[i - 1].after : no_sstables;
+    if (b.at == before && b.at == b.after) {
+        // No sstable starts or ends here anymore.
+        _tokens.erase(_tokens.begin() + i);
+        _boundaries.erase(_boundaries.begin() + i);
+        return;
+    }
+    if (b.key != &erased->get_first_decorated_key() && b.key != &erased->get_last_decorated_key()) {
+        return;
+    }
+    // Some remaining sstable starts or ends here, take the key from it.
+    auto pos = dht::ring_position_view(*b.key);
+    for (auto& sst : b.at) {
+        for (auto* dk : {&sst->get_first_decorated_key(), &sst->get_last_decorated_key()}) {
+            if (dht::ring_position_tri_compare(*_schema, dht::ring_position_view(*dk), pos) == 0) {
+                b.key = dk;
+                return;
+            }
+        }
+    }
+    on_internal_error(sstlog, format("sstable_interval_index: no sstable bounded by key {}", *b.key));
+}
+
+void sstable_interval_index::erase(const shared_sstable& sst) {
+    auto& first_key = sst->get_first_decorated_key();
+    auto first = lower_bound_key(dht::ring_position_view(first_key));
+    if (first == _boundaries.size() || compare(first, dht::ring_position_view(first_key)) != 0
+            || !std::ranges::binary_search(_boundaries[first].at, sst, sstable_address_less)) {
+        return;
+    }
+    auto last = first;
+    for (;; ++last) {
+        erase_sorted(_boundaries[last].at, sst);
+        if (!std::ranges::binary_search(_boundaries[last].after, sst, sstable_address_less)) {
+            break;
+        }
+        erase_sorted(_boundaries[last].after, sst);
+    }
+    // Only the pieces around the bounds of sst could have become equal.
+    if (last != first) {
+        maybe_remove_boundary(last, sst);
+    }
+    maybe_remove_boundary(first, sst);
+}
+
+const sstable_interval_index::sstable_vector& sstable_interval_index::piece(size_t p) const {
+    auto& b = _boundaries[p / 2];
+    return p % 2 ? b.after : b.at;
+}
+
+size_t sstable_interval_index::interval_end(size_t p) const {
+    auto& ssts = piece(p);
+    auto e = p + 1;
+    while (e < end() && piece(e) == ssts) {
+        ++e;
+    }
+    return e;
+}
+
+size_t sstable_interval_index::skip_empty(size_t p) const {
+    while (p < end() && piece(p).empty()) {
+        ++p;
+    }
+    return p;
+}
+
+size_t sstable_interval_index::lower_bound(dht::ring_position_view pos) const {
+    auto i = lower_bound_key(pos);
+    if (i == _boundaries.size()) {
+        return end();
+    }
+    // The gap before key i is entirely before pos iff the key is equal to it.
+    auto p = compare(i, pos) == 0 ? 2 * i : std::max<size_t>(2 * i, 1) - 1;
+    p = skip_empty(p);
+    if (p == end()) {
+        return p;
+    }
+    // Find the start of the interval containing the piece.
+    while (p > 0 && piece(p - 1) == piece(p)) {
+        --p;
+    }
+    return p;
+}
+
+sstable_interval_index::interval sstable_interval_index::get(size_t p) const {
+    auto last = interval_end(p) - 1;
+    return interval{
+        .lower = _boundaries[p / 2].key,
+        .upper = last % 2 ? _boundaries[last / 2 + 1].key : _boundaries[last / 2].key,
+        .lower_closed = p % 2 == 0,
+        .upper_closed = last % 2 == 0,
+        .sstables = &piece(p),
+    };
+}
+
+void sstable_interval_index::select(const dht::partition_range& range, sstable_vector& out) const {
+    std::optional<dht::ring_position_view> start, end;
+    if (range.start()) {
+        start = dht::ring_position_view(range.start()->value());
+    }
+    if (range.end()) {
+        end = dht::ring_position_view(range.end()->value());
+    }
+    if (start && end && dht::ring_position_tri_compare(*_schema, *start, *end) > 0) {
+        return;
+    }
+
+    size_t p = 0;
+    if (start) {
+        auto i = lower_bound_key(*start);
+        if (i == _boundaries.size()) {
+            return;
+        }
+        p = compare(i, *start) == 0 ? 2 * i : std::max<size_t>(2 * i, 1) - 1;
+    }
+    auto n = out.size();
+    for (auto first = p; p < this->end(); ++p) {
+        if (end) {
+            // A key overlaps if it is not after end, the gap after it if the key is before end.
+            auto c = compare(p / 2, *end);
+            if (c > 0 || (p % 2 && c == 0)) {
+                break;
+            }
+        }
+        // Don't add the same sstables again for each piece of an interval.
+        if (p != first && piece(p) == piece(p - 1)) {
+            continue;
+        }
+        out.insert(out.end(), piece(p).begin(), piece(p).end());
     }
+    std::sort(out.begin() + n, out.end(), sstable_address_less);
+    out.erase(std::unique(out.begin() + n, out.end()), out.end());
 }
 
 bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) const {
@@ -284,17 +430,10 @@ bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) cons
     return as_unleveled;
 }
 
-dht::ring_position partitioned_sstable_set::to_ring_position(const dht::compatible_ring_position_or_view& crp) {
-    // Ring position views, representing bounds of sstable intervals are
-    // guaranteed to have key() != nullptr;
-    const auto& pos = crp.position();
-    return dht::ring_position(pos.token(), *pos.key());
-}
-
 dht::partition_range partitioned_sstable_set::to_partition_range(const interval_type& i) {
     return dht::partition_range::make(
-            {to_ring_position(i.lower()), boost::icl::is_left_closed(i.bounds())},
-            {to_ring_position(i.upper()), boost::icl::is_right_closed(i.bounds())});
+            {dht::ring_position(*i.lower), i.lower_closed},
+            {dht::ring_position(*i.upper), i.upper_closed});
 }
 
 dht::partition_range partitioned_sstable_set::to_partition_range(const dht::ring_position_view& pos, const interval_type& i) {
@@ -306,12 +445,13 @@ dht::partition_range partitioned_sstable_set::to_partition_range(const dht::ring
             return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
         }
     }();
-    auto upper_bound = dht::partition_range::bound(to_ring_position(i.lower()), !boost::icl::is_left_closed(i.bounds()));
+    auto upper_bound = dht::partition_range::bound(dht::ring_position(*i.lower), !i.lower_closed);
     return dht::partition_range::make(std::move(lower_bound), std::move(upper_bound));
 }
 
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, dht::token_range token_range)
         : _schema(std::move(schema))
+        , _leveled_sstables(_schema)
         , _all(make_lw_shared<sstable_list>())
         , _token_range(std::move(token_range)) {
 }
@@ -322,7 +462,7 @@ static std::unordered_map<run_id, shared_sstable_run> clone_runs(const std::unor
     }) | std::ranges::to<std::unordered_map<run_id, shared_sstable_run>>();
 }
 
-partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
+partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const sstable_interval_index& leveled_sstables,
         const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, dht::token_range token_range, uint64_t bytes_on_disk)
         : sstable_set_impl(bytes_on_disk)
         , _schema(schema)
@@ -338,12 +478,8 @@ std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
 }
 
 std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition_range& range) const {
-    value_set result;
-    for (auto [b, e] = query(range); b != e; ++b) {
-        std::ranges::copy(b->second, std::inserter(result, result.end()));
-    }
     auto r = _unleveled_sstables;
-    r.insert(r.end(), result.begin(), result.end());
+    _leveled_sstables.select(range, r);
     return r;
 }
 
@@ -404,7 +540,7 @@ bool partitioned_sstable_set::insert(shared_sstable sst) {
         _unleveled_sstables.push_back(sst);
     } else {
         _leveled_sstables_change_cnt++;
-        _leveled_sstables.add({make_interval(*sst), value_set({sst})});
+        _leveled_sstables.insert(sst);
     }
     undo_all_insert.cancel();
     undo_all_runs_insert.cancel();
@@ -426,7 +562,7 @@ bool partitioned_sstable_set::erase(shared_sstable sst) {
         _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
     } else {
         _leveled_sstables_change_cnt++;
-        _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
+        _leveled_sstables.erase(sst);
     }
     return ret;
 }
@@ -439,34 +575,39 @@ partitioned_sstable_set::size() const noexcept {
 class partitioned_sstable_set::incremental_selector : public incremental_selector_impl {
     schema_ptr _schema;
     const std::vector<shared_sstable>& _unleveled_sstables;
-    const interval_map_type& _leveled_sstables;
+    const sstable_interval_index& _leveled_sstables;
     const uint64_t& _leveled_sstables_change_cnt;
     uint64_t _last_known_leveled_sstables_change_cnt;
-    map_iterator _it;
+    size_t _it;
 private:
-    dht::ring_position_ext next_position(map_iterator it) {
+    dht::ring_position_ext next_position(size_t it) {
         if (it == _leveled_sstables.end()) {
             return dht::ring_position_view::max();
         } else {
-            auto&& next_position = partitioned_sstable_set::to_ring_position(it->first.lower());
-            return dht::ring_position_ext(next_position, dht::ring_position_ext::after_key(!boost::icl::is_left_closed(it->first.bounds())));
+            auto i = _leveled_sstables.get(it);
+            return dht::ring_position_ext(dht::ring_position(*i.lower), dht::ring_position_ext::after_key(!i.lower_closed));
         }
     }
-    static bool is_before_interval(const dht::compatible_ring_position_or_view& crp, const interval_type& interval) {
-        if (boost::icl::is_left_closed(interval.bounds())) {
-            return crp < interval.lower();
-        } else {
-            return crp <= interval.lower();
-        }
+    std::strong_ordering compare(const dht::ring_position_view& pos, const dht::decorated_key* key) const {
+        return dht::ring_position_tri_compare(*_schema, pos, dht::ring_position_view(*key));
+    }
+    bool contains(const interval_type& interval, const dht::ring_position_view& pos) const {
+        auto lc = compare(pos, interval.lower);
+        auto uc = compare(pos, interval.upper);
+        return (interval.lower_closed ? lc >= 0 : lc > 0) && (interval.upper_closed ? uc <= 0 : uc < 0);
     }
-    void maybe_invalidate_iterator(const dht::compatible_ring_position_or_view& crp) {
+    bool is_before_interval(const dht::ring_position_view& pos, const interval_type& interval) const {
+        auto c = compare(pos, interval.lower);
+        return interval.lower_closed ? c < 0 : c <= 0;
+    }
+    void maybe_invalidate_iterator(const dht::ring_position_view& pos) {
         if (_last_known_leveled_sstables_change_cnt != _leveled_sstables_change_cnt) {
-            _it = _leveled_sstables.lower_bound(interval_type::closed(crp, crp));
+            _it = _leveled_sstables.lower_bound(pos);
             _last_known_leveled_sstables_change_cnt = _leveled_sstables_change_cnt;
         }
     }
 public:
-    incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
+    incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const sstable_interval_index& leveled_sstables,
                          const uint64_t& leveled_sstables_change_cnt)
         : _schema(std::move(schema))
         , _unleveled_sstables(unleveled_sstables)
@@ -477,22 +618,22 @@ class partitioned_sstable_set::incremental_selector : public incremental_selecto
     }
     virtual std::tuple<dht::partition_range, std::vector<shared_sstable>, dht::ring_position_ext> select(const selector_pos& s) override {
         const dht::ring_position_view& pos = s.pos;
-        auto crp = dht::compatible_ring_position_or_view(*_schema, pos);
         auto ssts = _unleveled_sstables;
         using namespace dht;
 
-        maybe_invalidate_iterator(crp);
+        maybe_invalidate_iterator(pos);
 
         while (_it != _leveled_sstables.end()) {
-            if (boost::icl::contains(_it->first, crp)) {
-                ssts.insert(ssts.end(), _it->second.begin(), _it->second.end());
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(_it->first), std::move(ssts), next_position(std::next(_it)));
+            auto interval = _leveled_sstables.get(_it);
+            if (contains(interval, pos)) {
+                ssts.insert(ssts.end(), interval.sstables->begin(), interval.sstables->end());
+                return std::make_tuple(partitioned_sstable_set::to_partition_range(interval), std::move(ssts), next_position(_leveled_sstables.next(_it)));
             }
             // We don't want to skip current interval if pos lies before it.
-            if (is_before_interval(crp, _it->first)) {
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(pos, _it->first), std::move(ssts), next_position(_it));
+            if (is_before_interval(pos, interval)) {
+                return std::make_tuple(partitioned_sstable_set::to_partition_range(pos, interval), std::move(ssts), next_position(_it));
             }
-            _it++;
+            _it = _leveled_sstables.next(_it);
         }
         return std::make_tuple(partition_range::make_open_ended_both_sides(), std::move(ssts), ring_position_view::max());
     }
@@ -894,45 +1035,79 @@ make_sstable_filter(const dht::ring_position& pos, const utils::hashed_key& hash
     };
 }
 
-// Filter out sstables for reader using bloom filter and supplied predicate
-static std::vector<shared_sstable>
-filter_sstable_for_reader(std::vector<shared_sstable>&& sstables, const schema& schema, const dht::ring_position& pos, const utils::hashed_key& hash, const sstable_predicate& predicate) {
-    auto filter = [_filter = make_sstable_filter(pos, hash, schema, predicate)] (const shared_sstable& sst) { return !_filter(*sst); };
-    std::erase_if(sstables, filter);
-    return std::move(sstables);
+utils::dynamic_bitset filter_sstables_by_key(std::span<const shared_sstable> sstables, const utils::hashed_key& hk) {
+    for (const auto& sst : sstables) {
+        sst->filter_prefetch(hk);
+    }
+    utils::dynamic_bitset survivors(sstables.size());
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        if (sstables[i]->filter_has_key(hk)) {
+            survivors.set(i);
+        }
+    }
+    return survivors;
 }
 
-// Filter out sstables for reader using sstable metadata that keeps track
-// of a range for each clustering component.
+// Filter out sstables for reader by their token and clustering bounds, then
+// by bloom filter, and by the supplied predicate.
+//
+// The token and clustering bounds of each sstable form a box in the
+// (token, clustering position) plane and both sides are checked from metadata
+// before any filter is probed, so sstables whose clustering range cannot
+// intersect the slice never have their bloom filter touched, whatever the
+// compaction strategy.
+//
+// Sets `pruned_may_have_partition` if any sstable dropped only because of its
+// clustering range may contain the partition. The caller has to emit the
+// partition anyway in that case, see #3552.
 static std::vector<shared_sstable>
-filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema_ptr& schema,
-        const query::partition_slice& slice) {
-    // no clustering filtering is applied if schema defines no clustering key or
-    // compaction strategy thinks it will not benefit from such an optimization,
+filter_sstable_for_reader(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema& schema, const dht::ring_position& pos,
+        const utils::hashed_key& hash, const query::partition_slice& slice, const sstable_predicate& predicate, bool& pruned_may_have_partition) {
+    std::erase_if(sstables, [&predicate, &pos, cmp = dht::ring_position_comparator(schema)] (const shared_sstable& sst) {
+        return !predicate(*sst) || cmp(pos, sst->get_first_decorated_key()) < 0 || cmp(pos, sst->get_last_decorated_key()) > 0;
+    });
+
+    // No clustering filtering is applied if schema defines no clustering key
     // or the partition_slice includes static columns.
-    if (!schema->clustering_key_size() || !cf.get_compaction_strategy().use_clustering_key_filter() || slice.static_columns.size()) {
-        return std::move(sstables);
+    std::vector<shared_sstable> pruned;
+    bool filter_by_ck = schema.clustering_key_size() && !slice.static_columns.size() && !sstables.empty();
+    if (filter_by_ck) {
+        replica::cf_stats* stats = cf.cf_stats();
+        stats->clustering_filter_count++;
+        stats->sstables_checked_by_clustering_filter += sstables.size();
+
+        auto ck_filtering_all_ranges = slice.get_all_ranges();
+        // fast path to include all sstables if only one full range was specified.
+        // For example, this happens if query only specifies a partition key.
+        if (ck_filtering_all_ranges.size() == 1 && ck_filtering_all_ranges[0].is_full()) {
+            stats->clustering_filter_fast_path_count++;
+        } else {
+            auto skipped = std::partition(sstables.begin(), sstables.end(), [&ranges = ck_filtering_all_ranges] (const shared_sstable& sst) {
+                return sst->may_contain_rows(ranges);
+            });
+            pruned.assign(std::make_move_iterator(skipped), std::make_move_iterator(sstables.end()));
+            sstables.erase(skipped, sstables.end());
+        }
+        stats->surviving_sstables_after_clustering_filter += sstables.size();
     }
 
-    replica::cf_stats* stats = cf.cf_stats();
-    stats->clustering_filter_count++;
-    stats->sstables_checked_by_clustering_filter += sstables.size();
-
-    auto ck_filtering_all_ranges = slice.get_all_ranges();
-    // fast path to include all sstables if only one full range was specified.
-    // For example, this happens if query only specifies a partition key.
-    if (ck_filtering_all_ranges.size() == 1 && ck_filtering_all_ranges[0].is_full()) {
-        stats->clustering_filter_fast_path_count++;
-        stats->surviving_sstables_after_clustering_filter += sstables.size();
-        return std::move(sstables);
+    auto survivors = filter_sstables_by_key(sstables, hash);
+    size_t nr_survivors = 0;
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        if (survivors.test(i)) {
+            if (i != nr_survivors) {
+                sstables[nr_survivors] = std::move(sstables[i]);
+            }
+            ++nr_survivors;
+        }
     }
+    sstables.resize(nr_survivors);
 
-    auto skipped = std::partition(sstables.begin(), sstables.end(), [&ranges = ck_filtering_all_ranges] (const shared_sstable& sst) {
-        return sst->may_contain_rows(ranges);
+    // Only whether any of the pruned sstables has the partition matters, so
+    // stop probing at the first hit.
+    pruned_may_have_partition = std::ranges::any_of(pruned, [&hash] (const shared_sstable& sst) {
+        return sst->filter_has_key(hash);
     });
-    sstables.erase(skipped, sstables.end());
-    stats->surviving_sstables_after_clustering_filter += sstables.size();
-
     return std::move(sstables);
 }
 
@@ -970,12 +1145,12 @@ sstable_set_impl::create_single_key_sstable_reader(
 {
     const auto& pos = pr.start()->value();
     auto hash = utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(*schema, *pos.key())));
-    auto selected_sstables = filter_sstable_for_reader(select(pr), *schema, pos, hash, predicate);
-    auto num_sstables = selected_sstables.size();
-    if (!num_sstables) {
+    bool pruned_may_have_partition = false;
+    auto selected_sstables = filter_sstable_for_reader(select(pr), *cf, *schema, pos, hash, slice, predicate, pruned_may_have_partition);
+    if (selected_sstables.empty() && !pruned_may_have_partition) {
         return make_empty_mutation_reader(schema, permit);
     }
-    auto readers = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+    auto readers = selected_sstables
         | std::views::transform([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, trace_state, fwd, mutation_reader::forwarding::yes,
@@ -983,16 +1158,16 @@ sstable_set_impl::create_single_key_sstable_reader(
           })
         | std::ranges::to<std::vector<mutation_reader>>();
 
-    // If filter_sstable_for_reader_by_ck filtered any sstable that contains the partition
-    // we want to emit partition_start/end if no rows were found,
-    // to prevent https://github.com/scylladb/scylla/issues/3552.
+    // If filter_sstable_for_reader filtered by clustering range any sstable
+    // that contains the partition we want to emit partition_start/end if no
+    // rows were found, to prevent https://github.com/scylladb/scylla/issues/3552.
     //
     // Use `make_mutation_reader_from_mutations` with an empty mutation to emit
     // the partition_start/end pair and append it to the list of readers passed
     // to make_combined_reader to ensure partition_start/end are emitted even if
     // all sstables actually containing the partition were filtered.
     auto num_readers = readers.size();
-    if (num_readers != num_sstables) {
+    if (pruned_may_have_partition) {
         readers.push_back(make_mutation_reader_from_mutations(schema, permit, mutation(schema, *pos.key()), slice, fwd));
     }
     sstable_histogram.add(num_readers);
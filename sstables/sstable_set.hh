@@ -14,13 +14,16 @@
 #include "sstables/types_fwd.hh"
 #include "shared_sstable.hh"
 #include "dht/ring_position.hh"
+#include "utils/dynamic_bitset.hh"
 #include <seastar/core/shared_ptr.hh>
+#include <span>
 #include <type_traits>
 #include <vector>
 #include <tuple>
 
 namespace utils {
 class estimated_histogram;
+class hashed_key;
 }
 
 struct combined_reader_statistics;
@@ -75,6 +78,12 @@ using sstable_predicate = noncopyable_function<bool(const sstable&)>;
 // Default predicate includes everything
 const sstable_predicate& default_sstable_predicate();
 
+// Checks the key against the filters of all the given sstables in one pass.
+// The filter memory of every sstable is prefetched before any of them is
+// tested, so the cache misses of the individual lookups overlap.
+// Bit i of the result is set iff sstables[i] may contain the key.
+utils::dynamic_bitset filter_sstables_by_key(std::span<const shared_sstable> sstables, const utils::hashed_key& hk);
+
 class sstable_set_impl {
 protected:
     uint64_t _bytes_on_disk = 0;
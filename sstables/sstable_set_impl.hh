@@ -8,8 +8,6 @@
 
 #pragma once
 
-#include <boost/icl/interval_map.hpp>
-
 #include "dht/ring_position.hh"
 #include "sstable_set.hh"
 #include "readers/clustering_combined.hh"
@@ -17,17 +15,78 @@
 
 namespace sstables {
 
+// Index of sstables by the closed interval [first key, last key] each spans.
+//
+// The distinct first and last keys of the sstables are kept in a sorted flat
+// array (with their tokens in a parallel array, for the binary searches). For
+// each key, there are two small vectors, sorted by address: the sstables which
+// contain the key, and the ones which contain the open interval between it
+// and the next key. Together these are the "pieces" of the ring, numbered in
+// ring order: piece 2i is key i, and piece 2i+1 is the gap after it.
+//
+// Intervals are the maximal runs of adjacent non-empty pieces having the same
+// sstables, which is how boost::icl::interval_map joins them.
+class sstable_interval_index {
+public:
+    using sstable_vector = std::vector<shared_sstable>;
+
+    struct interval {
+        const dht::decorated_key* lower;
+        const dht::decorated_key* upper;
+        bool lower_closed;
+        bool upper_closed;
+        const sstable_vector* sstables;
+    };
+private:
+    struct boundary {
+        // The first or last key of one of the sstables in `at`.
+        const dht::decorated_key* key;
+        sstable_vector at;
+        sstable_vector after;
+    };
+    schema_ptr _schema;
+    std::vector<dht::token> _tokens;
+    std::vector<boundary> _boundaries;
+private:
+    std::strong_ordering compare(size_t i, dht::ring_position_view pos) const;
+    // Index of the first key not less than pos.
+    size_t lower_bound_key(dht::ring_position_view pos) const;
+    // Index of the key equal to dk, or of a new one inserted for it.
+    size_t ensure_boundary(const dht::decorated_key& dk);
+    void maybe_remove_boundary(size_t i, const shared_sstable& erased);
+    const sstable_vector& piece(size_t p) const;
+    // End (exclusive) of the interval starting at piece p.
+    size_t interval_end(size_t p) const;
+    size_t skip_empty(size_t p) const;
+public:
+    explicit sstable_interval_index(schema_ptr s) : _schema(std::move(s)) {}
+
+    void insert(const shared_sstable& sst);
+    void erase(const shared_sstable& sst);
+    // Appends to out, without duplicates, the sstables whose intervals
+    // overlap the closed interval between the positions of the range's
+    // bounds (inclusiveness of the bounds is ignored).
+    void select(const dht::partition_range& range, sstable_vector& out) const;
+
+    // Intervals are identified by the number of their first piece.
+    size_t begin() const { return skip_empty(0); }
+    size_t end() const { return 2 * _boundaries.size(); }
+    size_t next(size_t p) const { return skip_empty(interval_end(p)); }
+    // The first interval not entirely before pos.
+    size_t lower_bound(dht::ring_position_view pos) const;
+    interval get(size_t p) const;
+
+    size_t boundaries() const noexcept { return _boundaries.size(); }
+};
+
 // specialized when sstables are partitioned in the token range space
 // e.g. leveled compaction strategy
 class partitioned_sstable_set : public sstable_set_impl {
-    using value_set = std::unordered_set<shared_sstable>;
-    using interval_map_type = boost::icl::interval_map<dht::compatible_ring_position_or_view, value_set>;
-    using interval_type = interval_map_type::interval_type;
-    using map_iterator = interval_map_type::const_iterator;
+    using interval_type = sstable_interval_index::interval;
 private:
     schema_ptr _schema;
     std::vector<shared_sstable> _unleveled_sstables;
-    interval_map_type _leveled_sstables;
+    sstable_interval_index _leveled_sstables;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<run_id, shared_sstable_run> _all_runs;
     // Change counter on interval map for leveled sstables which is used by
@@ -36,16 +95,9 @@ class partitioned_sstable_set : public sstable_set_impl {
     // Token range spanned by the compaction group owning this sstable set.
     dht::token_range _token_range;
 private:
-    static interval_type make_interval(const schema& s, const dht::partition_range& range);
-    interval_type make_interval(const dht::partition_range& range) const;
-    static interval_type make_interval(const schema_ptr& s, const sstable& sst);
-    interval_type make_interval(const sstable& sst);
-    interval_type singular(const dht::ring_position& rp) const;
-    std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
 public:
-    static dht::ring_position to_ring_position(const dht::compatible_ring_position_or_view& crp);
     static dht::partition_range to_partition_range(const interval_type& i);
     static dht::partition_range to_partition_range(const dht::ring_position_view& pos, const interval_type& i);
 
@@ -55,7 +107,7 @@ class partitioned_sstable_set : public sstable_set_impl {
     explicit partitioned_sstable_set(
         schema_ptr schema,
         const std::vector<shared_sstable>& unleveled_sstables,
-        const interval_map_type& leveled_sstables,
+        const sstable_interval_index& leveled_sstables,
         const lw_shared_ptr<sstable_list>& all,
         const std::unordered_map<run_id, shared_sstable_run>& all_runs,
         dht::token_range token_range,
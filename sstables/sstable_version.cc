@@ -45,7 +45,8 @@ sstable_version_constants::component_map_t sstable_version_constants::create_com
         { component_type::Statistics, "Statistics.db" },
         { component_type::Scylla, "Scylla.db" },
         { component_type::TemporaryTOC, TEMPORARY_TOC_SUFFIX },
-        { component_type::TemporaryStatistics, "Statistics.db.tmp" }
+        { component_type::TemporaryStatistics, "Statistics.db.tmp" },
+        { component_type::TemporaryScylla, "Scylla.db.tmp" }
     };
 }
 
@@ -83,6 +84,7 @@ const sstable_version_constants::component_map_t sstable_version_constants_m::cr
     result.emplace(component_type::Index, "Index.db");
     result.emplace(component_type::Summary, "Summary.db");
     result.emplace(component_type::Digest, "Digest.crc32");
+    result.emplace(component_type::RowHashes, "RowHashes.db");
     return result;
 }
 
@@ -22,6 +22,7 @@
 #include <seastar/core/thread.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/align.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/coroutine/all.hh>
@@ -56,6 +57,7 @@
 #include "mutation/range_tombstone_list.hh"
 #include "binary_search.hh"
 #include "utils/bloom_filter.hh"
+#include "utils/xor_filter.hh"
 #include "utils/cached_file.hh"
 #include "utils/stall_free.hh"
 #include "utils/checked-file-impl.hh"
@@ -870,7 +872,7 @@ future<> sstable::read_toc() noexcept {
     }
 }
 
-void sstable::generate_toc() {
+void sstable::generate_toc(bool with_row_hashes) {
     // Creating table of components.
     _recognized_components.insert(component_type::TOC);
     _recognized_components.insert(component_type::Statistics);
@@ -878,6 +880,9 @@ void sstable::generate_toc() {
     if (has_summary_and_index(_version)) {
         _recognized_components.insert(component_type::Index);
         _recognized_components.insert(component_type::Summary);
+        if (with_row_hashes && row_hash_index_supported(*_schema)) {
+            _recognized_components.insert(component_type::RowHashes);
+        }
     } else {
         _recognized_components.insert(component_type::Partitions);
         _recognized_components.insert(component_type::Rows);
@@ -958,9 +963,9 @@ future<file_writer> sstable::make_component_file_writer(component_type c, file_o
         });
 }
 
-void sstable::open_sstable(const sstring& origin) {
+void sstable::open_sstable(const sstring& origin, bool with_row_hashes) {
     _origin = origin;
-    generate_toc();
+    generate_toc(with_row_hashes);
     _storage->open(*this);
 }
 
@@ -1352,6 +1357,18 @@ void sstable::rewrite_statistics() {
     sstable_write_io_check(rename_file, fmt::to_string(filename(component_type::TemporaryStatistics)), fmt::to_string(filename(component_type::Statistics))).get();
 }
 
+void sstable::rewrite_scylla_metadata() {
+    sstlog.debug("Rewriting scylla metadata component of sstable {}", get_filename());
+
+    file_output_stream_options options;
+    options.buffer_size = sstable_buffer_size;
+    auto w = make_component_file_writer(component_type::TemporaryScylla, std::move(options),
+            open_flags::wo | open_flags::create | open_flags::truncate).get();
+    write(_version, w, *_components->scylla_metadata);
+    w.close();
+    sstable_write_io_check(rename_file, fmt::to_string(filename(component_type::TemporaryScylla)), fmt::to_string(filename(component_type::Scylla))).get();
+}
+
 future<> sstable::read_summary() noexcept {
     if (_components->summary) {
         co_return;
@@ -1446,6 +1463,8 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
                                                             _manager.get_cache_tracker().get_lru(),
                                                             _manager.get_cache_tracker().region(),
                                                             _index_file_size);
+    _cached_index_file->set_refetch_cost(_index_refetch_cost);
+    _cached_index_file->set_owner_metrics(_table_index_file_cache_stats);
     _index_file = make_cached_seastar_file(*_cached_index_file);
   }
     if (_partitions_file) {
@@ -1459,6 +1478,8 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
             size,
             component_name(*this, component_type::Partitions).format()
         );
+        _cached_partitions_file->set_refetch_cost(_index_refetch_cost);
+        _cached_partitions_file->set_owner_metrics(_table_index_file_cache_stats);
         _partitions_file = make_cached_seastar_file(*_cached_partitions_file);
         co_await read_partitions_db_footer();
     }
@@ -1473,8 +1494,13 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
             size,
             component_name(*this, component_type::Rows).format()
         );
+        _cached_rows_file->set_refetch_cost(_index_refetch_cost);
+        _cached_rows_file->set_owner_metrics(_table_index_file_cache_stats);
         _rows_file = make_cached_seastar_file(*_cached_rows_file);
     }
+    if (has_component(component_type::RowHashes) && !_row_hash_index) {
+        co_await load_row_hash_index();
+    }
 
     this->set_min_max_position_range();
     this->set_first_and_last_keys();
@@ -1485,6 +1511,149 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
     if (cfg.load_first_and_last_position_metadata) {
         co_await load_first_and_last_position_in_partition();
     }
+
+    co_await maybe_pin_index();
+}
+
+// The row hash index only speeds up reads, so failing to load it
+// is not fatal. The reads use the promoted index instead.
+future<> sstable::load_row_hash_index() {
+    try {
+        _row_hashes_file = co_await open_file(component_type::RowHashes, open_flags::ro);
+        auto size = co_await _row_hashes_file.size();
+        auto cached_row_hashes_file = seastar::make_shared<cached_file>(
+            _row_hashes_file,
+            _manager.get_cache_tracker().get_index_cached_file_stats(),
+            _manager.get_cache_tracker().get_lru(),
+            _manager.get_cache_tracker().region(),
+            size,
+            component_name(*this, component_type::RowHashes).format()
+        );
+        cached_row_hashes_file->set_refetch_cost(_index_refetch_cost);
+        cached_row_hashes_file->set_owner_metrics(_table_index_file_cache_stats);
+        auto directory = co_await row_hash_index::read_directory(*cached_row_hashes_file);
+        _row_hash_index = std::make_unique<row_hash_index>(std::move(cached_row_hashes_file), std::move(directory));
+    } catch (...) {
+        sstlog.warn("Couldn't load row hash index {}: {}. Single row reads will use the promoted index.",
+                filename(component_type::RowHashes), std::current_exception());
+    }
+}
+
+cached_file* sstable::cached_partition_index_file() const noexcept {
+    return _cached_index_file ? _cached_index_file.get() : _cached_partitions_file.get();
+}
+
+future<> sstable::maybe_pin_index() {
+    auto* index_file = cached_partition_index_file();
+    // Readers don't go through the index page cache when index caching is disabled.
+    if (!index_file || !_schema->caching_options().pin_index() || !_manager.config().cache_index_pages()) {
+        co_return;
+    }
+    auto size = align_up(index_file->size(), uint64_t(cached_file::page_size));
+    if (!_manager.try_reserve_pinned_index_memory(size)) {
+        sstlog.debug("Not pinning the index of {} ({} bytes), the pinned index memory budget is exhausted", get_filename(), size);
+        co_return;
+    }
+    _pinned_index_memory = size;
+    std::exception_ptr ex;
+    try {
+        co_await index_file->pin();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        unpin_index();
+        sstlog.warn("Failed to pin the index of {}, it will be cached as usual: {}", get_filename(), ex);
+    }
+}
+
+void sstable::unpin_index() noexcept {
+    if (!_pinned_index_memory) {
+        return;
+    }
+    cached_partition_index_file()->unpin();
+    _manager.release_pinned_index_memory(_pinned_index_memory);
+    _pinned_index_memory = 0;
+}
+
+namespace {
+
+// Maps positions in Index.db to tokens and back, using the summary entries
+// as the sample points and interpolating linearly between them.
+class index_token_map {
+    const utils::chunked_vector<summary_entry>& _entries;
+    uint64_t _index_size;
+    uint64_t _last_token;
+
+    uint64_t token(size_t i) const noexcept {
+        return i < _entries.size() ? _entries[i].get_token().unbias() : _last_token;
+    }
+    uint64_t position(size_t i) const noexcept {
+        return i < _entries.size() ? _entries[i].position : _index_size;
+    }
+    static double fraction(uint64_t x, uint64_t from, uint64_t to) noexcept {
+        return to > from ? double(x - from) / double(to - from) : 0;
+    }
+public:
+    index_token_map(const summary& s, uint64_t index_size, dht::token last_token) noexcept
+        : _entries(s.entries)
+        , _index_size(index_size)
+        , _last_token(last_token.unbias())
+    { }
+
+    uint64_t token_at(uint64_t pos) const noexcept {
+        auto it = std::ranges::upper_bound(_entries, pos, std::less<>(), &summary_entry::position);
+        if (it == _entries.begin()) {
+            return token(0);
+        }
+        size_t i = std::distance(_entries.begin(), it) - 1;
+        auto f = std::min(fraction(pos, position(i), position(i + 1)), 1.0);
+        return token(i) + uint64_t(f * double(token(i + 1) - token(i)));
+    }
+
+    uint64_t position_of(uint64_t t) const noexcept {
+        auto it = std::ranges::upper_bound(_entries, t, std::less<>(), [] (const summary_entry& e) { return e.get_token().unbias(); });
+        if (it == _entries.begin()) {
+            return 0;
+        }
+        size_t i = std::distance(_entries.begin(), it) - 1;
+        auto f = std::min(fraction(t, token(i), std::max(token(i), token(i + 1))), 1.0);
+        return position(i) + uint64_t(f * double(position(i + 1) - position(i)));
+    }
+};
+
+}
+
+dht::token_range_vector sstable::cached_index_token_ranges() const {
+    dht::token_range_vector ranges;
+    if (!_cached_index_file || _components->summary.entries.empty()) {
+        return ranges;
+    }
+    index_token_map map(_components->summary, _cached_index_file->size(), get_last_decorated_key().token());
+    _cached_index_file->for_each_cached_page_run([&] (uint64_t first_page, uint64_t last_page) {
+        auto start = map.token_at(first_page * cached_file::page_size);
+        auto end = map.token_at((last_page + 1) * cached_file::page_size - 1);
+        ranges.push_back(dht::token_range::make(dht::token::bias(start), dht::token::bias(end)));
+    });
+    return ranges;
+}
+
+future<uint64_t> sstable::populate_index_cache(const dht::token_range_vector& ranges) {
+    if (!_cached_index_file || _components->summary.entries.empty() || !_manager.config().cache_index_pages()) {
+        co_return 0;
+    }
+    index_token_map map(_components->summary, _cached_index_file->size(), get_last_decorated_key().token());
+    auto sstable_range = dht::token_range::make(get_first_decorated_key().token(), get_last_decorated_key().token());
+    uint64_t populated = 0;
+    for (auto& r : ranges) {
+        if (!r.overlaps(sstable_range, dht::token_comparator())) {
+            continue;
+        }
+        auto from = r.start() ? map.position_of(r.start()->value().unbias()) : 0;
+        auto to = r.end() ? map.position_of(r.end()->value().unbias()) + 1 : _cached_index_file->size();
+        populated += co_await _cached_index_file->populate(from, to);
+    }
+    co_return populated;
 }
 
 future<> sstable::create_data() noexcept {
@@ -1507,16 +1676,29 @@ future<> sstable::drop_caches() {
     if (_cached_rows_file) {
         co_await _cached_rows_file->evict_gently();
     }
+    if (_row_hash_index) {
+        co_await _row_hash_index->evict_gently();
+    }
     co_await _index_cache->evict_gently();
 }
 
-// Return the filter format for the given sstable version
-static inline utils::filter_format get_filter_format(sstable_version_types version) {
+// Return the filter format for the given sstable version and features
+static inline utils::filter_format get_filter_format(sstable_version_types version, const sstable_enabled_features& features) {
+    if (features.is_enabled(XorFilter)) {
+        return utils::filter_format::xor_format;
+    }
+    if (features.is_enabled(SplitBlockBloomFilter)) {
+        return utils::filter_format::split_block_format;
+    }
     return (version >= sstable_version_types::mc)
                ? utils::filter_format::m_format
                : utils::filter_format::k_l_format;
 }
 
+utils::filter_format sstable::filter_format() const {
+    return get_filter_format(_version, _features);
+}
+
 future<> sstable::read_filter(sstable_open_config cfg) {
     if (!cfg.load_bloom_filter || !has_component(component_type::Filter)) {
         _components->filter = std::make_unique<utils::filter::always_present_filter>();
@@ -1528,7 +1710,7 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         read_simple<component_type::Filter>(filter).get();
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), filter_format());
     });
 }
 
@@ -1537,7 +1719,13 @@ void sstable::write_filter() {
         return;
     }
 
-    auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(_components->filter.get());
+    if (auto xf = dynamic_cast<utils::filter::xor_filter*>(_components->filter.get())) {
+        auto filter_ref = sstables::filter_ref(utils::filter::xor_filter::hash_count, xf->bits().get_storage());
+        write_simple<component_type::Filter>(filter_ref);
+        return;
+    }
+
+    auto f = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1557,9 +1745,9 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     // false positive rate.
     auto curr_bitset_size = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get())->bits().memory_size();
     auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 1.25);
+                                                                    _schema->bloom_filter_fp_chance() * 1.25, filter_format());
     auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 0.75);
+                                                                    _schema->bloom_filter_fp_chance() * 0.75, filter_format());
     if (bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound) {
         return;
     }
@@ -1571,7 +1759,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     //    - to avoid downsizing when the savings are minimal.
     //    - the fp rate is also already at least at the configured value, so no gain there.
     // 3. Do not resize filters of garbage_collected sstables.
-    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance());
+    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance(), filter_format());
     const auto filter_size_diff = std::abs<int64_t>(optimal_filter_size - curr_bitset_size);
     if (filter_size_diff < 1024 || filter_size_diff < 0.1 * curr_bitset_size || // [1]
             (curr_bitset_size > optimal_filter_size && curr_bitset_size < 16384) || // [2]
@@ -1590,7 +1778,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     };
 
     // Create a new filter that can optimally represent the given num_partitions.
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
+    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), filter_format());
     sstlog.info("Rebuilding bloom filter {}: resizing bitset from {} bytes to {} bytes. sstable origin: {}", filename(component_type::Filter), curr_bitset_size,
                 downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
 
@@ -1628,45 +1816,69 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
 }
 
 void sstable::build_delayed_filter(uint64_t num_partitions) {
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
-    sstlog.debug("Building delayed bloom filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
-        downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
-
     auto hashes_file = open_file(component_type::TemporaryHashes, open_flags::ro).get();
     auto hashes_file_closer = deferred_close(hashes_file);
     constexpr uint64_t murmur_hash_size_bytes = 16;
 
-    file_input_stream_options options = {
-        .buffer_size = sstable_buffer_size,
-        .read_ahead = 1,
+    auto for_each_hash = [&] (std::invocable<const utils::hashed_key&> auto&& func) {
+        file_input_stream_options options = {
+            .buffer_size = sstable_buffer_size,
+            .read_ahead = 1,
+        };
+        auto in = make_file_input_stream(hashes_file, 0, num_partitions * murmur_hash_size_bytes, options);
+        auto in_closer = deferred_close(in);
+
+        constexpr uint64_t batch_size_bytes = 4096;
+        static_assert(batch_size_bytes % murmur_hash_size_bytes == 0, "Batch size must be a multiple of hash size");
+
+        size_t processed_hashes = 0;
+        while (processed_hashes < num_partitions) {
+            auto buf = in.read_exactly(batch_size_bytes).get();
+            auto p = buf.get();
+            for (uint64_t offset = 0; offset + murmur_hash_size_bytes <= buf.size(); offset += murmur_hash_size_bytes) {
+                std::array<uint64_t, 2> hash;
+                std::memcpy(hash.data(), p + offset, sizeof(hash));
+                hash[0] = seastar::le_to_cpu(hash[0]);
+                hash[1] = seastar::le_to_cpu(hash[1]);
+                func(utils::hashed_key(hash));
+                processed_hashes++;
+            }
+            if (buf.size() < batch_size_bytes) {
+                break;
+            }
+        }
+        if (processed_hashes != num_partitions) {
+            throw malformed_sstable_exception(fmt::format("Temporary hashes file {} was supposed to contain {} hashes, but it contains only {} hashes",
+                filename(component_type::TemporaryHashes), num_partitions, processed_hashes));
+        }
     };
-    auto in = make_file_input_stream(hashes_file, 0, num_partitions * murmur_hash_size_bytes, options);
-    auto in_closer = deferred_close(in);
-
-    constexpr uint64_t batch_size_bytes = 4096;
-    static_assert(batch_size_bytes % murmur_hash_size_bytes == 0, "Batch size must be a multiple of hash size");
-
-    size_t processed_hashes = 0;
-    while (processed_hashes < num_partitions) {
-        auto buf = in.read_exactly(batch_size_bytes).get();
-        auto p = buf.get();
-        for (uint64_t offset = 0; offset + murmur_hash_size_bytes <= buf.size(); offset += murmur_hash_size_bytes) {
-            std::array<uint64_t, 2> hash;
-            std::memcpy(hash.data(), p + offset, sizeof(hash));
-            hash[0] = seastar::le_to_cpu(hash[0]);
-            hash[1] = seastar::le_to_cpu(hash[1]);
-            auto hashed_key = utils::hashed_key(hash);
-            optimal_filter->add(hashed_key);
-            processed_hashes++;
-        }
-        if (buf.size() < batch_size_bytes) {
-            break;
+
+    utils::filter_ptr optimal_filter;
+    if (filter_format() == utils::filter_format::xor_format) {
+        if (num_partitions && _schema->bloom_filter_fp_chance() < 1.0) {
+            utils::chunked_vector<uint64_t> keys;
+            keys.reserve(num_partitions);
+            for_each_hash([&] (const utils::hashed_key& hk) {
+                keys.push_back(utils::filter::xor_filter::key_of(hk));
+            });
+            optimal_filter = utils::filter::xor_filter::build(keys, _schema->bloom_filter_fp_chance());
+            if (!optimal_filter) {
+                sstlog.warn("Failed to build xor filter {} for {} partitions, falling back to a bloom filter", filename(component_type::Filter), num_partitions);
+            }
+        }
+        if (!optimal_filter) {
+            // Scylla.db is written after the filter, so it will record the fallback.
+            _features.disable(XorFilter);
         }
     }
-    if (processed_hashes != num_partitions) {
-        throw malformed_sstable_exception(fmt::format("Temporary hashes file {} was supposed to contain {} hashes, but it contains only {} hashes",
-            filename(component_type::TemporaryHashes), num_partitions, processed_hashes));
+    if (!optimal_filter) {
+        optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), filter_format());
+        for_each_hash([&] (const utils::hashed_key& hk) {
+            optimal_filter->add(hk);
+        });
     }
+    sstlog.debug("Built delayed filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
+        optimal_filter->memory_size(), _origin);
 
     _components->filter.swap(optimal_filter);
     unlink_component(component_type::TemporaryHashes).get();
@@ -2016,7 +2228,8 @@ static sstable_column_kind to_sstable_column_kind(column_kind k) {
 
 void
 sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
-        std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats) {
+        std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
+        scylla_metadata::tombstone_histograms tombstone_histograms) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
 
@@ -2070,6 +2283,9 @@ sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
 
         _components->scylla_metadata->data.set<scylla_metadata_type::ExtTimestampStats>(std::move(*ts_stats));
     }
+    if (!tombstone_histograms.elements.empty()) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::TombstoneHistograms>(std::move(tombstone_histograms));
+    }
 
     sstable_id sid;
     if (generation().is_uuid_based()) {
@@ -2506,6 +2722,19 @@ future<> delayed_commit_changes::commit() {
     });
 }
 
+// Returns the key of the only row read, if this is a single row read.
+static std::optional<clustering_key_prefix> get_single_row(const schema& s, const dht::partition_range& range,
+        const query::partition_slice& slice) {
+    if (!range.is_singular() || !range.start()->value().has_key()) {
+        return std::nullopt;
+    }
+    const auto& ranges = slice.row_ranges(s, *range.start()->value().key());
+    if (ranges.size() != 1 || !ranges.front().is_singular() || !ranges.front().start()->value().is_full(s)) {
+        return std::nullopt;
+    }
+    return ranges.front().start()->value();
+}
+
 mutation_reader
 sstable::make_reader(
         schema_ptr query_schema,
@@ -2522,7 +2751,13 @@ sstable::make_reader(
     const auto reversed = slice.is_reversed();
 
     auto index_caching = use_caching(global_cache_index_pages && !slice.options.contains(query::partition_slice::option::bypass_cache));
-    auto index_reader = make_index_reader(permit, trace_state, index_caching, range.is_singular());
+    // The row hash index doesn't support skipping to further clustering ranges,
+    // so only forward, non-forwardable single row reads use it.
+    std::optional<clustering_key_prefix> single_row;
+    if (_row_hash_index && !reversed && !fwd) {
+        single_row = get_single_row(*_schema, range, slice);
+    }
+    auto index_reader = make_index_reader(permit, trace_state, index_caching, range.is_singular(), std::move(single_row));
 
     if (_version >= version_types::mc && (!reversed || range.is_singular())) {
         return mx::make_reader(
@@ -2688,13 +2923,20 @@ component_type sstable::component_from_sstring(version_types v, const sstring &s
 
 future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
         reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw,
-        integrity_check integrity, integrity_error_handler error_handler) {
+        integrity_check integrity, integrity_error_handler error_handler, data_readahead_controller* readahead) {
     file_input_stream_options options;
-    options.buffer_size = sstable_buffer_size;
-    options.read_ahead = 4;
-    options.dynamic_adjustments = std::move(history);
+    if (readahead) {
+        options = readahead->stream_options(sstable_buffer_size, permit);
+    } else {
+        options.buffer_size = sstable_buffer_size;
+        options.read_ahead = 4;
+        options.dynamic_adjustments = std::move(history);
+    }
 
     file f = make_tracked_file(_data_file, permit);
+    if (readahead) {
+        f = readahead->wrap_file(std::move(f));
+    }
     if (trace_state) {
         f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()));
     }
@@ -3044,6 +3286,22 @@ future<> sstable::mutate_sstable_level(uint32_t new_level) {
     });
 }
 
+future<> sstable::mutate_run_identifier(run_id id) {
+    if (_run_identifier == id) {
+        return make_ready_future<>();
+    }
+    _run_identifier = id;
+    if (!_components->scylla_metadata) {
+        return make_ready_future<>();
+    }
+    _components->scylla_metadata->data.set<scylla_metadata_type::RunIdentifier>(run_identifier{id});
+    // The components may be hard links shared with another sstable, so
+    // the Scylla file must be replaced rather than written in place.
+    return seastar::async([this] {
+        rewrite_scylla_metadata();
+    });
+}
+
 int sstable::compare_by_max_timestamp(const sstable& other) const {
     auto ts1 = get_stats_metadata().max_timestamp;
     auto ts2 = other.get_stats_metadata().max_timestamp;
@@ -3051,6 +3309,7 @@ int sstable::compare_by_max_timestamp(const sstable& other) const {
 }
 
 future<> sstable::close_files() {
+    unpin_index();
     utils::small_vector<future<>, 4> close_futures;
     if (_index_file) {
         close_futures.push_back(_index_file.close().handle_exception([me = shared_from_this()] (auto ep) {
@@ -3076,6 +3335,12 @@ future<> sstable::close_files() {
             general_disk_error();
         }));
     }
+    if (_row_hashes_file) {
+        close_futures.push_back(_row_hashes_file.close().handle_exception([me = shared_from_this()] (auto ep) {
+            sstlog.warn("sstable close row_hashes_db failed: {}", ep);
+            general_disk_error();
+        }));
+    }
 
     auto unlinked = make_ready_future<>();
     if (_marked_for_deletion != mark_for_deletion::none) {
@@ -3487,6 +3752,8 @@ future<> init_metrics() {
 
         sm::make_gauge("bloom_filter_memory_size", [] { return utils::filter::bloom_filter::get_shard_stats().memory_size; },
             sm::description("Bloom filter memory usage in bytes.")),
+        sm::make_gauge("xor_filter_memory_size", [] { return utils::filter::xor_filter::get_shard_stats().memory_size; },
+            sm::description("XOR filter memory usage in bytes.")),
     });
   });
 }
@@ -3503,6 +3770,10 @@ mutation_source sstable::as_mutation_source() {
     });
 }
 
+// Index pages of sstables on object storage are that much more expensive
+// to read back than pages of local sstables.
+static constexpr unsigned object_storage_index_refetch_cost = 8;
+
 sstable::sstable(schema_ptr schema,
         const data_dictionary::storage_options& storage,
         generation_type generation,
@@ -3522,8 +3793,13 @@ sstable::sstable(schema_ptr schema,
     , _storage(make_storage(manager, storage, _state))
     , _version(v)
     , _format(f)
+    , _table_index_cache_stats(manager.find_partition_index_cache_stats(_schema->id()))
+    , _table_index_file_cache_stats(manager.find_index_file_cache_stats(_schema->id()))
+    , _table_data_readahead_stats(manager.find_data_readahead_stats(_schema->id()))
+    , _index_refetch_cost(storage.is_local_type() ? 1 : object_storage_index_refetch_cost)
     , _index_cache(std::make_unique<partition_index_cache>(
-            manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region(), manager.get_cache_tracker().get_partition_index_cache_stats()))
+            manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region(), manager.get_cache_tracker().get_partition_index_cache_stats(),
+            _table_index_cache_stats.get()))
     , _now(now)
     , _read_error_handler(error_handler_gen(sstable_read_error))
     , _write_error_handler(error_handler_gen(sstable_write_error))
@@ -3531,6 +3807,7 @@ sstable::sstable(schema_ptr schema,
     , _corrupt_data_handler(corrupt_data_handler)
     , _manager(manager)
 {
+    _index_cache->set_refetch_cost(_index_refetch_cost);
     manager.add(this);
 }
 
@@ -3633,7 +3910,8 @@ std::unique_ptr<abstract_index_reader> sstable::make_index_reader(
     reader_permit permit,
     tracing::trace_state_ptr trace_state,
     use_caching caching,
-    bool single_partition_read
+    bool single_partition_read,
+    std::optional<clustering_key_prefix> single_row
 ) {
     if (!_index_file) {
         if (!_partitions_db_footer) [[unlikely]] {
@@ -3669,7 +3947,7 @@ std::unique_ptr<abstract_index_reader> sstable::make_index_reader(
             std::move(trace_state)
         );
     }
-    return std::make_unique<index_reader>(shared_from_this(), std::move(permit), std::move(trace_state), caching, single_partition_read);
+    return std::make_unique<index_reader>(shared_from_this(), std::move(permit), std::move(trace_state), caching, single_partition_read, std::move(single_row));
 }
 
 // Returns error code, 0 is success
@@ -34,6 +34,9 @@
 #include "stats.hh"
 #include "utils/observable.hh"
 #include "sstables/shareable_components.hh"
+#include "sstables/partition_index_cache_stats.hh"
+#include "utils/cached_file_stats.hh"
+#include "sstables/data_readahead.hh"
 #include "sstables/storage.hh"
 #include "sstables/generation_type.hh"
 #include "sstables/types.hh"
@@ -100,6 +103,7 @@ class data_consume_context;
 
 class index_reader;
 class partition_index_cache;
+class row_hash_index;
 
 extern size_t summary_byte_cost(double summary_ratio);
 
@@ -116,6 +120,11 @@ struct sstable_writer_config {
     size_t summary_byte_cost;
     sstring origin;
     bool correct_pi_block_width = true;
+    bool split_block_bloom_filter = false;
+    // Whether tables with `sstable_filter = 'xor'` may get XOR filters.
+    bool xor_filter = false;
+    // Partitions at least this large get a row hash index, 0 disables it.
+    uint64_t row_hash_index_min_partition_size = 0;
 
 private:
     explicit sstable_writer_config() {}
@@ -380,6 +389,15 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     file uncached_index_file();
     file uncached_partitions_file();
     file uncached_rows_file();
+    // Returns the token ranges covered by the pages of the partition index
+    // which are in the index page cache. Tokens within a summary entry are
+    // assumed to be spread uniformly over its part of the index. Returns no
+    // ranges for sstables without a summary.
+    dht::token_range_vector cached_index_token_ranges() const;
+    // Reads the pages of the partition index which cover the given token
+    // ranges into the index page cache, see cached_index_token_ranges().
+    // Returns the number of bytes added to the cache.
+    future<uint64_t> populate_index_cache(const dht::token_range_vector& ranges);
     // Returns size of bloom filter data.
     uint64_t filter_size() const;
 
@@ -551,6 +569,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     std::optional<trie::bti_partitions_db_footer> _partitions_db_footer;
     file _rows_file;
     seastar::shared_ptr<cached_file> _cached_rows_file;
+    file _row_hashes_file;
+    std::unique_ptr<row_hash_index> _row_hash_index;
     uint64_t _data_file_size;
     uint64_t _index_file_size = 0;
     uint64_t _partitions_file_size = 0;
@@ -583,6 +603,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     const format_types _format;
 
     filter_tracker _filter_tracker;
+    // Index cache statistics of the table, shared by all of its sstables.
+    lw_shared_ptr<partition_index_cache_stats> _table_index_cache_stats;
+    // Index file page cache statistics of the table, shared by all of its sstables.
+    lw_shared_ptr<cached_file_stats> _table_index_file_cache_stats;
+    // Data file readahead statistics of the table, shared by all of its sstables.
+    lw_shared_ptr<data_readahead_stats> _table_data_readahead_stats;
+    // Relative cost of reading index pages back, depends on the storage.
+    unsigned _index_refetch_cost;
+    // Memory charged to sstables_manager for the pinned index.
+    size_t _pinned_index_memory = 0;
     std::unique_ptr<partition_index_cache> _index_cache;
 
     enum class mark_for_deletion {
@@ -660,8 +690,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<file_writer> make_component_file_writer(component_type c, file_output_stream_options options,
             open_flags oflags = open_flags::wo | open_flags::create | open_flags::exclusive) noexcept;
 
-    void generate_toc();
-    void open_sstable(const sstring& origin);
+    void generate_toc(bool with_row_hashes = false);
+    void open_sstable(const sstring& origin, bool with_row_hashes = false);
 
     future<> read_compression();
     void write_compression();
@@ -671,7 +701,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     void write_scylla_metadata(shard_id shard,
                                run_identifier identifier,
                                std::optional<scylla_metadata::large_data_stats> ld_stats,
-                               std::optional<scylla_metadata::ext_timestamp_stats> ts_stats);
+                               std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
+                               scylla_metadata::tombstone_histograms tombstone_histograms);
 
     future<> read_filter(sstable_open_config cfg = {});
 
@@ -686,6 +717,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> update_info_for_opened_data(sstable_open_config cfg = {});
 
+    // The partition index file (Index.db, or Partitions.db for BTI sstables).
+    cached_file* cached_partition_index_file() const noexcept;
+    // Loads the whole partition index into the index page cache and keeps
+    // it there, if the table has the pin_index caching option and the index
+    // fits in the pinned_index_memory_fraction budget. Otherwise the index is
+    // cached as usual.
+    future<> maybe_pin_index();
+    future<> load_row_hash_index();
+    void unpin_index() noexcept;
+
     future<> read_toc() noexcept;
     future<> read_summary() noexcept;
 
@@ -704,6 +745,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // Rewrite statistics component by creating a temporary Statistics and
     // renaming it into place of existing one.
     void rewrite_statistics();
+    // Rewrite scylla metadata component by creating a temporary Scylla and
+    // renaming it into place of existing one.
+    void rewrite_scylla_metadata();
     // Validate metadata that's used to optimize reads when user specifies
     // a clustering key range. If this specific metadata is incorrect, then
     // it should be cleared. Otherwise, it could lead to bad decisions.
@@ -767,11 +811,15 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // logic when a checksum or digest mismatch is detected on an
     // integrity-checked stream with no compression. The parameter is ignored
     // if integrity checking is disabled or the SSTable is compressed.
+    //
+    // When `readahead` is given, it controls the readahead of the stream
+    // instead of `history`, and counts the bytes read from the data file.
     using raw_stream = bool_class<class raw_stream_tag>;
     future<input_stream<char>> data_stream(uint64_t pos, size_t len,
             reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
             raw_stream raw = raw_stream::no, integrity_check integrity = integrity_check::no,
-            integrity_error_handler error_handler = throwing_integrity_error_handler);
+            integrity_error_handler error_handler = throwing_integrity_error_handler,
+            data_readahead_controller* readahead = nullptr);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -851,6 +899,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         _features = sef;
     }
 
+    // The format of the filter component, based on the version and features
+    // of this sstable.
+    utils::filter_format filter_format() const;
+
     bool has_feature(sstable_feature f) const {
         return features().is_enabled(f);
     }
@@ -883,6 +935,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _components->filter->is_present(key);
     }
 
+    void filter_prefetch(utils::hashed_key key) const {
+        _components->filter->prefetch(key);
+    }
+
     bool filter_has_key(const schema& s, partition_key_view key) const {
         return filter_has_key(key::from_partition_key(s, key));
     }
@@ -963,6 +1019,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return gc_clock::time_point(gc_clock::duration(get_stats_metadata().max_local_deletion_time));
     }
 
+    // Only valid for sstables of version mc and later.
+    gc_clock::time_point get_min_local_deletion_time() const {
+        return gc_clock::time_point(gc_clock::duration(get_stats_metadata().min_local_deletion_time));
+    }
+
     uint32_t get_sstable_level() const {
         return get_stats_metadata().sstable_level;
     }
@@ -982,6 +1043,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> mutate_sstable_level(uint32_t);
 
+    // Changes the run identifier, also in the Scylla component.
+    future<> mutate_run_identifier(run_id);
+
     const summary& get_summary() const {
         return _components->summary;
     }
@@ -1008,6 +1072,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _stats;
     }
 
+    data_readahead_stats& get_table_data_readahead_stats() noexcept {
+        return *_table_data_readahead_stats;
+    }
+
     bool has_correct_min_max_column_names() const noexcept {
         return _version >= sstable_version_types::md;
     }
@@ -1030,6 +1098,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // Some or all entries may be missing if not present in scylla_metadata
     scylla_metadata::ext_timestamp_stats::map_type get_ext_timestamp_stats() const noexcept;
 
+    // Return the histograms of the tombstones of the token ranges of the sstable,
+    // or nullptr if not present in scylla_metadata.
+    const scylla_metadata::tombstone_histograms* get_tombstone_histograms() const noexcept {
+        return _components->scylla_metadata ? _components->scylla_metadata->get_tombstone_histograms() : nullptr;
+    }
+
     const sstring& get_origin() const noexcept {
         return _origin;
     }
@@ -1060,7 +1134,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         reader_permit permit,
         tracing::trace_state_ptr trace_state = {},
         use_caching caching = use_caching::yes,
-        bool single_partition_read = false);
+        bool single_partition_read = false,
+        std::optional<clustering_key_prefix> single_row = {});
 
     // Allow the test cases from sstable_test.cc to test private methods. We use
     // a placeholder to avoid cluttering this class too much. The sstable_test class
@@ -1073,10 +1148,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     friend class sstables_manager;
     template <typename DataConsumeRowsContext>
     friend future<std::unique_ptr<DataConsumeRowsContext>>
-    data_consume_rows(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, uint64_t, integrity_check);
+    data_consume_rows(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, uint64_t, integrity_check, data_readahead_controller*);
     template <typename DataConsumeRowsContext>
     friend future<std::unique_ptr<DataConsumeRowsContext>>
-    data_consume_single_partition(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, integrity_check);
+    data_consume_single_partition(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, integrity_check, data_readahead_controller*);
     template <typename DataConsumeRowsContext>
     friend future<std::unique_ptr<DataConsumeRowsContext>>
     data_consume_rows(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, integrity_check);
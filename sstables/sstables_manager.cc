@@ -212,6 +212,53 @@ shared_sstable sstables_manager::make_sstable(schema_ptr schema,
     return make_lw_shared<sstable>(std::move(schema), storage, generation, state, v, f, get_large_data_handler(), get_corrupt_data_handler(), *this, now, std::move(error_handler_gen), buffer_size);
 }
 
+lw_shared_ptr<partition_index_cache_stats> sstables_manager::get_partition_index_cache_stats(table_id id) {
+    auto& stats = _partition_index_cache_stats[id];
+    if (!stats) {
+        stats = make_lw_shared<partition_index_cache_stats>();
+    }
+    return stats;
+}
+
+lw_shared_ptr<partition_index_cache_stats> sstables_manager::find_partition_index_cache_stats(table_id id) const {
+    auto it = _partition_index_cache_stats.find(id);
+    return it != _partition_index_cache_stats.end() ? it->second : make_lw_shared<partition_index_cache_stats>();
+}
+
+lw_shared_ptr<cached_file_stats> sstables_manager::get_index_file_cache_stats(table_id id) {
+    auto& stats = _index_file_cache_stats[id];
+    if (!stats) {
+        stats = make_lw_shared<cached_file_stats>();
+    }
+    return stats;
+}
+
+lw_shared_ptr<cached_file_stats> sstables_manager::find_index_file_cache_stats(table_id id) const {
+    auto it = _index_file_cache_stats.find(id);
+    return it != _index_file_cache_stats.end() ? it->second : make_lw_shared<cached_file_stats>();
+}
+
+lw_shared_ptr<data_readahead_stats> sstables_manager::get_data_readahead_stats(table_id id) {
+    auto& stats = _data_readahead_stats[id];
+    if (!stats) {
+        stats = make_lw_shared<data_readahead_stats>();
+    }
+    return stats;
+}
+
+lw_shared_ptr<data_readahead_stats> sstables_manager::find_data_readahead_stats(table_id id) const {
+    auto it = _data_readahead_stats.find(id);
+    return it != _data_readahead_stats.end() ? it->second : make_lw_shared<data_readahead_stats>();
+}
+
+bool sstables_manager::try_reserve_pinned_index_memory(size_t bytes) noexcept {
+    if (_pinned_index_memory + bytes > _available_memory * _db_config.pinned_index_memory_fraction()) {
+        return false;
+    }
+    _pinned_index_memory += bytes;
+    return true;
+}
+
 sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
     sstable_writer_config cfg;
 
@@ -224,6 +271,9 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.split_block_bloom_filter = _db_config.sstable_split_block_bloom_filter() && _features.split_block_bloom_filter;
+    cfg.xor_filter = _features.xor_sstable_filter;
+    cfg.row_hash_index_min_partition_size = uint64_t(_db_config.row_hash_index_min_partition_size_in_kb()) * 1024;
 
     cfg.origin = std::move(origin);
 
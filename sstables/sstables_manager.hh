@@ -143,6 +143,15 @@ class sstables_manager {
     named_gate _signal_gate;
     signal_type _signal_source;
 
+    // Index cache statistics of each table, see get_partition_index_cache_stats().
+    std::unordered_map<table_id, lw_shared_ptr<partition_index_cache_stats>> _partition_index_cache_stats;
+    // Index file page cache statistics of each table, see get_index_file_cache_stats().
+    std::unordered_map<table_id, lw_shared_ptr<cached_file_stats>> _index_file_cache_stats;
+    // Data file readahead statistics of each table, see get_data_readahead_stats().
+    std::unordered_map<table_id, lw_shared_ptr<data_readahead_stats>> _data_readahead_stats;
+    // Memory used by indexes pinned in memory, see sstable::maybe_pin_index().
+    size_t _pinned_index_memory = 0;
+
 public:
     explicit sstables_manager(
             sstring name,
@@ -184,6 +193,48 @@ class sstables_manager {
     const db::config& config() const { return _db_config; }
     cache_tracker& get_cache_tracker() { return _cache_tracker; }
 
+    // Returns the index cache statistics shared by the sstables of the given table.
+    // They are updated along with the shard-wide ones in the cache tracker.
+    // Called by the table, which reports them.
+    lw_shared_ptr<partition_index_cache_stats> get_partition_index_cache_stats(table_id id);
+    // Like get_partition_index_cache_stats(), but if the table has none, e.g. because
+    // it was dropped, returns statistics which are not shared nor remembered.
+    lw_shared_ptr<partition_index_cache_stats> find_partition_index_cache_stats(table_id id) const;
+    // Called when the table is dropped. Its sstables which are still alive
+    // keep updating their copy of the statistics.
+    void forget_partition_index_cache_stats(table_id id) noexcept {
+        _partition_index_cache_stats.erase(id);
+    }
+
+    // Returns the statistics of the cached index file pages (Index.db, Partitions.db,
+    // Rows.db and RowHashes.db) shared by the sstables of the given table.
+    lw_shared_ptr<cached_file_stats> get_index_file_cache_stats(table_id id);
+    // Like find_partition_index_cache_stats(), for the index file page statistics.
+    lw_shared_ptr<cached_file_stats> find_index_file_cache_stats(table_id id) const;
+    // Called when the table is dropped, like forget_partition_index_cache_stats().
+    void forget_index_file_cache_stats(table_id id) noexcept {
+        _index_file_cache_stats.erase(id);
+    }
+
+    // Returns the data file readahead statistics shared by the sstables of the given table.
+    lw_shared_ptr<data_readahead_stats> get_data_readahead_stats(table_id id);
+    // Like find_partition_index_cache_stats(), for the readahead statistics.
+    lw_shared_ptr<data_readahead_stats> find_data_readahead_stats(table_id id) const;
+    // Called when the table is dropped, like forget_partition_index_cache_stats().
+    void forget_data_readahead_stats(table_id id) noexcept {
+        _data_readahead_stats.erase(id);
+    }
+
+    // Charges memory of an index which is about to be pinned against the
+    // pinned_index_memory_fraction budget. Returns false if it doesn't fit.
+    bool try_reserve_pinned_index_memory(size_t bytes) noexcept;
+    void release_pinned_index_memory(size_t bytes) noexcept {
+        _pinned_index_memory -= bytes;
+    }
+    size_t pinned_index_memory() const noexcept {
+        return _pinned_index_memory;
+    }
+
     // Get the highest supported sstable version, according to cluster features.
     sstables::sstable::version_types get_highest_supported_format() const noexcept;
     // Get the preferred sstable version for writing new sstables,
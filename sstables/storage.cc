@@ -84,6 +84,7 @@ class filesystem_storage final : public sstables::storage {
 
     virtual future<> seal(const sstable& sst) override;
     virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const override;
+    virtual bool supports_snapshot() const noexcept override { return true; }
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -599,6 +600,7 @@ class object_storage_base : public sstables::storage {
 
     future<> seal(const sstable& sst) override;
     future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type>) const override;
+    bool supports_snapshot() const noexcept override { return false; }
     future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     void open(sstable& sst) override;
@@ -8,6 +8,7 @@
 
 #include "bti_node_reader.hh"
 #include "bti_node_type.hh"
+#include "utils/array-search.hh"
 
 namespace sstables::trie {
 
@@ -220,7 +221,7 @@ node_traverse_result bti_walk_down_along_key(int64_t pos, const_bytes sp, const_
     };
     auto sparse = [&] [[gnu::always_inline]] (int type) {
         int n_children = int(sp[1]);
-        auto idx = std::lower_bound(&sp[2], &sp[2 + n_children], key[0]) - &sp[2];
+        int idx = utils::array_search_sorted_ge(uint8_t(key[0]), reinterpret_cast<const uint8_t*>(&sp[2]), n_children);
         result.n_children = n_children;
         result.payload_bits = uint8_t(sp[0]) & 0xf;
         result.found_idx = idx;
@@ -501,7 +501,9 @@ enum sstable_feature : uint8_t {
     CorrectEmptyCounters = 4, // See #4363
     CorrectUDTsInCollections = 5, // See #6130
     CorrectLastPiBlockWidth = 6,
-    End = 7,
+    SplitBlockBloomFilter = 7, // Filter.db holds a utils::filter::split_block_bloom_filter
+    XorFilter = 8, // Filter.db holds a utils::filter::xor_filter
+    End = 9,
 };
 
 // Scylla-specific features enabled for a particular sstable.
@@ -547,6 +549,7 @@ enum class scylla_metadata_type : uint32_t {
     ExtTimestampStats = 9,
     SSTableIdentifier = 10,
     Schema = 11,
+    TombstoneHistograms = 12,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -635,6 +638,36 @@ struct sstable_schema_type {
     auto describe_type(sstable_version_types v, Describer f) { return f(id, version, keyspace_name, table_name, columns); }
 };
 
+struct tombstone_histogram_bin {
+    double deletion_time;
+    uint64_t count;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(deletion_time, count); }
+};
+
+// Statistics about the tombstones of the partitions of the sstable in one of
+// the tombstone_histogram_token_ranges equal ranges the token ring is divided
+// into. Only ranges with partitions are recorded.
+struct token_range_tombstone_histogram {
+    // Index of the range in the token ring.
+    uint32_t token_range;
+    // Tokens of the first and last partitions of the range with tombstones,
+    // or of all its partitions if none has tombstones.
+    int64_t first_token;
+    int64_t last_token;
+    // Number of cells in the partitions of the range.
+    uint64_t cells_count;
+    // Histogram of the deletion times of the tombstones, in the format of
+    // stats_metadata::estimated_tombstone_drop_time.
+    disk_array<uint32_t, tombstone_histogram_bin> histogram;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(token_range, first_token, last_token, cells_count, histogram); }
+};
+
+static constexpr unsigned tombstone_histogram_token_ranges = 16;
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
@@ -644,6 +677,7 @@ struct scylla_metadata {
     using ext_timestamp_stats = disk_hash<uint32_t, ext_timestamp_stats_type, int64_t>;
     using sstable_identifier = sstable_identifier_type;
     using sstable_schema = sstable_schema_type;
+    using tombstone_histograms = disk_array<uint32_t, token_range_tombstone_histogram>;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -656,7 +690,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExtTimestampStats, ext_timestamp_stats>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Schema, sstable_schema>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Schema, sstable_schema>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::TombstoneHistograms, tombstone_histograms>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -687,6 +722,9 @@ struct scylla_metadata {
     const ext_timestamp_stats* get_ext_timestamp_stats() const {
         return data.get<scylla_metadata_type::ExtTimestampStats, ext_timestamp_stats>();
     }
+    const tombstone_histograms* get_tombstone_histograms() const {
+        return data.get<scylla_metadata_type::TombstoneHistograms, tombstone_histograms>();
+    }
     sstable_id get_optional_sstable_identifier() const {
         auto* sid = data.get<scylla_metadata_type::SSTableIdentifier, scylla_metadata::sstable_identifier>();
         return sid ? sid->value : sstable_id::create_null_id();
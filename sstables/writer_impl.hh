@@ -11,6 +11,7 @@
 #include "sstable_writer.hh"
 #include "sstables_manager.hh"
 #include "schema/schema_fwd.hh"
+#include "db/sstable_filter_extension.hh"
 #include "mutation/mutation_fragment.hh"
 #include "metadata_collector.hh"
 #include "mutation/mutation_fragment_stream_validator.hh"
@@ -38,6 +39,12 @@ struct sstable_writer::writer_impl {
         if (!cfg.correct_pi_block_width) {
             _features.disable(CorrectLastPiBlockWidth);
         }
+        if (!cfg.split_block_bloom_filter) {
+            _features.disable(SplitBlockBloomFilter);
+        }
+        if (!cfg.xor_filter || schema.sstable_filter() != db::sstable_filter_type::xor_filter) {
+            _features.disable(XorFilter);
+        }
         sst.set_features(_features);
     }
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/array-search.hh"
+
+using search_fn = std::function<unsigned (uint8_t, const uint8_t*, unsigned)>;
+
+static std::vector<std::pair<std::string, search_fn>> sorted_ge_variants() {
+    std::vector<std::pair<std::string, search_fn>> ret;
+    ret.emplace_back("dispatched", utils::array_search_sorted_ge);
+    ret.emplace_back("scalar", utils::internal::array_search_sorted_ge_scalar);
+#ifdef __x86_64__
+    if (__builtin_cpu_supports("sse4.2")) {
+        ret.emplace_back("sse4.2", utils::internal::array_search_sorted_ge_sse42);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        ret.emplace_back("avx2", utils::internal::array_search_sorted_ge_avx2);
+    }
+#endif
+#ifdef __aarch64__
+    ret.emplace_back("neon", utils::internal::array_search_sorted_ge_neon);
+#endif
+    return ret;
+}
+
+// Checks every variant against std::lower_bound() for every value and every
+// prefix of the array, at every offset within a 32-byte vector, so that all
+// the unaligned heads and the tails shorter than a vector are covered.
+static void check_sorted_ge(const std::vector<uint8_t>& sorted) {
+    static constexpr unsigned max_offset = 32;
+    for (const auto& [name, search] : sorted_ge_variants()) {
+        for (unsigned offset = 0; offset < max_offset; ++offset) {
+            // Bytes past len are set to 0, which breaks the sort order,
+            // to catch variants which read past the end of the array.
+            std::vector<uint8_t> buf(offset + sorted.size() + max_offset, 0);
+            std::copy(sorted.begin(), sorted.end(), buf.begin() + offset);
+            const uint8_t* arr = buf.data() + offset;
+            for (unsigned len = 0; len <= sorted.size(); ++len) {
+                std::fill(buf.begin() + offset + len, buf.end(), 0);
+                for (unsigned val = 0; val <= 255; ++val) {
+                    unsigned expected = std::lower_bound(arr, arr + len, uint8_t(val)) - arr;
+                    unsigned actual = search(val, arr, len);
+                    if (actual != expected) {
+                        BOOST_FAIL(fmt::format("{}: val={} len={} offset={}: got {}, expected {}", name, val, len, offset, actual, expected));
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_array_search_sorted_ge_distinct) {
+    // Strictly increasing, every byte value present up to the length.
+    std::vector<uint8_t> sorted(256);
+    for (unsigned i = 0; i < sorted.size(); ++i) {
+        sorted[i] = i;
+    }
+    check_sorted_ge(sorted);
+}
+
+BOOST_AUTO_TEST_CASE(test_array_search_sorted_ge_sparse) {
+    // Values with gaps and the extremes, so that searches also end between
+    // elements and before the first one.
+    std::vector<uint8_t> sorted;
+    for (unsigned v = 1; v < 255; v += 3) {
+        sorted.push_back(v);
+    }
+    sorted.push_back(255);
+    check_sorted_ge(sorted);
+}
+
+BOOST_AUTO_TEST_CASE(test_array_search_sorted_ge_random) {
+    std::mt19937 rnd(std::random_device{}());
+    for (int i = 0; i < 4; ++i) {
+        std::vector<uint8_t> sorted(256);
+        std::uniform_int_distribution<unsigned> dist(0, 255);
+        std::ranges::generate(sorted, [&] { return dist(rnd); });
+        std::ranges::sort(sorted);
+        check_sorted_ge(sorted);
+    }
+}
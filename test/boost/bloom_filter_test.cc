@@ -16,10 +16,12 @@
 #include "test/lib/random_utils.hh"
 
 #include "db/config.hh"
+#include "db/sstable_filter_extension.hh"
 #include "readers/from_mutations.hh"
 #include "utils/bloom_filter.hh"
 #include "utils/error_injection.hh"
 #include "utils/i_filter.hh"
+#include "utils/xor_filter.hh"
 
 SEASTAR_TEST_CASE(test_sstable_reclaim_memory_from_components_and_reload_reclaimed_components) {
     return test_env::do_with_async([] (test_env& env) {
@@ -231,7 +233,7 @@ SEASTAR_TEST_CASE(test_bloom_filters_with_bad_partition_estimates) {
             if (!expect_rebuild && has_summary_and_index(version)) {
                 // Verify that the filter was not rebuilt
                 BOOST_REQUIRE_EQUAL(filter1->bits().memory_size(),
-                    utils::i_filter::get_filter_size(estimated_partition_count, schema->bloom_filter_fp_chance()));
+                    utils::i_filter::get_filter_size(estimated_partition_count, schema->bloom_filter_fp_chance(), utils::filter_format::m_format));
                 return;
             }
 
@@ -506,3 +508,140 @@ SEASTAR_TEST_CASE(test_rebuild_from_temporary_hashes) {
         }
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_bloom_filter) {
+    for (const double fp_chance : {0.1, 0.01, 0.001}) {
+        const int64_t n_elements = 20000;
+        auto filter = utils::i_filter::get_filter(n_elements, fp_chance, utils::filter_format::split_block_format);
+        auto* sbbf = dynamic_cast<utils::filter::split_block_bloom_filter*>(filter.get());
+        BOOST_REQUIRE(sbbf);
+        BOOST_REQUIRE_EQUAL(sbbf->bits().size() / 8,
+                utils::i_filter::get_filter_size(n_elements, fp_chance, utils::filter_format::split_block_format));
+
+        for (int64_t i = 0; i < n_elements; ++i) {
+            filter->add(utils::make_hashed_key(long_type->decompose(i)));
+        }
+        // No false negatives.
+        for (int64_t i = 0; i < n_elements; ++i) {
+            BOOST_REQUIRE(filter->is_present(utils::make_hashed_key(long_type->decompose(i))));
+        }
+        // The false positive rate is close to the requested one.
+        const int64_t n_probes = 200000;
+        int64_t false_positives = 0;
+        for (int64_t i = n_elements; i < n_elements + n_probes; ++i) {
+            false_positives += filter->is_present(utils::make_hashed_key(long_type->decompose(i)));
+        }
+        testlog.info("fp_chance={} bytes={} observed fp rate={}", fp_chance, filter->memory_size(), double(false_positives) / n_probes);
+        BOOST_REQUIRE_LT(double(false_positives) / n_probes, fp_chance * 1.5);
+    }
+}
+
+SEASTAR_TEST_CASE(test_split_block_bloom_filter_sstable) {
+    return test_env::do_with_async([] (test_env& env) {
+      for (const auto version : {sstable_version_types::me, sstable_version_types::ms}) {
+        simple_schema ss;
+        auto schema = ss.schema();
+        const auto partition_count = 1000;
+
+        utils::chunked_vector<mutation> mutations;
+        for (auto pk : ss.make_pkeys(partition_count)) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+
+        for (const bool split_block : {false, true}) {
+            env.manager().set_split_block_bloom_filter(split_block);
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                         env.manager().configure_writer(), version, partition_count);
+            BOOST_REQUIRE_EQUAL(sst->features().is_enabled(sstables::SplitBlockBloomFilter), split_block);
+
+            // The filter format survives a round trip through Filter.db.
+            sst = env.reusable_sst(sst).get();
+            BOOST_REQUIRE_EQUAL(sst->features().is_enabled(sstables::SplitBlockBloomFilter), split_block);
+            auto* filter = sstables::test(sst).get_filter().get();
+            BOOST_REQUIRE_EQUAL(bool(dynamic_cast<utils::filter::split_block_bloom_filter*>(filter)), split_block);
+            for (const auto& mut : mutations) {
+                BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, mut.key())));
+            }
+        }
+      }
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_xor_filter) {
+    BOOST_REQUIRE(!utils::filter::xor_filter::build({}, 0.01));
+
+    for (const double fp_chance : {0.1, 0.01, 0.001}) {
+        const int64_t n_elements = 20000;
+        utils::chunked_vector<uint64_t> keys;
+        for (int64_t i = 0; i < n_elements; ++i) {
+            keys.push_back(utils::filter::xor_filter::key_of(utils::make_hashed_key(long_type->decompose(i))));
+        }
+        // Duplicated keys are tolerated.
+        keys.push_back(keys.front());
+        auto filter = utils::filter::xor_filter::build(keys, fp_chance);
+        BOOST_REQUIRE(filter);
+        BOOST_REQUIRE_LE(filter->bits().size(), utils::filter::xor_filter::get_bitset_size(n_elements + 1, fp_chance));
+
+        // No false negatives, also after a round trip through the bitset.
+        auto loaded = utils::filter::create_filter(utils::filter::xor_filter::hash_count,
+                large_bitset(filter->bits().size(), utils::chunked_vector<uint64_t>(filter->bits().get_storage())),
+                utils::filter_format::xor_format);
+        for (int64_t i = 0; i < n_elements; ++i) {
+            BOOST_REQUIRE(filter->is_present(utils::make_hashed_key(long_type->decompose(i))));
+            BOOST_REQUIRE(loaded->is_present(utils::make_hashed_key(long_type->decompose(i))));
+        }
+        // The false positive rate is close to the requested one.
+        const int64_t n_probes = 200000;
+        int64_t false_positives = 0;
+        for (int64_t i = n_elements; i < n_elements + n_probes; ++i) {
+            false_positives += loaded->is_present(utils::make_hashed_key(long_type->decompose(i)));
+        }
+        testlog.info("fp_chance={} bytes={} observed fp rate={}", fp_chance, filter->memory_size(), double(false_positives) / n_probes);
+        BOOST_REQUIRE_LT(double(false_positives) / n_probes, fp_chance * 1.5);
+
+        // A cleared filter fails open.
+        loaded->clear();
+        BOOST_REQUIRE(loaded->is_present(utils::make_hashed_key(long_type->decompose(int64_t(0)))));
+        BOOST_REQUIRE(loaded->is_present(utils::make_hashed_key(long_type->decompose(int64_t(n_elements)))));
+    }
+}
+
+SEASTAR_TEST_CASE(test_xor_filter_sstable) {
+    return test_env::do_with_async([] (test_env& env) {
+      for (const auto version : {sstable_version_types::me, sstable_version_types::ms}) {
+        simple_schema ss;
+        const auto partition_count = 1000;
+
+        for (const auto filter_type : {db::sstable_filter_type::bloom, db::sstable_filter_type::xor_filter}) {
+          for (const bool enabled : {false, true}) {
+            auto schema = schema_builder(ss.schema()).with_sstable_filter(filter_type).build();
+            const bool expect_xor = enabled && filter_type == db::sstable_filter_type::xor_filter;
+
+            utils::chunked_vector<mutation> mutations;
+            for (auto pk : ss.make_pkeys(partition_count)) {
+                auto mut = mutation(schema, pk);
+                mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+                mutations.push_back(std::move(mut));
+            }
+
+            env.manager().set_xor_filter(enabled);
+            // Deliberately bad estimate, the XOR filter is sized from the actual key count.
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                         env.manager().configure_writer(), version, partition_count / 10);
+            BOOST_REQUIRE_EQUAL(sst->features().is_enabled(sstables::XorFilter), expect_xor);
+
+            // The filter format survives a round trip through Filter.db.
+            sst = env.reusable_sst(sst).get();
+            BOOST_REQUIRE_EQUAL(sst->features().is_enabled(sstables::XorFilter), expect_xor);
+            auto* filter = sstables::test(sst).get_filter().get();
+            BOOST_REQUIRE_EQUAL(bool(dynamic_cast<utils::filter::xor_filter*>(filter)), expect_xor);
+            for (const auto& mut : mutations) {
+                BOOST_REQUIRE(sst->filter_has_key(sstables::key::from_partition_key(*schema, mut.key())));
+            }
+          }
+        }
+      }
+    });
+}
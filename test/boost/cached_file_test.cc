@@ -280,6 +280,110 @@ SEASTAR_THREAD_TEST_CASE(test_eviction_via_lru) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_owner_metrics) {
+    auto page = cached_file::page_size;
+    test_file tf = make_test_file(page * 2 + 12);
+
+    {
+        cached_file_stats metrics;
+        auto owner_metrics = make_lw_shared<cached_file_stats>();
+        logalloc::region region;
+        cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size());
+        cf.set_owner_metrics(owner_metrics);
+
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+
+        BOOST_REQUIRE_EQUAL(page * 3, owner_metrics->cached_bytes);
+        BOOST_REQUIRE_EQUAL(3, owner_metrics->page_misses);
+        BOOST_REQUIRE_EQUAL(3, owner_metrics->page_hits);
+        BOOST_REQUIRE_EQUAL(3, owner_metrics->page_populations);
+        BOOST_REQUIRE_EQUAL(0, owner_metrics->page_evictions);
+
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+
+        BOOST_REQUIRE_EQUAL(0, owner_metrics->cached_bytes);
+        BOOST_REQUIRE_EQUAL(3, owner_metrics->page_evictions);
+        BOOST_REQUIRE_EQUAL(metrics.page_evictions, owner_metrics->page_evictions);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pinned_pages_are_not_evicted) {
+    auto page = cached_file::page_size;
+    auto file_size = page * 2 + 12;
+    test_file tf = make_test_file(file_size);
+
+    {
+        cached_file_stats metrics;
+        logalloc::region region;
+        cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size());
+
+        auto pinned = cf.pin().get();
+        BOOST_REQUIRE_GT(pinned, 0);
+        BOOST_REQUIRE_EQUAL(pinned, cf.pinned_bytes());
+        BOOST_REQUIRE_EQUAL(page * 3, cf.cached_bytes());
+        BOOST_REQUIRE_EQUAL(3, metrics.page_misses);
+
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+
+        BOOST_REQUIRE_EQUAL(page * 3, cf.cached_bytes());
+        BOOST_REQUIRE_EQUAL(0, metrics.page_evictions);
+
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+        BOOST_REQUIRE_EQUAL(3, metrics.page_misses);
+
+        // Pinning again is a no-op.
+        BOOST_REQUIRE_EQUAL(pinned, cf.pin().get());
+        BOOST_REQUIRE_EQUAL(3, metrics.page_misses);
+
+        cf.unpin();
+        BOOST_REQUIRE_EQUAL(0, cf.pinned_bytes());
+
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+
+        BOOST_REQUIRE_EQUAL(0, cf.cached_bytes());
+        BOOST_REQUIRE_EQUAL(3, metrics.page_evictions);
+        BOOST_REQUIRE_EQUAL(region.occupancy().used_space(), 0);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_populate) {
+    auto page = cached_file::page_size;
+    auto file_size = page * 4 + 12;
+    test_file tf = make_test_file(file_size);
+
+    {
+        cached_file_stats metrics;
+        logalloc::region region;
+        cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size());
+
+        BOOST_REQUIRE_EQUAL(0, cf.populate(page, page).get());
+        BOOST_REQUIRE_EQUAL(page * 2, cf.populate(page + 1, page * 2 + 1).get());
+        BOOST_REQUIRE_EQUAL(page * 2, cf.cached_bytes());
+
+        // Already cached pages are not counted.
+        BOOST_REQUIRE_EQUAL(page * 3, cf.populate(0, file_size * 2).get());
+        BOOST_REQUIRE_EQUAL(page * 5, cf.cached_bytes());
+        BOOST_REQUIRE_EQUAL(0, metrics.page_hits);
+
+        BOOST_REQUIRE_EQUAL(2, metrics.page_misses);
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+        BOOST_REQUIRE_EQUAL(2, metrics.page_misses);
+
+        // Populated pages are evictable.
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+        BOOST_REQUIRE_EQUAL(0, cf.cached_bytes());
+    }
+}
+
 // A file which serves garbage but is very fast.
 class garbage_file_impl : public file_impl {
 private:
@@ -315,6 +419,33 @@ class garbage_file_impl : public file_impl {
 };
 
 #ifndef SEASTAR_DEFAULT_ALLOCATOR // Eviction works only with the seastar allocator
+SEASTAR_THREAD_TEST_CASE(test_cached_page_runs) {
+    auto page = cached_file::page_size;
+    test_file tf = make_test_file(page * 6);
+
+    {
+        cached_file_stats metrics;
+        logalloc::region region;
+        cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size());
+
+        auto runs = [&] {
+            std::vector<std::pair<uint64_t, uint64_t>> ret;
+            cf.for_each_cached_page_run([&] (uint64_t first, uint64_t last) {
+                ret.emplace_back(first, last);
+            });
+            return ret;
+        };
+        BOOST_REQUIRE(runs().empty());
+
+        cf.populate(page, page * 3).get();
+        cf.populate(page * 4, page * 4 + 1).get();
+        BOOST_REQUIRE(runs() == (std::vector<std::pair<uint64_t, uint64_t>>{{1, 2}, {4, 4}}));
+
+        cf.populate(page * 3, page * 4).get();
+        BOOST_REQUIRE(runs() == (std::vector<std::pair<uint64_t, uint64_t>>{{1, 4}}));
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_stress_eviction) {
     auto page_size = cached_file::page_size;
     auto n_pages = 8'000'000 / page_size;
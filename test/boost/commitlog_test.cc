@@ -109,6 +109,31 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_batch){
         });
 }
 
+// check that batch mode writes done within a group commit window share a flush
+SEASTAR_TEST_CASE(test_commitlog_group_commit_batch){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    cfg.commitlog_group_commit_window_in_us = 50000;
+    auto window = std::chrono::microseconds(cfg.commitlog_group_commit_window_in_us);
+    return cl_test(cfg, [window] (commitlog& log) -> future<> {
+        auto uuid = make_table_id();
+        sstring tmp = "hej bubba cow";
+        auto window_of = [window] {
+            return uint64_t(std::chrono::steady_clock::now().time_since_epoch() / window);
+        };
+        auto first_window = window_of();
+        co_await parallel_for_each(std::views::iota(0, 10), [&] (int) {
+            return log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [&tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            }).discard_result();
+        });
+        // Flushes happen at the ends of windows, one per window at most.
+        auto n = log.get_flush_count();
+        BOOST_REQUIRE_GT(n, 0);
+        BOOST_REQUIRE_LE(n, window_of() - first_window);
+    });
+}
+
 // check that an entry marked as sync is immediately flushed to a storage
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_sync){
     commitlog::config cfg;
@@ -627,6 +652,60 @@ SEASTAR_TEST_CASE(test_commitlog_chunk_corruption3){
     });
 }
 
+// Like test_commitlog_chunk_corruption3, but the data left over from the
+// previous use of a preallocated file is not mistaken for a truncation.
+SEASTAR_TEST_CASE(test_commitlog_recycled_preallocated_segment){
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.commitlog_total_space_in_mb = 2 * smp::count;
+    cfg.allow_going_over_size_limit = false;
+    cfg.preallocate_segments = true;
+
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        auto uuid = make_table_id();
+        sstring tmp = "hej bubba cow";
+
+        std::optional<db::segment_id_type> last;
+        db::replay_position last_rp;
+
+        int n = 0;
+
+        for (;;) {
+            auto h = co_await log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [&](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            });
+            auto id = h.rp().id;
+
+            if (last && last != id) {
+                // this should mean we are in a recycled segment.
+                if (++n > 3) {
+                    last_rp = h.release(); // prevent removal for now.
+                    break;
+                }
+            }
+            last = id;
+        }
+
+        co_await log.sync_all_segments();
+
+        for (auto& seg : log.get_active_segment_names()) {
+            auto desc = commitlog::descriptor(seg);
+            if (desc.id == last_rp.id) {
+                bool found = false;
+                co_await db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                    BOOST_CHECK_LE(buf_rp.position, last_rp);
+                    found |= buf_rp.position == last_rp;
+                    return make_ready_future<>();
+                });
+                BOOST_REQUIRE(found);
+                co_return;
+            }
+        }
+
+        BOOST_FAIL("Did not find segment");
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_replay_single_large_mutation){
     commitlog::config cfg;
     cfg.commitlog_segment_size_in_mb = 4;
@@ -1107,6 +1186,79 @@ SEASTAR_TEST_CASE(test_commitlog_add_entries) {
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_compression) {
+    static auto make_entry = [] (int i) {
+        sstring res;
+        while (res.size() < 4096) {
+            res += fmt::format("hej bubba cow {} ", i);
+        }
+        return res;
+    };
+    // trained dictionaries are just a bag of common substrings.
+    static const auto dict = [] {
+        auto s = make_entry(4711);
+        auto bytes = std::as_bytes(std::span(s.data(), s.size()));
+        return std::vector<std::byte>(bytes.begin(), bytes.end());
+    }();
+
+    for (auto compression : { commitlog::compression_type::lz4, commitlog::compression_type::zstd }) {
+        for (bool with_dict : { false, true }) {
+            commitlog::config cfg;
+            cfg.commitlog_segment_size_in_mb = 1;
+            cfg.compression = compression;
+
+            co_await cl_test(cfg, [with_dict](commitlog& log) -> future<> {
+                if (with_dict) {
+                    log.set_compression_dictionary(dict);
+                    co_await log.force_new_active_segment();
+                }
+                auto uuid = make_table_id();
+                std::vector<replay_position> rps;
+                std::vector<sstring> entries;
+                // a small entry, which is not compressed, followed by large ones
+                // in separate chunks.
+                entries.emplace_back("hej bubba cow");
+                for (int i = 0; i < 3; ++i) {
+                    entries.emplace_back(make_entry(i));
+                }
+                for (auto& e : entries) {
+                    auto h = co_await log.add_mutation(uuid, e.size(), db::commitlog::force_sync::no, [&e](db::commitlog::output& dst) {
+                        dst.write(e.data(), e.size());
+                    });
+                    rps.emplace_back(h.release());
+                    co_await log.sync_all_segments();
+                }
+
+                BOOST_REQUIRE(std::ranges::all_of(rps, [&](auto& rp) { return rp.id == rps.front().id; }));
+                BOOST_REQUIRE_LT(log.get_compression_output_bytes(), log.get_compression_input_bytes() / 4);
+
+                auto segments = log.get_active_segment_names();
+                auto i = std::ranges::find_if(segments, [&](const sstring& seg) {
+                    return commitlog::descriptor(seg).id == rps.front().id;
+                });
+                BOOST_REQUIRE(i != segments.end());
+
+                // Read all, and from the last entry, which skips the chunk holding the dictionary.
+                for (auto first : { size_t(0), rps.size() - 1 }) {
+                    size_t n = first;
+                    co_await db::commitlog::read_log_file(*i, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                        auto&& [buf, rp] = buf_rp;
+                        BOOST_REQUIRE_LT(n, entries.size());
+                        BOOST_CHECK_EQUAL(rp, rps[n]);
+                        auto linearization_buffer = bytes_ostream();
+                        auto in = buf.get_istream();
+                        auto str = to_string_view(in.read_bytes_view(buf.size_bytes(), linearization_buffer).value());
+                        BOOST_CHECK_EQUAL(str, std::string_view(entries[n]));
+                        ++n;
+                        return make_ready_future<>();
+                    }, rps[first].pos);
+                    BOOST_CHECK_EQUAL(n, entries.size());
+                }
+            });
+        }
+    }
+}
+
 // #16298 - check entry offsets so that we report the correct file positions both
 // when reading and writing CL data.
 SEASTAR_TEST_CASE(test_commitlog_entry_offsets) {
@@ -1224,6 +1376,48 @@ SEASTAR_TEST_CASE(test_commitlog_new_segment_odsync){
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_preallocate_segments){
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.use_o_dsync = false;
+    cfg.preallocate_segments = true;
+    cfg.warn_about_segments_left_on_disk_after_shutdown = false;
+
+    tmpdir tmp;
+    cfg.commit_log_location = tmp.path().string();
+    auto log = co_await commitlog::create_commitlog(cfg);
+
+    auto uuid = make_table_id();
+    rp_set set;
+    size_t count = 0;
+    while (set.size() <= 1) {
+        sstring tmp = "hej bubba cow";
+        rp_handle h = co_await log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [tmp](db::commitlog::output& dst) {
+            dst.write(tmp.data(), tmp.size());
+        });
+        set.put(std::move(h));
+        ++count;
+    }
+
+    auto names = log.get_active_segment_names();
+    BOOST_REQUIRE(names.size() > 1);
+
+    co_await log.shutdown();
+
+    // Segments left on disk are not truncated, and still replay all entries.
+    size_t replayed = 0;
+    for (auto& name : names) {
+        BOOST_CHECK_EQUAL(co_await file_size(name), 1024u*1024u);
+        co_await db::commitlog::read_log_file(name, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+            ++replayed;
+            return make_ready_future<>();
+        });
+    }
+    BOOST_CHECK_EQUAL(replayed, count);
+
+    co_await log.clear();
+}
+
 // Test for #8363
 // try to provoke edge case where we race segment deletion
 // and waiting for recycled to be replenished.
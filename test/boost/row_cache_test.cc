@@ -1913,6 +1913,191 @@ SEASTAR_TEST_CASE(test_lru) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_lru_add_before_probation) {
+    struct test_evictable final : public evictable {
+        int id;
+        std::vector<int>& evicted;
+        test_evictable(int id, std::vector<int>& evicted) : id(id), evicted(evicted) {}
+        virtual void on_evicted() noexcept override {
+            evicted.push_back(id);
+        }
+    };
+    std::vector<int> evicted;
+    test_evictable on_probation(0, evicted), main(1, evicted), before_probation(2, evicted), before_main(3, evicted);
+
+    lru l;
+    l.add_probation(on_probation);
+    l.add(main);
+    // Entries added before an anchor end up in the anchor's list.
+    l.add_before(on_probation, before_probation);
+    l.add_before(main, before_main);
+    l.evict_all();
+    BOOST_REQUIRE_EQUAL(evicted, (std::vector<int>{2, 0, 3, 1}));
+}
+
+SEASTAR_TEST_CASE(test_lru_admission_filter) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto cache_mt = make_lw_shared<replica::memtable>(s);
+
+        int partition_count = 10;
+        utils::chunked_vector<mutation> partitions = make_ring(s, partition_count);
+        for (auto&& m : partitions) {
+            cache_mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        tracker.set_admission_filter(utils::updateable_value<bool>(true));
+        row_cache cache(s, snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        auto read = [&] (int i) {
+            auto pr = dht::partition_range::make_singular(partitions[i].decorated_key());
+            assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+                    .produces(partitions[i])
+                    .produces_end_of_stream();
+        };
+
+        // Frequently read partitions.
+        for (int n = 0; n < 3; ++n) {
+            for (int i = 0; i < 3; ++i) {
+                read(i);
+            }
+        }
+
+        // A scan reads the remaining ones once, they go on probation.
+        auto pr = dht::partition_range::make_starting_with(dht::ring_position(partitions[3].decorated_key()));
+        auto rd = assert_that(cache.make_reader(s, semaphore.make_permit(), pr));
+        for (int i = 3; i < partition_count; ++i) {
+            rd.produces(partitions[i]);
+        }
+        rd.produces_end_of_stream();
+        BOOST_REQUIRE_GT(tracker.get_stats().row_probation_insertions, 0);
+
+        // Although read last, the scanned partitions are evicted first.
+        for (int i = 3; i < partition_count; ++i) {
+            evict_one_partition(tracker);
+        }
+        auto misses = tracker.get_stats().partition_misses;
+        for (int i = 0; i < 3; ++i) {
+            read(i);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses);
+    });
+}
+
+SEASTAR_TEST_CASE(test_lru_scan_detection) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto cache_mt = make_lw_shared<replica::memtable>(s);
+
+        int partition_count = 10;
+        utils::chunked_vector<mutation> partitions = make_ring(s, partition_count);
+        for (auto&& m : partitions) {
+            cache_mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        tracker.set_scan_detection_threshold(utils::updateable_value<uint32_t>(2));
+        row_cache cache(s, snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        auto read = [&] (int i) {
+            auto pr = dht::partition_range::make_singular(partitions[i].decorated_key());
+            assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+                    .produces(partitions[i])
+                    .produces_end_of_stream();
+        };
+
+        for (int i = 0; i < 3; ++i) {
+            read(i);
+        }
+        BOOST_REQUIRE_EQUAL(cache.stats().scan_probation_insertions, 0);
+
+        // Past the threshold, the scan populates cache on probation.
+        assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+                .produces(partitions)
+                .produces_end_of_stream();
+        BOOST_REQUIRE_GT(cache.stats().scan_probation_insertions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, partition_count);
+
+        // The partitions populated by the scan are evicted first.
+        for (int i = 3; i < partition_count; ++i) {
+            evict_one_partition(tracker);
+        }
+        auto misses = tracker.get_stats().partition_misses;
+        for (int i = 0; i < 3; ++i) {
+            read(i);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cold_tier) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        utils::chunked_vector<mutation> partitions;
+        for (auto&& m : make_ring(s, 3)) {
+            partitions.push_back(make_fully_continuous(m));
+            underlying.apply(m);
+        }
+
+        cache_tracker tracker;
+        tracker.set_cold_tier_fraction(utils::updateable_value<double>(0.1));
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+        for (auto&& m : partitions) {
+            cache.populate(m);
+        }
+
+        auto read = [&] (const mutation& m) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+                    .produces(m)
+                    .produces_end_of_stream();
+        };
+        auto& stats = tracker.cold_tier().get_stats();
+
+        // The partition populated first is at the tail of the LRU.
+        BOOST_REQUIRE_EQUAL(tracker.demote_some(1), 1);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), 2);
+        BOOST_REQUIRE_EQUAL(stats.insertions, 1);
+        BOOST_REQUIRE_EQUAL(stats.partitions, 1);
+
+        // Read back into cache without going to the underlying source.
+        auto misses = tracker.get_stats().partition_misses;
+        read(partitions[0]);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses);
+        BOOST_REQUIRE_EQUAL(stats.hits, 1);
+        BOOST_REQUIRE_EQUAL(stats.partitions, 0);
+
+        // Partitions which are being invalidated are not demoted.
+        {
+            dht::partition_range_vector ranges{dht::partition_range::make_singular(partitions[1].decorated_key())};
+            cache::cold_tier::invalidation_fence fence(tracker.cold_tier(), s->id(), ranges);
+            BOOST_REQUIRE_EQUAL(tracker.demote_some(1), 1);
+            BOOST_REQUIRE_EQUAL(stats.insertions, 2);
+            BOOST_REQUIRE_EQUAL(stats.partitions, 1);
+        }
+        read(partitions[2]);
+        BOOST_REQUIRE_EQUAL(stats.hits, 2);
+
+        // An update of a demoted partition drops it from the cold tier.
+        BOOST_REQUIRE_EQUAL(tracker.demote_some(1), 1);
+        BOOST_REQUIRE_EQUAL(stats.insertions, 3);
+        auto m2 = make_new_mutation(s, partitions[1].key());
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m2);
+        cache.update(row_cache::external_updater([&] { underlying.apply(m2); }), *mt).get();
+        BOOST_REQUIRE_EQUAL(stats.invalidations, 1);
+        BOOST_REQUIRE_EQUAL(stats.partitions, 0);
+        read(partitions[1] + m2);
+        BOOST_REQUIRE_EQUAL(stats.hits, 2);
+    });
+}
+
 SEASTAR_TEST_CASE(test_update_invalidating) {
     return seastar::async([] {
         simple_schema s;
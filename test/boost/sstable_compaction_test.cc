@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
  */
 
+#include <bit>
 #include <iterator>
 #include <fmt/ranges.h>
 #include <seastar/core/sstring.hh>
@@ -13,6 +14,7 @@
 #include <seastar/core/align.hh>
 #include <seastar/core/aligned_buffer.hh>
 #include <seastar/util/closeable.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/short_streams.hh>
 #include <seastar/core/coroutine.hh>
 
@@ -4918,6 +4920,71 @@ SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     });
 }
 
+// Clustering range pruning of single key reads applies to any compaction strategy.
+SEASTAR_TEST_CASE(test_stcs_single_key_reader_clustering_filtering) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "stcs_single_key_reader_clustering_filtering")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(compaction::compaction_strategy_type::size_tiered);
+        auto s = builder.build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_row = [&] (int32_t pk, int32_t ck) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), to_bytes("v"), int32_t(0), api::new_timestamp());
+            return m;
+        };
+
+        std::vector<sstables::shared_sstable> ssts;
+        for (int32_t ck = 0; ck < 4; ++ck) {
+            ssts.push_back(make_sstable_containing(sst_gen, {make_row(0, ck * 10), make_row(0, ck * 10 + 5)}));
+        }
+        auto dkey = ssts.front()->get_first_decorated_key();
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::size_tiered, {});
+        auto set = cs.make_sstable_set(cf.as_compaction_group_view());
+        for (auto& sst : ssts) {
+            set.insert(sst);
+        }
+
+        auto& cf_stats = cf.cf_stats();
+        auto read = [&] (int32_t start, int32_t end) {
+            auto slice = partition_slice_builder(*s)
+                        .with_range(query::clustering_range {
+                            query::clustering_range::bound { clustering_key_prefix::from_single_value(*s, int32_type->decompose(start)) },
+                            query::clustering_range::bound { clustering_key_prefix::from_single_value(*s, int32_type->decompose(end)) },
+                        }).build();
+            utils::estimated_histogram eh;
+            auto reader = set.create_single_key_sstable_reader(
+                    &*cf, s, env.make_reader_permit(), eh, dht::partition_range::make_singular(dkey), slice,
+                    tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no,
+                    ::mutation_reader::forwarding::no);
+            auto close_reader = deferred_close(reader);
+            return read_mutation_from_mutation_reader(reader).get();
+        };
+
+        auto checked_by_ck = cf_stats.sstables_checked_by_clustering_filter;
+        auto surviving_after_ck = cf_stats.surviving_sstables_after_clustering_filter;
+        auto m = read(11, 22);
+        BOOST_REQUIRE(m);
+        BOOST_REQUIRE_EQUAL(m->partition().clustered_rows().calculate_size(), 2);
+        BOOST_REQUIRE_EQUAL(cf_stats.sstables_checked_by_clustering_filter - checked_by_ck, 4);
+        BOOST_REQUIRE_EQUAL(cf_stats.surviving_sstables_after_clustering_filter - surviving_after_ck, 2);
+
+        // The partition is still emitted when all sstables holding it are pruned, see #3552.
+        m = read(6, 9);
+        BOOST_REQUIRE(m);
+        BOOST_REQUIRE(m->partition().clustered_rows().empty());
+    });
+}
+
 SEASTAR_TEST_CASE(max_ongoing_compaction_test) {
     return test_env::do_with_async([] (test_env& env) {
         BOOST_REQUIRE(smp::count == 1);
@@ -6296,4 +6363,485 @@ SEASTAR_TEST_CASE(splitting_compaction_test) {
     });
 }
 
+// Check that sstables which don't overlap other inputs and have nothing to
+// purge are linked to the next level instead of being rewritten.
+SEASTAR_TEST_CASE(copy_through_compaction_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "copy_through_compaction_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type);
+        builder.set_gc_grace_seconds(0);
+        auto s = builder.build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        cf->disable_auto_compaction().get();
+
+        const auto keys = tests::generate_partition_keys(5, s);
+        auto make_insert = [&] (const dht::decorated_key& key) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), api::new_timestamp());
+            return m;
+        };
+        auto make_delete = [&] (const dht::decorated_key& key) {
+            mutation m(s, key);
+            m.partition().apply(tombstone(api::new_timestamp(), gc_clock::now() - std::chrono::hours(1)));
+            return m;
+        };
+
+        auto m0 = make_insert(keys[0]);
+        auto m1 = make_insert(keys[1]);
+        auto m2a = make_insert(keys[2]);
+        auto m2b = make_insert(keys[2]);
+        auto m3 = make_delete(keys[3]);
+        auto m4 = make_insert(keys[4]);
+
+        // Overlaps no other input and has nothing to purge.
+        auto sst0 = make_sstable_containing(sst_gen, {m0});
+        // Overlap each other.
+        auto sst1 = make_sstable_containing(sst_gen, {m1, m2a});
+        auto sst2 = make_sstable_containing(sst_gen, {m2b});
+        // Has a purgeable tombstone.
+        auto sst3 = make_sstable_containing(sst_gen, {m3, m4});
+
+        std::vector<shared_sstable> ssts = {sst0, sst1, sst2, sst3};
+        for (auto& sst : ssts) {
+            BOOST_REQUIRE_EQUAL(sst->get_sstable_level(), 0);
+            column_family_test(cf).add_sstable(sst).get();
+        }
+        auto desc = compaction::compaction_descriptor(ssts, 1, 1024 * 1024 * 1024);
+        desc.enable_garbage_collection(cf->get_sstable_set());
+        auto result = compact_sstables(env, std::move(desc), cf, sst_gen).get().new_sstables;
+        BOOST_REQUIRE_EQUAL(result.size(), 2);
+
+        auto copy_it = std::ranges::find_if(result, [&] (const shared_sstable& sst) {
+            return sst->get_first_decorated_key().equal(*s, keys[0]);
+        });
+        BOOST_REQUIRE(copy_it != result.end());
+        auto copy = *copy_it;
+        auto rewritten = result[copy_it == result.begin() ? 1 : 0];
+
+        auto inode = [] (const shared_sstable& sst) {
+            return file_stat(fmt::to_string(sst->get_filename())).get().inode_number;
+        };
+        BOOST_REQUIRE(copy->generation() != sst0->generation());
+        BOOST_REQUIRE_EQUAL(inode(copy), inode(sst0));
+        BOOST_REQUIRE_EQUAL(copy->get_sstable_level(), 1);
+        BOOST_REQUIRE_EQUAL(sst0->get_sstable_level(), 0);
+        // The copy joins the run of the output, also once reloaded, while
+        // the linked input keeps its own.
+        BOOST_REQUIRE_EQUAL(copy->run_identifier(), rewritten->run_identifier());
+        BOOST_REQUIRE_EQUAL(env.reusable_sst(copy).get()->run_identifier(), rewritten->run_identifier());
+        BOOST_REQUIRE_EQUAL(env.reusable_sst(sst0).get()->run_identifier(), sst0->run_identifier());
+        assert_that(sstable_reader(copy, s, env.make_reader_permit()))
+                .produces(m0)
+                .produces_end_of_stream();
+
+        m2a.apply(m2b);
+        BOOST_REQUIRE_EQUAL(rewritten->get_sstable_level(), 1);
+        assert_that(sstable_reader(rewritten, s, env.make_reader_permit()))
+                .produces(m1)
+                .produces(m2a)
+                .produces(m4)
+                .produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(parallel_token_ranges_compaction_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "parallel_token_ranges_compaction_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type)
+                .build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        cf->disable_auto_compaction().get();
+
+        const auto keys = tests::generate_partition_keys(16, s);
+        auto make_insert = [&] (const dht::decorated_key& key, int32_t value) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(value), api::new_timestamp());
+            return m;
+        };
+
+        // Both inputs span the whole token range of the keys, and the second
+        // one overwrites every other key of the first one.
+        utils::chunked_vector<mutation> first, second;
+        std::vector<mutation> expected;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            first.push_back(make_insert(keys[i], int32_t(i)));
+            expected.push_back(first.back());
+            if (i % 2 == 0 || i == keys.size() - 1) {
+                second.push_back(make_insert(keys[i], -int32_t(i)));
+                expected.back().apply(second.back());
+            }
+        }
+        std::vector<shared_sstable> ssts = {
+            make_sstable_containing(sst_gen, std::move(first)),
+            make_sstable_containing(sst_gen, std::move(second)),
+        };
+        for (auto& sst : ssts) {
+            column_family_test(cf).add_sstable(sst).get();
+        }
+
+        auto run_id = sstables::run_id::create_random_id();
+        auto desc = compaction::compaction_descriptor(ssts, 0, compaction::compaction_descriptor::default_max_sstable_bytes, run_id,
+                compaction::compaction_type_options::make_major());
+        desc.token_range_parallelism = 4;
+        auto result = compact_sstables(env, std::move(desc), cf, sst_gen).get().new_sstables;
+
+        // Every range is written into sstables of its own, which don't overlap
+        // the ones of other ranges.
+        BOOST_REQUIRE_GT(result.size(), 1);
+        std::ranges::sort(result, [&] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().less_compare(*s, b->get_first_decorated_key());
+        });
+        for (size_t i = 1; i < result.size(); ++i) {
+            BOOST_REQUIRE(result[i - 1]->get_last_decorated_key().less_compare(*s, result[i]->get_first_decorated_key()));
+        }
+
+        std::vector<mutation> actual;
+        for (auto& sst : result) {
+            BOOST_REQUIRE_EQUAL(sst->run_identifier(), run_id);
+            auto reader = sstable_reader(sst, s, env.make_reader_permit());
+            auto close_reader = deferred_close(reader);
+            while (auto m = read_mutation_from_mutation_reader(reader).get()) {
+                actual.push_back(std::move(*m));
+            }
+        }
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert_that(actual[i]).is_equal_to(expected[i]);
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(tombstone_purge_compaction_job_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "tombstone_purge_compaction_job_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("value", bytes_type);
+        builder.set_gc_grace_seconds(0);
+        builder.set_compaction_strategy(compaction::compaction_strategy_type::size_tiered);
+        auto s = builder.build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        cf->disable_auto_compaction().get();
+
+        const auto keys = tests::generate_partition_keys(4, s);
+        const int32_t rows = 50;
+        auto make_ck = [&] (int32_t ck) {
+            return clustering_key::from_single_value(*s, int32_type->decompose(ck));
+        };
+        utils::chunked_vector<mutation> data, deletions, few_deletions;
+        for (auto& key : keys) {
+            mutation m(s, key);
+            for (int32_t ck = 0; ck < rows; ++ck) {
+                m.set_clustered_cell(make_ck(ck), bytes("value"), data_value(bytes(1024, int8_t(ck))), api::new_timestamp());
+            }
+            data.push_back(std::move(m));
+        }
+        for (auto& key : keys) {
+            mutation m(s, key);
+            for (int32_t ck = 0; ck < rows; ++ck) {
+                m.partition().apply_delete(*s, make_ck(ck), tombstone(api::new_timestamp(), gc_clock::now() - std::chrono::hours(1)));
+            }
+            deletions.push_back(std::move(m));
+        }
+        for (auto& key : keys) {
+            mutation m(s, key);
+            m.partition().apply_delete(*s, make_ck(0), tombstone(api::new_timestamp(), gc_clock::now() - std::chrono::hours(1)));
+            few_deletions.push_back(std::move(m));
+        }
+        auto data_sst = make_sstable_containing(sst_gen, std::move(data));
+        auto deletions_sst = make_sstable_containing(sst_gen, std::move(deletions));
+        auto few_deletions_sst = make_sstable_containing(sst_gen, std::move(few_deletions));
+
+        // Ranges without tombstones are recorded with their cells.
+        auto* histograms = data_sst->get_tombstone_histograms();
+        BOOST_REQUIRE(histograms);
+        uint64_t cells = 0;
+        for (auto& h : histograms->elements) {
+            BOOST_REQUIRE(h.histogram.elements.empty());
+            cells += h.cells_count;
+        }
+        BOOST_REQUIRE_EQUAL(cells, keys.size() * rows);
+
+        histograms = deletions_sst->get_tombstone_histograms();
+        BOOST_REQUIRE(histograms);
+        uint64_t tombstones = 0;
+        for (auto& h : histograms->elements) {
+            BOOST_REQUIRE_LT(h.token_range, sstables::tombstone_histogram_token_ranges);
+            BOOST_REQUIRE_LE(h.first_token, h.last_token);
+            BOOST_REQUIRE_LE(deletions_sst->get_first_decorated_key().token().raw(), h.first_token);
+            BOOST_REQUIRE_GE(deletions_sst->get_last_decorated_key().token().raw(), h.last_token);
+            for (auto& b : h.histogram.elements) {
+                tombstones += b.count;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(tombstones, keys.size() * rows);
+
+        for (auto& sst : {data_sst, deletions_sst, few_deletions_sst}) {
+            column_family_test(cf).add_sstable(sst).get();
+            // Tombstone compactions only consider sstables which are old enough.
+            sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+        }
+
+        std::map<sstring, sstring> options = {
+            {"min_sstable_size", "0"},
+        };
+        auto cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::size_tiered, options);
+
+        // A few tombstones aren't worth rewriting all the live data they overlap.
+        std::vector<shared_sstable> ssts = {data_sst, few_deletions_sst};
+        auto desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), ssts).get();
+        BOOST_REQUIRE(!desc.tombstone_purge);
+
+        // The sstables are in different size tiers, and the tombstones shadow the data
+        // of the other sstable, so they can only be purged by compacting both together.
+        ssts = {data_sst, deletions_sst};
+        desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), ssts).get();
+        BOOST_REQUIRE(desc.tombstone_purge);
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 2);
+
+        desc.enable_garbage_collection(cf->get_sstable_set());
+        auto result = compact_sstables(env, std::move(desc), cf, sst_gen).get();
+        BOOST_REQUIRE_LT(result.stats.end_size, data_sst->data_size());
+        for (auto& sst : result.new_sstables) {
+            assert_that(sstable_reader(sst, s, env.make_reader_permit())).produces_end_of_stream();
+        }
+
+        // Tombstones of recently written sstables aren't considered, so that a purge
+        // compaction which couldn't drop the tombstones isn't repeated on its output.
+        options.emplace("tombstone_compaction_interval", "3600");
+        sstables::test(deletions_sst).set_data_file_write_time(db_clock::now());
+        cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::size_tiered, options);
+        desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), ssts).get();
+        BOOST_REQUIRE(!desc.tombstone_purge);
+    });
+}
+
+SEASTAR_TEST_CASE(tombstone_purge_compaction_job_range_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "tombstone_purge_compaction_job_range_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("value", bytes_type);
+        builder.set_gc_grace_seconds(0);
+        builder.set_compaction_strategy(compaction::compaction_strategy_type::size_tiered);
+        auto s = builder.build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        cf->disable_auto_compaction().get();
+
+        const auto keys = tests::generate_partition_keys(64, s);
+        const int32_t rows = 50;
+        auto make_ck = [&] (int32_t ck) {
+            return clustering_key::from_single_value(*s, int32_type->decompose(ck));
+        };
+        auto token_range = [] (const dht::decorated_key& dk) {
+            return dk.token().unbias() >> (64 - std::countr_zero(sstables::tombstone_histogram_token_ranges));
+        };
+        // Delete all the rows of the token range with the most partitions.
+        std::array<unsigned, sstables::tombstone_histogram_token_ranges> partitions_per_range{};
+        for (auto& key : keys) {
+            ++partitions_per_range[token_range(key)];
+        }
+        auto deleted_range = std::ranges::max_element(partitions_per_range) - partitions_per_range.begin();
+
+        utils::chunked_vector<mutation> data, deletions;
+        for (auto& key : keys) {
+            mutation m(s, key);
+            for (int32_t ck = 0; ck < rows; ++ck) {
+                m.set_clustered_cell(make_ck(ck), bytes("value"), data_value(bytes(1024, int8_t(ck))), api::new_timestamp());
+            }
+            data.push_back(std::move(m));
+            if (token_range(key) == deleted_range) {
+                mutation d(s, key);
+                for (int32_t ck = 0; ck < rows; ++ck) {
+                    d.partition().apply_delete(*s, make_ck(ck), tombstone(api::new_timestamp(), gc_clock::now() - std::chrono::hours(1)));
+                }
+                deletions.push_back(std::move(d));
+            }
+        }
+        auto data_sst = make_sstable_containing(sst_gen, std::move(data));
+        auto deletions_sst = make_sstable_containing(sst_gen, std::move(deletions));
+
+        // Within the deleted range, the tombstones are as many as the cells.
+        for (auto& h : data_sst->get_tombstone_histograms()->elements) {
+            if (h.token_range == deleted_range) {
+                BOOST_REQUIRE_EQUAL(h.cells_count, partitions_per_range[deleted_range] * rows);
+            }
+        }
+
+        std::vector<shared_sstable> ssts = {data_sst, deletions_sst};
+        for (auto& sst : ssts) {
+            column_family_test(cf).add_sstable(sst).get();
+            sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+        }
+
+        // But compacting them would rewrite the data sstable, which is live
+        // outside of the deleted range, for a small fraction of its size.
+        std::map<sstring, sstring> options = {
+            {"min_sstable_size", "0"},
+        };
+        auto cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::size_tiered, options);
+        auto desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), ssts).get();
+        BOOST_REQUIRE(!desc.tombstone_purge);
+        BOOST_REQUIRE(std::ranges::find(desc.sstables, data_sst) == desc.sstables.end());
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(compaction_cost_model_test) {
+    using cost_model = compaction::compaction_cost_model;
+    constexpr uint64_t input_bytes = 1 << 20;
+    auto reference_cpu_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(cost_model::reference_cpu_seconds_per_byte * input_bytes));
+
+    // Tables without compactions cost as much as the reference table.
+    cost_model model;
+    BOOST_REQUIRE_EQUAL(model.cost_factor(), 1.0);
+
+    // Compactions which read nothing are ignored.
+    model.update(reference_cpu_time * 100, 0, 0);
+    BOOST_REQUIRE_EQUAL(model.cost_factor(), 1.0);
+
+    // A compaction like the reference one.
+    model.update(reference_cpu_time, input_bytes, input_bytes);
+    BOOST_REQUIRE_CLOSE(model.cost_factor(), 1.0, 0.1);
+
+    // CPU-heavy compactions raise the cost, up to the bound.
+    cost_model cpu_heavy;
+    cpu_heavy.update(reference_cpu_time * 3, input_bytes, input_bytes);
+    BOOST_REQUIRE_CLOSE(cpu_heavy.cost_factor(), 2.0, 0.1);
+    cpu_heavy.update(reference_cpu_time * 100, input_bytes, input_bytes);
+    BOOST_REQUIRE_GT(cpu_heavy.cpu_seconds_per_byte(), cost_model::reference_cpu_seconds_per_byte * 3);
+    cpu_heavy.update(reference_cpu_time * 100, input_bytes, input_bytes);
+    BOOST_REQUIRE_EQUAL(cpu_heavy.cost_factor(), cost_model::max_cost_factor);
+
+    // CPU-light compactions lower the cost, down to the bound.
+    cost_model cpu_light;
+    cpu_light.update(reference_cpu_time / 100, input_bytes, input_bytes);
+    BOOST_REQUIRE_LT(cpu_light.cost_factor(), 1.0);
+    BOOST_REQUIRE_GE(cpu_light.cost_factor(), cost_model::min_cost_factor);
+
+    // Compactions which purge most of their input write less per input byte,
+    // so they cost less than the reference compaction.
+    cost_model purging;
+    purging.update(reference_cpu_time * 9, input_bytes * 9, input_bytes);
+    BOOST_REQUIRE_CLOSE(purging.io_bytes_per_byte(), 10.0 / 9, 0.1);
+    BOOST_REQUIRE_CLOSE(purging.cost_factor(), 0.5 + 0.5 * (10.0 / 9) / cost_model::reference_io_bytes_per_byte, 0.1);
+
+    // The CPU estimate is kept when the CPU time of a compaction is unknown.
+    purging.update(std::chrono::nanoseconds(0), input_bytes, input_bytes);
+    BOOST_REQUIRE_CLOSE(purging.cpu_seconds_per_byte(), cost_model::reference_cpu_seconds_per_byte, 0.1);
+
+    // With scaling enabled, the backlog manager scales the backlog of each
+    // tracker by the cost factor of its table relative to the mean factor.
+    struct fixed_backlog_tracker final : public compaction::compaction_backlog_tracker::impl {
+        virtual void replace_sstables(const std::vector<sstables::shared_sstable>&, const std::vector<sstables::shared_sstable>&) override {}
+        virtual double backlog(const compaction::compaction_backlog_tracker::ongoing_writes&, const compaction::compaction_backlog_tracker::ongoing_compactions&) const override {
+            return 1000;
+        }
+    };
+    compaction_controller controller(default_scheduling_group(), 1, std::chrono::hours(1), [] { return 0.0f; });
+    auto stop_controller = defer([&] { controller.shutdown().get(); });
+    utils::updateable_value_source<bool> scale_by_cost(false);
+    compaction::compaction_backlog_manager manager(controller, utils::updateable_value<bool>(scale_by_cost));
+    auto heavy_model = make_lw_shared<cost_model>(cpu_heavy);
+    auto reference_model = make_lw_shared<cost_model>();
+    compaction::compaction_backlog_tracker heavy(std::make_unique<fixed_backlog_tracker>());
+    compaction::compaction_backlog_tracker heavy_other_group(std::make_unique<fixed_backlog_tracker>());
+    compaction::compaction_backlog_tracker reference(std::make_unique<fixed_backlog_tracker>());
+    heavy.set_cost_model(heavy_model);
+    heavy_other_group.set_cost_model(heavy_model);
+    reference.set_cost_model(reference_model);
+    BOOST_REQUIRE_EQUAL(heavy.backlog(), 1000);
+    manager.register_backlog_tracker(heavy);
+    manager.register_backlog_tracker(heavy_other_group);
+    manager.register_backlog_tracker(reference);
+    BOOST_REQUIRE_EQUAL(manager.backlog(), 3000);
+
+    // The groups of a table share its cost model and count once in the mean.
+    scale_by_cost.set(true);
+    auto mean_cost_factor = (cost_model::max_cost_factor + 1.0) / 2;
+    BOOST_REQUIRE_CLOSE(manager.backlog(), 1000 * (2 * cost_model::max_cost_factor + 1.0) / mean_cost_factor, 0.1);
+
+    // Tables which cost the same keep the backlog unchanged.
+    heavy.set_cost_model(reference_model);
+    heavy_other_group.set_cost_model(reference_model);
+    BOOST_REQUIRE_CLOSE(manager.backlog(), 3000, 0.1);
+}
+
+SEASTAR_TEST_CASE(garbage_collection_compaction_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "garbage_collection_compaction_test")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_gc_grace_seconds(0);
+        auto s = builder.build();
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        cf->disable_auto_compaction().get();
+
+        auto key = tests::generate_partition_key(s);
+        auto deleted_at = gc_clock::now() - std::chrono::hours(1);
+        auto make_deletion = [&] (api::timestamp_type timestamp) {
+            mutation m(s, key);
+            m.partition().apply(tombstone(timestamp, deleted_at));
+            return m;
+        };
+        mutation live(s, key);
+        live.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(0)), "v", data_value(0), 10);
+
+        // The deletion is older than the live data, so its sstable can be dropped.
+        auto expired_sst = make_sstable_containing(sst_gen, {make_deletion(1)});
+        auto live_sst = make_sstable_containing(sst_gen, {live});
+        cf->add_sstable_and_update_cache(expired_sst).get();
+        cf->add_sstable_and_update_cache(live_sst).get();
+
+        auto& cm = cf->get_compaction_manager();
+        cm.perform_garbage_collection(cf.as_compaction_group_view(), {}).get();
+        // The sstable with live data isn't rewritten.
+        auto sstables = cf->get_sstables();
+        BOOST_REQUIRE_EQUAL(sstables->size(), 1);
+        BOOST_REQUIRE_EQUAL((*sstables->begin())->generation(), live_sst->generation());
+
+        // The deletion shadows the live data, so its sstable is kept.
+        auto shadowing_sst = make_sstable_containing(sst_gen, {make_deletion(20)});
+        cf->add_sstable_and_update_cache(shadowing_sst).get();
+        cm.perform_garbage_collection(cf.as_compaction_group_view(), {}).get();
+        sstables = cf->get_sstables();
+        BOOST_REQUIRE_EQUAL(sstables->size(), 2);
+        BOOST_REQUIRE(sstables->contains(live_sst));
+        BOOST_REQUIRE(sstables->contains(shadowing_sst));
+
+        // Inputs which aren't fully expired when the compaction starts are
+        // neither rewritten nor dropped.
+        auto desc = compaction::compaction_descriptor(compaction::has_only_fully_expired::yes, {live_sst, shadowing_sst});
+        desc.options = compaction::compaction_type_options::make_garbage_collection();
+        std::vector<shared_sstable> removed;
+        auto result = compact_sstables(env, std::move(desc), cf, sst_gen, [&] (compaction::compaction_completion_desc desc) {
+            removed.insert(removed.end(), desc.old_sstables.begin(), desc.old_sstables.end());
+        }).get();
+        BOOST_REQUIRE(result.new_sstables.empty());
+        BOOST_REQUIRE(removed.empty());
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
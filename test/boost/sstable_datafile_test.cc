@@ -1818,6 +1818,244 @@ SEASTAR_TEST_CASE(test_skipping_using_index) {
     });
 }
 
+SEASTAR_TEST_CASE(test_single_row_reads_using_row_hash_index) {
+    return test_env::do_with_async([] (test_env& env) {
+      for (const auto version : writable_sstable_versions) {
+        simple_schema table;
+        auto s = table.schema();
+        auto permit = env.make_reader_permit();
+
+        // Even row ids are present, odd ones are absent.
+        const uint32_t rows_per_part = 1000;
+        utils::chunked_vector<mutation> partitions;
+
+        // Large partition, indexed.
+        mutation large(s, table.make_pkey(0));
+        table.add_static_row(large, "static");
+        for (uint32_t i = 0; i < rows_per_part; i += 2) {
+            table.add_row(large, table.make_ckey(i), make_random_string(100));
+        }
+        partitions.push_back(large);
+
+        // Large partition with a range tombstone, not indexed.
+        mutation with_rt(s, table.make_pkey(1));
+        for (uint32_t i = 0; i < rows_per_part; i += 2) {
+            table.add_row(with_rt, table.make_ckey(i), make_random_string(100));
+        }
+        table.delete_range(with_rt, table.make_ckey_range(100, 200));
+        partitions.push_back(with_rt);
+
+        // Small partition, not indexed.
+        mutation small(s, table.make_pkey(2));
+        table.add_row(small, table.make_ckey(0), make_random_string(1));
+        table.add_row(small, table.make_ckey(2), make_random_string(1));
+        partitions.push_back(small);
+
+        std::sort(partitions.begin(), partitions.end(), mutation_decorated_key_less_comparator());
+
+        sstable_writer_config cfg = env.manager().configure_writer();
+        cfg.row_hash_index_min_partition_size = 4096;
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(s, permit, partitions), cfg, version);
+        BOOST_REQUIRE_EQUAL(sst->has_component(component_type::RowHashes), has_summary_and_index(version));
+        auto ms = sst->as_mutation_source();
+
+        for (auto&& m : partitions) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            for (uint32_t i : {0u, 1u, 2u, 150u, 151u, 500u, rows_per_part - 2, rows_per_part - 1, rows_per_part + 1}) {
+                auto ranges = query::clustering_row_ranges{query::clustering_range::make_singular(table.make_ckey(i))};
+                auto slice = partition_slice_builder(*s).with_ranges(ranges).build();
+                testlog.trace("reading {} from {}", i, m.decorated_key());
+                assert_that(ms.make_mutation_reader(s, permit, pr, slice))
+                    .produces(m.sliced(ranges))
+                    .produces_end_of_stream();
+            }
+        }
+      }
+    });
+}
+
+SEASTAR_TEST_CASE(test_table_stats_of_dropped_table) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto& manager = env.manager();
+        auto id = table_id::create_random_id();
+        auto stats = manager.get_partition_index_cache_stats(id);
+        BOOST_REQUIRE_EQUAL(manager.find_partition_index_cache_stats(id).get(), stats.get());
+
+        // sstables of a dropped table don't bring its statistics back.
+        manager.forget_partition_index_cache_stats(id);
+        auto orphan = manager.find_partition_index_cache_stats(id);
+        BOOST_REQUIRE_NE(orphan.get(), stats.get());
+        BOOST_REQUIRE_NE(manager.find_partition_index_cache_stats(id).get(), orphan.get());
+
+        auto readahead_stats = manager.get_data_readahead_stats(id);
+        BOOST_REQUIRE_EQUAL(manager.find_data_readahead_stats(id).get(), readahead_stats.get());
+        manager.forget_data_readahead_stats(id);
+        BOOST_REQUIRE_NE(manager.find_data_readahead_stats(id).get(), readahead_stats.get());
+
+        auto index_file_stats = manager.get_index_file_cache_stats(id);
+        BOOST_REQUIRE_EQUAL(manager.find_index_file_cache_stats(id).get(), index_file_stats.get());
+        manager.forget_index_file_cache_stats(id);
+        BOOST_REQUIRE_NE(manager.find_index_file_cache_stats(id).get(), index_file_stats.get());
+    });
+}
+
+SEASTAR_TEST_CASE(test_index_cache_preheat_ranges) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema table;
+        auto s = table.schema();
+        auto permit = env.make_reader_permit();
+
+        utils::chunked_vector<mutation> partitions;
+        for (auto&& dk : tests::generate_partition_keys(20000, s)) {
+            mutation m(s, dk);
+            table.add_row(m, table.make_ckey(0), "v");
+            partitions.push_back(std::move(m));
+        }
+        std::sort(partitions.begin(), partitions.end(), mutation_decorated_key_less_comparator());
+        auto sst = make_sstable_containing(env.make_sstable(s, sstable_version_types::me), partitions);
+        BOOST_REQUIRE(sst->cached_index_token_ranges().empty());
+
+        auto contains = [] (const dht::token_range_vector& ranges, dht::token t) {
+            return std::ranges::any_of(ranges, [&] (const dht::token_range& r) { return r.contains(t, dht::token_comparator()); });
+        };
+
+        // Reading a partition caches the index pages around it.
+        auto& read = partitions[partitions.size() / 4];
+        assert_that(sst->make_reader(s, permit, dht::partition_range::make_singular(read.decorated_key()), s->full_slice()))
+            .produces(read)
+            .produces_end_of_stream();
+        auto ranges = sst->cached_index_token_ranges();
+        BOOST_REQUIRE(contains(ranges, read.token()));
+        BOOST_REQUIRE(!contains(ranges, partitions.back().token()));
+
+        // Populating the index of a token range caches only the pages around it.
+        auto& populated = partitions[partitions.size() * 3 / 4];
+        auto bytes = sst->populate_index_cache({dht::token_range::make_singular(populated.token())}).get();
+        BOOST_REQUIRE_GT(bytes, 0);
+        BOOST_REQUIRE_LT(bytes, sst->index_size() / 4);
+        ranges = sst->cached_index_token_ranges();
+        BOOST_REQUIRE(contains(ranges, populated.token()));
+        BOOST_REQUIRE(!contains(ranges, partitions.back().token()));
+
+        // Ranges outside of the sstable populate nothing.
+        auto before_first = dht::token::from_int64(dht::token::to_int64(partitions.front().token()) - 1);
+        BOOST_REQUIRE_EQUAL(sst->populate_index_cache({dht::token_range::make_ending_with({before_first, true})}).get(), 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_data_readahead_stats) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema table;
+        auto s = table.schema();
+        auto permit = env.make_reader_permit();
+
+        utils::chunked_vector<mutation> partitions;
+        for (auto&& dk : tests::generate_partition_keys(10, s)) {
+            mutation m(s, dk);
+            for (uint32_t i = 0; i < 100; ++i) {
+                table.add_row(m, table.make_ckey(i), make_random_string(1000));
+            }
+            partitions.push_back(std::move(m));
+        }
+        std::sort(partitions.begin(), partitions.end(), mutation_decorated_key_less_comparator());
+        // Registered by the table before it opens any sstables.
+        auto table_stats = env.manager().get_data_readahead_stats(s->id());
+        auto sst = make_sstable_containing(env.make_sstable(s), partitions);
+        auto& stats = sst->get_table_data_readahead_stats();
+        BOOST_REQUIRE_EQUAL(&stats, table_stats.get());
+
+        // A full scan consumes everything it reads.
+        assert_that(sst->make_reader(s, permit, query::full_partition_range, s->full_slice()))
+            .produces(partitions)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_GE(stats.bytes_read, sst->ondisk_data_size());
+        BOOST_REQUIRE_LE(stats.bytes_wasted, 1);
+
+        // Skipping past data which was read ahead wastes it.
+        auto bytes_read = stats.bytes_read;
+        auto pr = dht::partition_range::make(dht::ring_position(partitions[0].decorated_key()), dht::ring_position(partitions[1].decorated_key()));
+        assert_that(sst->make_reader(s, permit, pr, s->full_slice()))
+            .produces(partitions[0])
+            .produces(partitions[1])
+            .produces_end_of_stream()
+            .fast_forward_to(dht::partition_range::make_starting_with(dht::ring_position(partitions[8].decorated_key())))
+            .produces(partitions[8])
+            .produces(partitions[9])
+            .produces_end_of_stream();
+        BOOST_REQUIRE_GT(stats.bytes_read, bytes_read);
+        BOOST_REQUIRE_GT(stats.bytes_wasted, 1);
+        BOOST_REQUIRE_LE(stats.bytes_wasted, stats.bytes_read - bytes_read);
+    });
+}
+
+SEASTAR_TEST_CASE(test_skip_unselected_cell_values) {
+    return test_env::do_with_async([] (test_env& env) {
+      for (const auto version : writable_sstable_versions) {
+        auto s = schema_builder("ks", "test_skip_unselected_cell_values")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("s1", utf8_type, column_kind::static_column)
+                .with_column("s2", utf8_type, column_kind::static_column)
+                .with_column("a", utf8_type)
+                .with_column("b", utf8_type)
+                .with_column("c", map_type_impl::get_instance(int32_type, utf8_type, true))
+                .with_column("d", int32_type)
+                .build();
+        auto permit = env.make_reader_permit();
+        auto pk = partition_key::from_single_value(*s, int32_type->decompose(0));
+        auto ck1 = clustering_key::from_single_value(*s, int32_type->decompose(1));
+        auto ck2 = clustering_key::from_single_value(*s, int32_type->decompose(2));
+        const api::timestamp_type ts = 1;
+        auto now = gc_clock::now();
+        auto expiry = now + std::chrono::hours(1);
+
+        // Makes the mutation as written, or as read with only s1 and a selected.
+        auto make_mutation = [&] (bool projected) {
+            auto value = [&] (const sstring& v) {
+                return projected ? bytes() : utf8_type->decompose(v);
+            };
+            mutation m(s, pk);
+            m.set_static_cell(*s->get_column_definition("s1"), atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose(sstring("s1"))));
+            m.set_static_cell(*s->get_column_definition("s2"), atomic_cell::make_live(*utf8_type, ts, value("s2")));
+            m.partition().apply_insert(*s, ck1, ts);
+            m.set_clustered_cell(ck1, *s->get_column_definition("a"), atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose(sstring(1000, 'a'))));
+            m.set_clustered_cell(ck1, *s->get_column_definition("b"), atomic_cell::make_live(*utf8_type, ts, value(sstring(1000, 'b')), expiry, std::chrono::hours(1)));
+            m.set_clustered_cell(ck1, *s->get_column_definition("d"), atomic_cell::make_live(*int32_type, ts, projected ? bytes() : int32_type->decompose(7)));
+            collection_mutation_description c;
+            c.tomb = tombstone(ts - 1, now);
+            c.cells.emplace_back(int32_type->decompose(1), atomic_cell::make_live(*utf8_type, ts, value("c1"), atomic_cell::collection_member::yes));
+            c.cells.emplace_back(int32_type->decompose(2), atomic_cell::make_dead(ts, now));
+            m.set_clustered_cell(ck1, *s->get_column_definition("c"), c.serialize(*s->get_column_definition("c")->type));
+            // No row marker, the row is live only thanks to a column which is not selected.
+            m.set_clustered_cell(ck2, *s->get_column_definition("b"), atomic_cell::make_live(*utf8_type, ts, value("b")));
+            return m;
+        };
+        auto m = make_mutation(false);
+        auto expected = make_mutation(true);
+
+        auto sst = make_sstable_containing(env.make_sstable(s, version), {m});
+        auto pr = dht::partition_range::make_singular(m.decorated_key());
+
+        auto slice = partition_slice_builder(*s)
+                .with_no_static_columns()
+                .with_static_column("s1")
+                .with_no_regular_columns()
+                .with_regular_column("a")
+                .with_option<query::partition_slice::option::skip_unselected_cell_values>()
+                .build();
+        assert_that(sst->make_reader(s, permit, pr, slice))
+            .produces(expected)
+            .produces_end_of_stream();
+
+        // Without the option, all values are read.
+        slice.options.remove<query::partition_slice::option::skip_unselected_cell_values>();
+        assert_that(sst->make_reader(s, permit, pr, slice))
+            .produces(m)
+            .produces_end_of_stream();
+      }
+    });
+}
+
 SEASTAR_TEST_CASE(test_unknown_component) {
     return test_env::do_with_async([] (test_env& env) {
         copy_directory("test/resource/sstables/unknown_component", std::string(env.tempdir().path().string()) + "/unknown_component");
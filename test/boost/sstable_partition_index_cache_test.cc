@@ -272,3 +272,52 @@ SEASTAR_THREAD_TEST_CASE(test_evict_gently) {
 
     cache.evict_gently().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_table_stats_and_cost_aware_eviction) {
+    ::lru lru;
+    simple_schema s;
+    logalloc::region r;
+    partition_index_cache_stats stats;
+    partition_index_cache_stats remote_table_stats;
+
+    partition_index_cache local_cache(lru, r, stats);
+    partition_index_cache remote_cache(lru, r, stats, &remote_table_stats);
+    remote_cache.set_refetch_cost(8);
+
+    auto clear_lru = defer([&] {
+        with_allocator(r.allocator(), [&] {
+            lru.evict_all();
+        });
+    });
+
+    auto page0_loader = [&] (partition_index_cache::key_type k) {
+        return make_page0(r, s);
+    };
+
+    remote_cache.get_or_load(0, page0_loader).get();
+    remote_cache.get_or_load(0, page0_loader).get();
+    local_cache.get_or_load(0, page0_loader).get();
+
+    BOOST_REQUIRE_EQUAL(stats.misses, 2);
+    BOOST_REQUIRE_EQUAL(stats.hits, 1);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.misses, 1);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.hits, 1);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.populations, 1);
+    BOOST_REQUIRE(remote_table_stats.used_bytes > 0);
+    BOOST_REQUIRE(remote_table_stats.used_bytes < stats.used_bytes);
+
+    // The remote page is the least recently used one, but it is more
+    // expensive to load back, so the local one goes first.
+    with_allocator(r.allocator(), [&] {
+        lru.evict(true);
+    });
+    BOOST_REQUIRE_EQUAL(stats.evictions, 1);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.evictions, 0);
+
+    with_allocator(r.allocator(), [&] {
+        lru.evict(true);
+    });
+    BOOST_REQUIRE_EQUAL(stats.evictions, 2);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.evictions, 1);
+    BOOST_REQUIRE_EQUAL(remote_table_stats.used_bytes, 0);
+}
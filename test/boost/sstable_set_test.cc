@@ -21,6 +21,7 @@
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/random_utils.hh"
 #include "readers/from_mutations.hh"
 #include "service/storage_service.hh"
 
@@ -179,6 +180,81 @@ SEASTAR_TEST_CASE(test_partitioned_sstable_set_bytes_on_disk) {
     });
 }
 
+// Checks the leveled sstables index of partitioned_sstable_set against
+// brute force, while sstables come and go.
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_random_intervals) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        auto keys = tests::generate_partition_keys(30, s);
+        std::ranges::sort(keys, dht::decorated_key::less_comparator(s));
+
+        auto set = sstable_set(std::make_unique<partitioned_sstable_set>(s, full_range));
+        std::vector<shared_sstable> ssts;
+
+        auto contains = [&] (const shared_sstable& sst, dht::ring_position_view pos) {
+            return dht::ring_position_tri_compare(*s, sst->get_first_decorated_key(), pos) <= 0
+                && dht::ring_position_tri_compare(*s, pos, sst->get_last_decorated_key()) <= 0;
+        };
+        // Such sstables are stored outside of the index, and always selected.
+        auto unleveled = [&] (const shared_sstable& sst) {
+            auto sst_tr = dht::token_range(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+            return dht::overlap_ratio(full_range, sst_tr) >= 0.85f;
+        };
+        auto to_set = [] (const std::vector<shared_sstable>& v) {
+            return v | std::ranges::to<std::unordered_set<shared_sstable>>();
+        };
+
+        auto check = [&] {
+            for (int i = 0; i < 20; ++i) {
+                auto a = tests::random::get_int<size_t>(0, keys.size() - 1);
+                auto b = tests::random::get_int<size_t>(a, keys.size() - 1);
+                auto range = dht::partition_range::make({keys[a], tests::random::get_bool()}, {keys[b], tests::random::get_bool()});
+                std::unordered_set<shared_sstable> expected;
+                for (auto& sst : ssts) {
+                    if (unleveled(sst) || (dht::ring_position_tri_compare(*s, sst->get_first_decorated_key(), keys[b]) <= 0
+                            && dht::ring_position_tri_compare(*s, keys[a], sst->get_last_decorated_key()) <= 0)) {
+                        expected.insert(sst);
+                    }
+                }
+                auto selected = set.select(range);
+                BOOST_REQUIRE_EQUAL(selected.size(), expected.size());
+                BOOST_REQUIRE(to_set(selected) == expected);
+            }
+
+            auto sel = set.make_incremental_selector();
+            for (auto& key : keys) {
+                for (auto pos : {dht::ring_position_view(key), dht::ring_position_view(key, dht::ring_position_view::after_key::yes)}) {
+                    std::unordered_set<shared_sstable> expected;
+                    for (auto& sst : ssts) {
+                        if (unleveled(sst) || contains(sst, pos)) {
+                            expected.insert(sst);
+                        }
+                    }
+                    BOOST_REQUIRE(to_set(sel.select({pos}).sstables) == expected);
+                }
+            }
+        };
+
+        for (int i = 0; i < 200; ++i) {
+            if (ssts.empty() || tests::random::get_int(0, 2)) {
+                auto a = tests::random::get_int<size_t>(0, keys.size() - 1);
+                auto b = tests::random::get_int<size_t>(a, std::min(a + 10, keys.size() - 1));
+                auto sst = env.make_sstable(s);
+                sstables::test(sst).set_values_for_leveled_strategy(1, 1, 0, keys[a].key(), keys[b].key());
+                set.insert(sst);
+                ssts.push_back(std::move(sst));
+            } else {
+                auto it = ssts.begin() + tests::random::get_int<size_t>(0, ssts.size() - 1);
+                set.erase(*it);
+                ssts.erase(it);
+            }
+            check();
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_tablet_sstable_set_copy_ctor) {
     // enable tablets, to get access to tablet_storage_group_manager
     cql_test_config cfg;
@@ -737,6 +737,85 @@ SEASTAR_TEST_CASE(test_skipping_in_compressed_stream) {
     });
 }
 
+// Long reads decompress the next chunk ahead of the consumer, check that
+// reads and skips see the same data as without it.
+SEASTAR_TEST_CASE(test_decompress_ahead_in_compressed_stream) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        tmpdir tmp;
+        auto file_path = (tmp.path() / "test").string();
+        file f = open_file_dma(file_path, open_flags::create | open_flags::wo).get();
+
+        file_input_stream_options opts;
+
+        compression_parameters cp({
+            { compression_parameters::SSTABLE_COMPRESSION, "LZ4Compressor" },
+            { compression_parameters::CHUNK_LENGTH_KB, "4" },
+        });
+
+        sstables::compression c;
+        auto os = make_file_output_stream(f, file_output_stream_options()).get();
+        auto out = make_compressed_file_m_format_output_stream(std::move(os), &c, cp, make_lz4_sstable_compressor_for_tests());
+
+        // 8 and a half chunks.
+        sstring data;
+        while (data.size() < 8 * c.uncompressed_chunk_length() + c.uncompressed_chunk_length() / 2) {
+            data += fmt::format("{:08x}", data.size());
+        }
+        out.write(data.data(), data.size()).get();
+        out.close().get();
+
+        c.update(seastar::file_size(file_path).get());
+
+        auto make_is = [&] (uint64_t pos, size_t len) {
+            f = open_file_dma(file_path, open_flags::ro).get();
+            auto stream_creator = [f](uint64_t pos, uint64_t len, file_input_stream_options options)->future<input_stream<char>> {
+                co_return input_stream<char>(make_file_data_source(std::move(f), pos, len, std::move(options)));
+            };
+            return make_compressed_file_m_format_input_stream(stream_creator, &c, pos, len, opts, semaphore.make_permit(), std::nullopt);
+        };
+
+        auto expect = [&] (input_stream<char>& in, size_t pos, size_t len) {
+            auto b = in.read_exactly(len).get();
+            BOOST_REQUIRE_EQUAL(std::string_view(b.get(), b.size()), std::string_view(data).substr(pos, len));
+        };
+
+        auto chunk = c.uncompressed_chunk_length();
+
+        {
+            auto in = make_is(0, data.size());
+            expect(in, 0, data.size());
+            BOOST_REQUIRE(in.read().get().empty());
+            in.close().get();
+        }
+
+        {
+            // from the middle of a chunk, skipping within and over chunks read ahead
+            auto in = make_is(chunk / 2, data.size() - chunk / 2);
+            size_t pos = chunk / 2;
+            expect(in, pos, chunk);
+            pos += chunk;
+            in.skip(10).get();
+            pos += 10;
+            expect(in, pos, 100);
+            pos += 100;
+            in.skip(2 * chunk + 7).get();
+            pos += 2 * chunk + 7;
+            expect(in, pos, data.size() - pos);
+            BOOST_REQUIRE(in.read().get().empty());
+            in.close().get();
+        }
+
+        {
+            // closing with a chunk read ahead
+            auto in = make_is(0, data.size());
+            expect(in, 0, 1);
+            in.close().get();
+        }
+    });
+}
+
 // Test that sstables::key_view::tri_compare(const schema& s, partition_key_view other)
 // should correctly compare empty keys. The fact we did this incorrectly was
 // noticed while fixing #9375, and a separate issue on it is #10178.
@@ -164,3 +164,52 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short().value(), 1);
     BOOST_CHECK_EQUAL(req.read_string().value(), "zed");
 }
+
+SEASTAR_THREAD_TEST_CASE(test_response_values_by_reference) {
+    auto res = cql_transport::response(0, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+
+    auto count_placeholder = res.write_int_placeholder();
+    std::vector<bytes_opt> values;
+    for (size_t size : {size_t(0), size_t(100), cql_transport::response::min_referenced_fragment_size, size_t(300 * 1024), size_t(1000)}) {
+        values.push_back(tests::random::get_bytes(size));
+    }
+    values.insert(values.begin() + 2, bytes_opt());
+    // Outlive the response, like the result message in make_result().
+    std::vector<managed_bytes_opt> owned_values;
+    owned_values.reserve(values.size());
+    for (auto& value : values) {
+        owned_values.push_back(value ? managed_bytes_opt(*value) : managed_bytes_opt());
+        res.write_value_by_reference(owned_values.back() ? std::optional<managed_bytes_view>(*owned_values.back()) : std::nullopt);
+        res.write_short(0x1234);
+    }
+    count_placeholder.write(values.size());
+    BOOST_REQUIRE(res.has_referenced_fragments());
+
+    static constexpr auto version = 4;
+    memory_data_sink_buffers buffers;
+    {
+        output_stream<char> out(data_sink(std::make_unique<memory_data_sink>(buffers)));
+        res.write_message(out, version, cql_transport::cql_compression::none, deleter()).get();
+    }
+    auto total_length = buffers.size();
+    BOOST_REQUIRE_EQUAL(total_length, res.size() + 9);
+    auto fbufs = fragmented_temporary_buffer(buffers.buffers() | std::views::as_rvalue | std::ranges::to<std::vector>(), total_length);
+
+    bytes_ostream linearization_buffer;
+    auto req = cql_transport::request_reader(fbufs.get_istream(), linearization_buffer);
+    req.read_byte().value();
+    req.read_byte().value();
+    req.read_short().value();
+    req.read_byte().value();
+    BOOST_CHECK_EQUAL(req.read_int().value() + 9, total_length);
+    BOOST_CHECK_EQUAL(req.read_int().value(), values.size());
+    for (auto& value : values) {
+        auto v = req.read_value_view(version).value();
+        if (value) {
+            BOOST_CHECK_EQUAL(to_bytes(v.value), *value);
+        } else {
+            BOOST_CHECK(v.value.is_null());
+        }
+        BOOST_CHECK_EQUAL(req.read_short().value(), 0x1234);
+    }
+}
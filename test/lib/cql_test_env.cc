@@ -646,6 +646,8 @@ class single_node_cql_env : public cql_test_env {
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
+                    .major_token_range_parallelism = cfg->compaction_major_token_range_parallelism,
+                    .scale_backlog_by_cost = cfg->compaction_scale_backlog_by_cost,
                 };
             });
             _cm.start(std::move(get_cm_cfg), std::ref(abort_sources), std::ref(_task_manager)).get();
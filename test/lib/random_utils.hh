@@ -8,6 +8,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <ranges>
 #include <iostream>
@@ -185,6 +186,33 @@ std::vector<T> random_subset(unsigned n, unsigned m, std::mt19937& engine) {
     return random_subset(std::move(the_set), m, engine);
 }
 
+/// Produces integers in [0, n) following Zipf's law with exponent s,
+/// i.e. 0 is the most frequent value, and the frequency of k is
+/// proportional to 1 / (k + 1)^s.
+template <typename Integer>
+class zipf_distribution {
+    std::vector<double> _cdf;
+public:
+    zipf_distribution(Integer n, double s = 0.99) {
+        SCYLLA_ASSERT(n > 0);
+        _cdf.reserve(n);
+        double sum = 0;
+        for (Integer k = 0; k < n; ++k) {
+            sum += 1.0 / std::pow(double(k + 1), s);
+            _cdf.push_back(sum);
+        }
+        for (auto& c : _cdf) {
+            c /= sum;
+        }
+    }
+    template <typename RandomEngine>
+    Integer operator()(RandomEngine& engine) {
+        auto u = get_real<double>(1, engine);
+        auto it = std::ranges::lower_bound(_cdf, u);
+        return std::min<Integer>(std::distance(_cdf.begin(), it), _cdf.size() - 1);
+    }
+};
+
 inline
 preemption_check random_preempt() {
     return [] () noexcept {
@@ -35,6 +35,8 @@ class test_env_sstables_manager : public sstables_manager {
     using sstables_manager::sstables_manager;
     std::optional<size_t> _promoted_index_block_size;
     bool _correct_pi_block_width = true;
+    std::optional<bool> _split_block_bloom_filter;
+    std::optional<bool> _xor_filter;
 public:
     virtual sstable_writer_config configure_writer(sstring origin = "test") const override {
         auto ret = sstables_manager::configure_writer(std::move(origin));
@@ -42,6 +44,12 @@ class test_env_sstables_manager : public sstables_manager {
             ret.promoted_index_block_size = *_promoted_index_block_size;
         }
         ret.correct_pi_block_width = _correct_pi_block_width;
+        if (_split_block_bloom_filter) {
+            ret.split_block_bloom_filter = *_split_block_bloom_filter;
+        }
+        if (_xor_filter) {
+            ret.xor_filter = *_xor_filter;
+        }
         return ret;
     }
 
@@ -53,6 +61,14 @@ class test_env_sstables_manager : public sstables_manager {
         _correct_pi_block_width = value;
     }
 
+    void set_split_block_bloom_filter(bool value) {
+        _split_block_bloom_filter = value;
+    }
+
+    void set_xor_filter(bool value) {
+        _xor_filter = value;
+    }
+
     void increment_total_reclaimable_memory_and_maybe_reclaim(sstable *sst) {
         sstables_manager::increment_total_reclaimable_memory(sst);
     }
@@ -192,8 +192,9 @@ class test {
         _sst->_generation = std::move(new_generation);
     }
 
-    void create_bloom_filter(uint64_t estimated_partitions, double max_false_pos_prob = 0.1) {
-        _sst->_components->filter = utils::i_filter::get_filter(estimated_partitions, max_false_pos_prob, utils::filter_format::m_format);
+    void create_bloom_filter(uint64_t estimated_partitions, double max_false_pos_prob = 0.1,
+            utils::filter_format format = utils::filter_format::m_format) {
+        _sst->_components->filter = utils::i_filter::get_filter(estimated_partitions, max_false_pos_prob, format);
         _sst->_total_reclaimable_memory.reset();
     }
 
@@ -13,6 +13,8 @@
 #include "schema/schema_builder.hh"
 #include "sstables/mx/types.hh"
 #include "sstables/trie/bti_key_translation.hh"
+#include "sstables/trie/bti_node_reader.hh"
+#include "sstables/trie/bti_node_type.hh"
 
 struct lcb_mismatch_test {
     schema_ptr _s;
@@ -52,3 +54,47 @@ PERF_TEST_F(lcb_mismatch_test, lcb_mismatch) {
     }
 }
 
+
+// Sparse trie nodes of a few sizes, with evenly spread transition bytes.
+struct sparse_node_search_test {
+    std::vector<std::vector<std::byte>> nodes;
+    sparse_node_search_test() {
+        for (int n_children : {4, 16, 64, 200}) {
+            std::vector<std::byte> node;
+            node.push_back(std::byte(sstables::trie::SPARSE_8 << 4));
+            node.push_back(std::byte(n_children));
+            for (int i = 0; i < n_children; ++i) {
+                node.push_back(std::byte(i * 256 / n_children));
+            }
+            for (int i = 0; i < n_children; ++i) {
+                node.push_back(std::byte(i + 1));
+            }
+            nodes.push_back(std::move(node));
+        }
+    }
+    size_t walk_down(size_t node_idx) {
+        const auto& node = nodes[node_idx];
+        for (int k = 0; k < 256; ++k) {
+            auto key = std::byte(k);
+            auto result = sstables::trie::bti_walk_down_along_key(0, node, std::span<const std::byte>(&key, 1));
+            perf_tests::do_not_optimize(result);
+        }
+        return 256;
+    }
+};
+
+PERF_TEST_F(sparse_node_search_test, sparse_node_4_children) {
+    return walk_down(0);
+}
+
+PERF_TEST_F(sparse_node_search_test, sparse_node_16_children) {
+    return walk_down(1);
+}
+
+PERF_TEST_F(sparse_node_search_test, sparse_node_64_children) {
+    return walk_down(2);
+}
+
+PERF_TEST_F(sparse_node_search_test, sparse_node_200_children) {
+    return walk_down(3);
+}
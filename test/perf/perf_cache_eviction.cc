@@ -11,6 +11,7 @@
 #include "test/lib/simple_schema.hh"
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/log.hh"
+#include "test/lib/random_utils.hh"
 #include <seastar/core/app-template.hh>
 #include "replica/database.hh"
 #include "db/config.hh"
@@ -48,6 +49,9 @@ int main(int argc, char** argv) {
         ("trace", "Enables trace-level logging for the test actions")
         ("no-reads", "Disable reads during the test")
         ("seconds", bpo::value<unsigned>()->default_value(60), "Duration [s] after which the test terminates with a success")
+        ("partitions", bpo::value<unsigned>()->default_value(1), "Number of partitions written to. Reads pick partitions with Zipfian popularity")
+        ("scan-period", bpo::value<unsigned>()->default_value(0), "Period [s] of full table scans done alongside the reads, 0 to disable")
+        ("admission-filter", "Enables the cache admission filter (cache_admission_filter)")
         ;
 
     return app.run(argc, argv, [&app] {
@@ -63,10 +67,13 @@ int main(int argc, char** argv) {
         auto& cfg = *cfg_ptr;
         cfg.enable_commitlog(false);
         cfg.enable_cache(true);
+        cfg.cache_admission_filter(app.configuration().contains("admission-filter"));
 
         return do_with_cql_env_thread([&app] (cql_test_env& env) {
             auto reads_enabled = !app.configuration().contains("no-reads");
             auto seconds = app.configuration()["seconds"].as<unsigned>();
+            auto partitions = app.configuration()["partitions"].as<unsigned>();
+            auto scan_period = std::chrono::seconds(app.configuration()["scan-period"].as<unsigned>());
 
             auto stop_test = defer([] {
                 cancelled = true;
@@ -87,6 +94,7 @@ int main(int argc, char** argv) {
 
             uint64_t mutations = 0;
             uint64_t reads = 0;
+            uint64_t scans = 0;
             utils::estimated_histogram reads_hist;
             utils::estimated_histogram writes_hist;
 
@@ -98,14 +106,18 @@ int main(int argc, char** argv) {
             monotonic_counter<uint64_t> pmerges_ctr([&] { return tracker.get_stats().partition_merges; });
             monotonic_counter<uint64_t> eviction_ctr([&] { return tracker.get_stats().row_evictions; });
             monotonic_counter<uint64_t> miss_ctr([&] { return tracker.get_stats().reads_with_misses; });
+            monotonic_counter<uint64_t> scans_ctr([&] { return scans; });
+            monotonic_counter<uint64_t> probation_ctr([&] { return tracker.get_stats().row_probation_insertions; });
             stats_printer.set_callback([&] {
                 auto MB = 1024 * 1024;
-                std::cout << format("rd/s: {:d}, wr/s: {:d}, ev/s: {:d}, pmerge/s: {:d}, miss/s: {:d}, cache: {:d}/{:d} [MB], LSA: {:d}/{:d} [MB], std free: {:d} [MB]",
+                std::cout << format("rd/s: {:d}, wr/s: {:d}, scan/s: {:d}, ev/s: {:d}, pmerge/s: {:d}, miss/s: {:d}, probation/s: {:d}, cache: {:d}/{:d} [MB], LSA: {:d}/{:d} [MB], std free: {:d} [MB]",
                     reads_ctr.change(),
                     mutations_ctr.change(),
+                    scans_ctr.change(),
                     eviction_ctr.change(),
                     pmerges_ctr.change(),
                     miss_ctr.change(),
+                    probation_ctr.change(),
                     tracker.region().occupancy().used_space() / MB,
                     tracker.region().occupancy().total_space() / MB,
                     logalloc::shard_tracker().region_occupancy().used_space() / MB,
@@ -136,7 +148,13 @@ int main(int argc, char** argv) {
                 return dht::decorate_key(*s, key);
             };
 
-            auto pkey = make_pkey("key1");
+            auto key_name = [] (unsigned i) {
+                return format("key{}", i + 1);
+            };
+            std::vector<dht::decorated_key> pkeys;
+            for (unsigned i = 0; i < partitions; ++i) {
+                pkeys.push_back(make_pkey(key_name(i)));
+            }
             sstring value = uninitialized_string(1024);
 
             using clock = std::chrono::steady_clock;
@@ -145,20 +163,35 @@ int main(int argc, char** argv) {
                 if (!reads_enabled) {
                     return;
                 }
-                auto id = env.prepare("select * from ks.cf where pk = 'key1' limit 10;").get();
+                auto id = env.prepare("select * from ks.cf where pk = ? limit 10;").get();
+                tests::random::zipf_distribution<unsigned> popularity(partitions);
                 while (!cancelled) {
+                    auto pk = key_name(popularity(tests::random::gen()));
                     auto t0 = clock::now();
-                    env.execute_prepared(id, {}).get();
+                    env.execute_prepared(id, {{cql3::raw_value::make_value(serialized(pk))}}).get();
                     reads_hist.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - t0).count());
                     ++reads;
                     sleep(100ms).get(); // So that reads don't overwhelm the CPU
                 }
             });
 
+            // Scans touch every partition once, so that they compete for cache
+            // space with the hot partitions of the reader.
+            auto scanner = seastar::async([&] {
+                if (!scan_period.count()) {
+                    return;
+                }
+                while (!cancelled) {
+                    sleep(scan_period).get();
+                    env.execute_cql("select count(*) from ks.cf;").get();
+                    ++scans;
+                }
+            });
+
             auto mutator = seastar::async([&] {
                 int32_t ckey_seq = 0;
                 while (!cancelled) {
-                    mutation m(s, pkey);
+                    mutation m(s, pkeys[unsigned(ckey_seq) % partitions]);
                     auto ck = clustering_key::from_single_value(*s, serialized(ckey_seq++));
                     auto&& col = *s->get_column_definition(to_bytes("v"));
                     m.set_clustered_cell(ck, col, atomic_cell::make_live(*col.type, api::new_timestamp(), serialized(value)));
@@ -171,6 +204,7 @@ int main(int argc, char** argv) {
 
             mutator.get();
             reader.get();
+            scanner.get();
             stats_printer.cancel();
             completion_timer.cancel();
         }, cfg_ptr);
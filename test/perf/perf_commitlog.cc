@@ -31,6 +31,7 @@
 #include "db/commitlog/commitlog.hh"
 #include "utils/assert.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/estimated_histogram.hh"
 
 struct test_config {
     unsigned concurrency;
@@ -46,7 +47,8 @@ struct test_config {
 
 using clperf_result = perf_result_with_aio_writes;
 
-static void write_json_result(std::string result_file, const test_config& cfg, clperf_result median, double mad, double max, double min) {
+static void write_json_result(std::string result_file, const test_config& cfg, clperf_result median, double mad, double max, double min,
+        const utils::estimated_histogram& latencies) {
     Json::Value results;
 
     Json::Value params;
@@ -64,6 +66,9 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
 
     Json::Value stats;
     stats["median tps"] = median.throughput;
+    stats["p50 latency us"] = Json::Int64(latencies.percentile(0.5));
+    stats["p99 latency us"] = Json::Int64(latencies.percentile(0.99));
+    stats["p999 latency us"] = Json::Int64(latencies.percentile(0.999));
     stats["allocs_per_op"] = median.mallocs_per_op;
     stats["logallocs_per_op"] = median.logallocs_per_op;
     stats["tasks_per_op"] = median.tasks_per_op;
@@ -112,6 +117,8 @@ struct commitlog_service {
     std::optional<db::commitlog> log;
     std::optional<db::commitlog::flush_handler_anchor> fa;
     timer<> flush_timer;
+    // Latencies of add_mutation, in microseconds
+    utils::estimated_histogram latencies;
 
     commitlog_service(const test_config& c)
         : cfg(c)
@@ -144,9 +151,11 @@ static std::vector<clperf_result> do_commitlog_test(sharded<commitlog_service>&
     return time_parallel_ex<clperf_result>([&] {
         auto& log = cls.local();
         size_t size = log.size_dist(tests::random::gen());
+        auto start = utils::estimated_histogram::clock::now();
         return log.log->add_mutation(uuid, size, db::commitlog::force_sync::no, [size](db::commitlog::output& dst) {
             dst.fill('1', size);
-        }).then([](db::rp_handle h) {
+        }).then([&log, start](db::rp_handle h) {
+            log.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(utils::estimated_histogram::clock::now() - start).count());
             h.release();
         });
     }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, true, &clperf_result::update);
@@ -165,6 +174,7 @@ int main(int argc, char** argv) {
         ("commitlog-segment-size-in-mb", bpo::value<unsigned>(), "commitlog segment size")
         ("commitlog-total-space-in-mb", bpo::value<unsigned>(), "total commitlog size")
         ("commitlog-sync-period-in-ms", bpo::value<unsigned>(), "how long the system waits for other writes before performing a sync in \"periodic\" mode")
+        ("commitlog-group-commit-window-in-us", bpo::value<unsigned>(), "group commit window of \"batch\" mode")
         ("commitlog-use-o-dsync", bpo::value<bool>()->default_value(true), "whether or not to use O_DSYNC mode for commitlog segments io")
         ("commitlog-use-hard-size-limit", bpo::value<bool>()->default_value(true), "whether or not to use a hard size limit for commitlog disk usage")
 
@@ -204,6 +214,9 @@ int main(int argc, char** argv) {
         if (app.configuration().contains("commitlog-sync-period-in-ms")) {
             db_cfg->commitlog_sync_period_in_ms(app.configuration()["commitlog-sync-period-in-ms"].as<unsigned>());
         }
+        if (app.configuration().contains("commitlog-group-commit-window-in-us")) {
+            db_cfg->commitlog_group_commit_window_in_us(app.configuration()["commitlog-group-commit-window-in-us"].as<unsigned>());
+        }
         if (app.configuration().contains("commitlog-use-o-dsync")) {
             db_cfg->commitlog_use_o_dsync(app.configuration()["commitlog-use-o-dsync"].as<bool>());
         }
@@ -264,8 +277,17 @@ int main(int argc, char** argv) {
             auto mad = absolute_deviations[results.size() / 2];
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
 
+            // Write latency matters most in batch mode, where writes wait for the flush.
+            auto latencies = co_await test_commitlog.map_reduce0([] (const commitlog_service& cls) {
+                return cls.latencies;
+            }, utils::estimated_histogram(), [] (utils::estimated_histogram a, const utils::estimated_histogram& b) {
+                return a.merge(b);
+            });
+            std::cout << format("latency: 50%: {} [us], 99%: {} [us], 99.9%: {} [us], max: {} [us]\n",
+                    latencies.percentile(0.5), latencies.percentile(0.99), latencies.percentile(0.999), latencies.percentile(1.0));
+
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min, latencies);
             }
         } catch (...) {
             ex = std::current_exception();
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "seastarx.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/log.hh"
+#include "test/lib/random_utils.hh"
+#include <seastar/core/app-template.hh>
+#include "replica/database.hh"
+#include "db/config.hh"
+#include "utils/div_ceil.hh"
+#include "utils/estimated_histogram.hh"
+
+// Measures the read latency dip caused by a major compaction replacing the
+// sstables of a table with a warm index cache by new ones.
+//
+// Reads bypass the row cache, so that every read goes through the partition
+// index. The latency and index cache misses of reads done before the major
+// compaction are compared to those of the reads done right after it, with and
+// without compaction_preheat_key_cache.
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("partitions", bpo::value<unsigned>()->default_value(200000), "Number of partitions in the table")
+        ("sstables", bpo::value<unsigned>()->default_value(4), "Number of sstables compacted by the major compaction")
+        ("reads", bpo::value<unsigned>()->default_value(10000), "Number of reads in each measured phase. Reads pick partitions with Zipfian popularity")
+        ("preheat", "Enables compaction_preheat_key_cache")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        if (smp::count != 1) {
+            throw std::runtime_error("This test has to be run with --smp=1");
+        }
+
+        auto cfg_ptr = make_shared<db::config>();
+        auto& cfg = *cfg_ptr;
+        cfg.enable_commitlog(false);
+        cfg.compaction_preheat_key_cache(app.configuration().contains("preheat"));
+
+        return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            auto partitions = app.configuration()["partitions"].as<unsigned>();
+            auto sstables = app.configuration()["sstables"].as<unsigned>();
+            auto reads = app.configuration()["reads"].as<unsigned>();
+
+            env.execute_cql("CREATE TABLE ks.cf (pk int PRIMARY KEY, v text) WITH caching = {'enabled': 'false'}").get();
+            replica::database& db = env.local_db();
+            auto s = db.find_schema("ks", "cf");
+            replica::column_family& cf = db.find_column_family(s->id());
+            cf.disable_auto_compaction().get();
+
+            testlog.info("Populating {} partitions in {} sstables", partitions, sstables);
+            auto insert = env.prepare("insert into ks.cf (pk, v) values (?, ?);").get();
+            auto value = cql3::raw_value::make_value(serialized(sstring(100, 'v')));
+            for (unsigned i = 0; i < partitions; ++i) {
+                env.execute_prepared(insert, {cql3::raw_value::make_value(serialized(int32_t(i))), value}).get();
+                if ((i + 1) % div_ceil(partitions, sstables) == 0) {
+                    cf.flush().get();
+                }
+            }
+            cf.flush().get();
+
+            auto select = env.prepare("select * from ks.cf where pk = ?;").get();
+            tests::random::zipf_distribution<unsigned> popularity(partitions);
+            auto& index_stats = db.row_cache_tracker().get_partition_index_cache_stats();
+            auto& index_file_stats = db.row_cache_tracker().get_index_cached_file_stats();
+
+            using clock = std::chrono::steady_clock;
+            auto run_reads = [&] (sstring phase) {
+                utils::estimated_histogram hist;
+                auto index_misses = index_stats.misses;
+                auto page_misses = index_file_stats.page_misses;
+                for (unsigned i = 0; i < reads; ++i) {
+                    auto pk = int32_t(popularity(tests::random::gen()));
+                    auto t0 = clock::now();
+                    env.execute_prepared(select, {cql3::raw_value::make_value(serialized(pk))}).get();
+                    hist.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - t0).count());
+                }
+                std::cout << format("{:<20} 50%: {:-6d}, 90%: {:-6d}, 99%: {:-6d}, 99.9%: {:-6d}, max: {:-6d} [us], index misses: {:d}, index page misses: {:d}",
+                        phase,
+                        hist.percentile(0.5),
+                        hist.percentile(0.9),
+                        hist.percentile(0.99),
+                        hist.percentile(0.999),
+                        hist.percentile(1.0),
+                        index_stats.misses - index_misses,
+                        index_file_stats.page_misses - page_misses) << "\n";
+            };
+
+            run_reads("warmup:");
+            run_reads("before compaction:");
+
+            auto t0 = clock::now();
+            cf.compact_all_sstables(tasks::task_info{}).get();
+            testlog.info("Major compaction took {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count());
+
+            run_reads("after compaction:");
+            run_reads("steady state:");
+        }, cfg_ptr);
+    });
+}
@@ -219,6 +219,88 @@ void test_scan_with_range_delete_over_rows() {
     tracker.cleaner().drain().get();
 }
 
+// Point reads of partitions with Zipfian popularity, mixed with one-off scans
+// of cold ranges. The cache is limited to a fraction of the data, so the hit
+// ratio of point reads shows how well the hot partitions survive the scans,
+// with and without the admission filter.
+void test_zipfian_reads_with_scans(bool admission_filter) {
+    std::cout << __FUNCTION__ << ", admission filter: " << admission_filter << std::endl;
+
+    simple_schema ss;
+    auto s = ss.schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    cache_tracker tracker;
+    tracker.set_admission_filter(utils::updateable_value<bool>(admission_filter));
+    memtable_snapshot_source mss(s);
+
+    const int partition_count = 20000;
+    const uint64_t cache_partitions = partition_count / 10;
+    const int scan_length = cache_partitions / 2;
+    const int operations = 200000;
+    const double scan_probability = 0.002;
+
+    auto keys = ss.make_pkeys(partition_count);
+    auto val = sstring(sstring::initialized_later(), cell_size);
+    for (auto& key : keys) {
+        mutation m(s, key);
+        ss.add_row(m, ss.make_ckey(0), val);
+        mss.apply(m);
+    }
+
+    // The most popular partitions should not be neighbours in the ring.
+    std::vector<int> popularity(partition_count);
+    std::iota(popularity.begin(), popularity.end(), 0);
+    std::shuffle(popularity.begin(), popularity.end(), tests::random::gen());
+    tests::random::zipf_distribution<int> zipf(partition_count);
+
+    row_cache cache(s, snapshot_source([&] { return mss(); }), tracker);
+
+    auto read = [&] (const dht::partition_range& pr) {
+        auto rd = cache.make_reader(s, semaphore.make_permit(), pr);
+        auto close_reader = deferred_close(rd);
+        rd.consume_pausable([](mutation_fragment_v2) {
+            return stop_iteration(cancelled);
+        }).get();
+        while (tracker.partitions() > cache_partitions) {
+            if (tracker.region().evict_some() == memory::reclaiming_result::reclaimed_nothing) {
+                break;
+            }
+        }
+    };
+
+    uint64_t point_reads = 0;
+    uint64_t point_hits = 0;
+    uint64_t scans = 0;
+
+    auto d = duration_in_seconds([&] {
+        for (int i = 0; i < operations && !cancelled; ++i) {
+            if (tests::random::with_probability(scan_probability)) {
+                auto first = tests::random::get_int<int>(partition_count - scan_length);
+                read(dht::partition_range::make({keys[first]}, {keys[first + scan_length - 1]}));
+                ++scans;
+            } else {
+                auto misses = tracker.get_stats().partition_misses;
+                read(dht::partition_range::make_singular(keys[popularity[zipf(tests::random::gen())]]));
+                ++point_reads;
+                point_hits += tracker.get_stats().partition_misses == misses;
+            }
+            seastar::thread::maybe_yield();
+        }
+    });
+
+    fmt::print(std::cout, "point reads: {:d}, hit ratio: {:.3f}, scans: {:d}, probation insertions: {:d}, time: {:.3f} [s]\n",
+               point_reads,
+               point_reads ? double(point_hits) / point_reads : 0.0,
+               scans,
+               tracker.get_stats().row_probation_insertions,
+               d.count());
+
+    // Clean gently to avoid reactor stalls in destructors
+    cache.invalidate(row_cache::external_updater([]{})).get();
+    tracker.cleaner().drain().get();
+}
+
 int main(int argc, char** argv) {
     app_template app;
     return app.run(argc, argv, [] {
@@ -229,6 +311,8 @@ int main(int argc, char** argv) {
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
             test_scans_with_dummy_entries();
             test_scan_with_range_delete_over_rows();
+            test_zipfian_reads_with_scans(false);
+            test_zipfian_reads_with_scans(true);
         });
     });
 }
@@ -56,6 +56,20 @@ future<> test_partitioned_streaming(sharded<perf_sstable_test_env>& dt) {
     return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::partitioned_streaming);
 }
 
+future<> test_filter_check(sharded<perf_sstable_test_env>& dt) {
+    return seastar::async([&dt] {
+        for (unsigned nr_sstables : {1u, 8u, 32u, 128u}) {
+            dt.invoke_on_all([nr_sstables] (perf_sstable_test_env& t) {
+                return t.prepare_filter_check(nr_sstables);
+            }).get();
+            std::cout << nr_sstables << " sstables, serial: ";
+            time_runs(iterations, parallelism, dt, &perf_sstable_test_env::filter_check_serial).get();
+            std::cout << nr_sstables << " sstables, batched: ";
+            time_runs(iterations, parallelism, dt, &perf_sstable_test_env::filter_check_batched).get();
+        }
+    });
+}
+
 enum class test_modes {
     sequential_read,
     index_read,
@@ -64,6 +78,7 @@ enum class test_modes {
     compaction,
     full_scan_streaming,
     partitioned_streaming,
+    filter_check,
 };
 
 static const std::unordered_map<sstring, test_modes> test_mode = {
@@ -74,6 +89,7 @@ static const std::unordered_map<sstring, test_modes> test_mode = {
     {"compaction", test_modes::compaction },
     {"full_scan_streaming", test_modes::full_scan_streaming },
     {"parititioned_streaming", test_modes::partitioned_streaming },
+    {"filter_check", test_modes::filter_check },
 };
 
 std::istream& operator>>(std::istream& is, test_modes& mode) {
@@ -110,7 +126,9 @@ int scylla_sstable_main(int argc, char** argv) {
         ("num_columns", bpo::value<unsigned>()->default_value(5), "number of columns per row")
         ("column_size", bpo::value<unsigned>()->default_value(64), "size in bytes for each column")
         ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction mode)")
-        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming")
+        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming, filter_check")
+        ("filter_keys", bpo::value<unsigned>()->default_value(100000), "number of keys in the filter of each sstable (valid only for filter_check mode)")
+        ("split_block_filter", bpo::value<bool>()->default_value(false), "use split block bloom filters (valid only for filter_check mode)")
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
@@ -139,6 +157,10 @@ int scylla_sstable_main(int argc, char** argv) {
             }
             cfg.compaction_strategy = compaction::compaction_strategy::type(app.configuration()["compaction-strategy"].as<sstring>());
             cfg.timestamp_range = app.configuration()["timestamp-range"].as<api::timestamp_type>();
+            cfg.filter_keys = app.configuration()["filter_keys"].as<unsigned>();
+            cfg.filter_format = app.configuration()["split_block_filter"].as<bool>()
+                    ? utils::filter_format::split_block_format
+                    : utils::filter_format::m_format;
             auto scf = make_sstable_compressor_factory_for_tests_in_thread();
             test.start(std::move(cfg), std::ref(*scf)).get();
             auto stop_test = deferred_stop(test);
@@ -168,6 +190,8 @@ int scylla_sstable_main(int argc, char** argv) {
             case compaction:
                 test_setup::create_empty_test_dir(dir).get();
                 break;
+            case filter_check:
+                break;
             }
 
             switch (mode) {
@@ -192,6 +216,9 @@ int scylla_sstable_main(int argc, char** argv) {
             case compaction:
                 test_compaction(test).get();
                 break;
+            case filter_check:
+                test_filter_check(test).get();
+                break;
             }
         });
     });
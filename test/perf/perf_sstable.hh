@@ -99,6 +99,8 @@ class perf_sstable_test_env {
         sstring dir;
         compaction::compaction_strategy_type compaction_strategy;
         api::timestamp_type timestamp_range;
+        unsigned filter_keys;
+        utils::filter_format filter_format;
     };
 
 private:
@@ -128,6 +130,13 @@ class perf_sstable_test_env {
     std::uniform_int_distribution<char> _distribution;
     lw_shared_ptr<replica::memtable> _mt;
     std::vector<shared_sstable> _sst;
+    // Filter-only sstables and (mostly absent) keys for the filter check modes.
+    std::vector<shared_sstable> _filter_sst;
+    std::vector<utils::hashed_key> _filter_probes;
+
+    static utils::hashed_key random_hashed_key() {
+        return utils::hashed_key({tests::random::get_int<uint64_t>(), tests::random::get_int<uint64_t>()});
+    }
 
     schema_ptr create_schema(compaction::compaction_strategy_type type) {
         schema_builder builder("ks", "perf-test", generate_legacy_id("ks", "perf-test"));
@@ -205,6 +214,7 @@ class perf_sstable_test_env {
 
     future<> stop() {
         _sst.clear();
+        _filter_sst.clear();
         return _env.stop();
     }
 
@@ -344,6 +354,55 @@ class perf_sstable_test_env {
         });
     }
 
+    // Creates nr_sstables sstables which have only an in-memory filter,
+    // each holding filter_keys random keys.
+    future<> prepare_filter_check(unsigned nr_sstables) {
+        return seastar::async([this, nr_sstables] {
+            _filter_sst.clear();
+            for (unsigned i = 0; i < nr_sstables; ++i) {
+                auto sst = _env.make_sstable(s);
+                auto t = sstables::test(sst);
+                t.create_bloom_filter(_cfg.filter_keys, s->bloom_filter_fp_chance(), _cfg.filter_format);
+                for (unsigned k = 0; k < _cfg.filter_keys; ++k) {
+                    t.get_filter()->add(random_hashed_key());
+                    thread::maybe_yield();
+                }
+                _filter_sst.push_back(std::move(sst));
+            }
+            _filter_probes.clear();
+            for (unsigned k = 0; k < 4096; ++k) {
+                _filter_probes.push_back(random_hashed_key());
+            }
+        });
+    }
+
+    // Checks every probe key against the filters of all sstables, one sstable at a time.
+    future<double> filter_check_serial(int idx) {
+        const auto start = perf_sstable_test_env::now();
+        uint64_t survivors = 0;
+        for (const auto& hk : _filter_probes) {
+            for (const auto& sst : _filter_sst) {
+                survivors += sst->filter_has_key(hk);
+            }
+        }
+        const auto duration = std::chrono::duration<double>(perf_sstable_test_env::now() - start).count();
+        testlog.trace("{} survivors", survivors);
+        return make_ready_future<double>(_filter_probes.size() / duration);
+    }
+
+    // Checks every probe key against the filters of all sstables with filter_sstables_by_key().
+    future<double> filter_check_batched(int idx) {
+        const auto start = perf_sstable_test_env::now();
+        uint64_t survivors = 0;
+        for (const auto& hk : _filter_probes) {
+            auto bits = filter_sstables_by_key(_filter_sst, hk);
+            survivors += bits.find_first_set() != utils::dynamic_bitset::npos;
+        }
+        const auto duration = std::chrono::duration<double>(perf_sstable_test_env::now() - start).count();
+        testlog.trace("{} survivors", survivors);
+        return make_ready_future<double>(_filter_probes.size() / duration);
+    }
+
     future<double> full_scan_streaming(int idx) {
         return do_streaming(sst_reader::full_scan);
     }
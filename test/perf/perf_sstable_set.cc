@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "sstables/sstable_set.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstable_compressor_factory.hh"
+#include "test/lib/key_utils.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/simple_schema.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+
+using namespace sstables;
+
+// Models the sstable set of a large leveled table: a handful of
+// overlapping L0 sstables on top of levels of disjoint runs, adding up
+// to ~10k sstables.
+class leveled_sstable_set {
+    static constexpr size_t key_count = 40000;
+    static constexpr size_t l0_count = 4;
+    static constexpr std::array<size_t, 4> level_sizes = {10, 100, 1000, 8886};
+
+    std::unique_ptr<sstable_compressor_factory> _scf = make_sstable_compressor_factory_for_tests_in_thread();
+    test_env _env{test_env_config{}, *_scf};
+protected:
+    simple_schema _ss;
+    schema_ptr _s = _ss.schema();
+    std::vector<dht::decorated_key> _keys = tests::generate_partition_keys(key_count, _s);
+    std::vector<shared_sstable> _leveled;
+    sstable_set _set = make_partitioned_sstable_set(_s, dht::token_range::make_open_ended_both_sides());
+
+    shared_sstable make_sstable(uint32_t level, const partition_key& first, const partition_key& last) {
+        auto sst = _env.make_sstable(_s);
+        sstables::test(sst).set_values_for_leveled_strategy(1, level, 0, first, last);
+        return sst;
+    }
+
+    const dht::decorated_key& random_key() {
+        return _keys[tests::random::get_int<size_t>(0, _keys.size() - 1)];
+    }
+public:
+    leveled_sstable_set() {
+        for (size_t i = 0; i < l0_count; ++i) {
+            _set.insert(make_sstable(0, _keys.front().key(), _keys.back().key()));
+        }
+        uint32_t level = 1;
+        for (auto n : level_sizes) {
+            auto keys_per_sstable = _keys.size() / n;
+            for (size_t i = 0; i < n; ++i) {
+                auto sst = make_sstable(level, _keys[i * keys_per_sstable].key(), _keys[(i + 1) * keys_per_sstable - 1].key());
+                _set.insert(sst);
+                _leveled.push_back(std::move(sst));
+            }
+            ++level;
+        }
+    }
+
+    ~leveled_sstable_set() {
+        _set = make_partitioned_sstable_set(_s, dht::token_range::make_open_ended_both_sides());
+        _leveled.clear();
+        _env.stop().get();
+    }
+};
+
+PERF_TEST_F(leveled_sstable_set, select_single_partition) {
+    auto range = dht::partition_range::make_singular(random_key());
+    perf_tests::do_not_optimize(_set.select(range));
+}
+
+PERF_TEST_F(leveled_sstable_set, incremental_selector_single_partition) {
+    auto sel = _set.make_incremental_selector();
+    perf_tests::do_not_optimize(sel.select(dht::ring_position_view(random_key())).sstables.size());
+}
+
+PERF_TEST_F(leveled_sstable_set, incremental_selector_full_scan) {
+    auto sel = _set.make_incremental_selector();
+    auto pos = dht::ring_position_view::min();
+    size_t steps = 0;
+    while (!pos.is_max()) {
+        pos = sel.select(pos).next_position;
+        ++steps;
+    }
+    return steps;
+}
+
+// A compaction-like update: clone the set, swap out one sstable of the
+// last level for a replacement covering the same keys.
+PERF_TEST_F(leveled_sstable_set, clone_and_replace) {
+    auto idx = tests::random::get_int<size_t>(0, _leveled.size() - 1);
+    auto old_sst = _leveled[idx];
+    auto new_sst = make_sstable(old_sst->get_sstable_level(),
+            old_sst->get_first_decorated_key().key(), old_sst->get_last_decorated_key().key());
+    auto set = _set;
+    set.erase(old_sst);
+    set.insert(new_sst);
+    _set = std::move(set);
+    _leveled[idx] = std::move(new_sst);
+}
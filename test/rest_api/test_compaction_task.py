@@ -181,6 +181,8 @@ def test_rewrite_sstables_keyspace_compaction_task_async(cql, rest_api, test_key
     checkout_async_task(cql, rest_api, test_keyspace, lambda keyspace: rest_api.send("GET", f"tasks/compaction/keyspace_upgrade_sstables/{keyspace}"), "upgrade sstables compaction")
     # scrub sstables compaction
     checkout_async_task(cql, rest_api, test_keyspace, lambda keyspace: rest_api.send("GET", f"tasks/compaction/keyspace_scrub/{keyspace}"), "scrub sstables compaction")
+    # garbage collection compaction
+    checkout_async_task(cql, rest_api, test_keyspace, lambda keyspace: rest_api.send("GET", f"tasks/compaction/keyspace_garbage_collect/{keyspace}"), "garbage collection sstables compaction")
 
 @pytest.mark.parametrize("injection", ["major_keyspace_compaction_task_impl_run_fail",
                                        "shard_major_keyspace_compaction_task_impl_run_fail",
@@ -1353,6 +1353,7 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::ExtTimestampStats: return "ext_timestamp_stats";
         case sstables::scylla_metadata_type::SSTableIdentifier: return "sstable_identifier";
         case sstables::scylla_metadata_type::Schema: return "schema";
+        case sstables::scylla_metadata_type::TombstoneHistograms: return "tombstone_histograms";
     }
     std::abort();
 }
@@ -1416,6 +1417,8 @@ class scylla_metadata_visitor {
                 {sstables::sstable_feature::CorrectEmptyCounters, "CorrectEmptyCounters"},
                 {sstables::sstable_feature::CorrectUDTsInCollections, "CorrectUDTsInCollections"},
                 {sstables::sstable_feature::CorrectLastPiBlockWidth, "CorrectLastPiBlockWidth"},
+                {sstables::sstable_feature::SplitBlockBloomFilter, "SplitBlockBloomFilter"},
+                {sstables::sstable_feature::XorFilter, "XorFilter"},
         };
         _writer.StartObject();
         _writer.Key("mask");
@@ -1484,6 +1487,30 @@ class scylla_metadata_visitor {
         _writer.EndArray();
     }
 
+    void operator()(const sstables::tombstone_histogram_bin& b) const {
+        _writer.StartObject();
+        _writer.Key("deletion_time");
+        _writer.Double(b.deletion_time);
+        _writer.Key("count");
+        _writer.Uint64(b.count);
+        _writer.EndObject();
+    }
+
+    void operator()(const sstables::token_range_tombstone_histogram& h) const {
+        _writer.StartObject();
+        _writer.Key("token_range");
+        _writer.Uint(h.token_range);
+        _writer.Key("first_token");
+        _writer.Int64(h.first_token);
+        _writer.Key("last_token");
+        _writer.Int64(h.last_token);
+        _writer.Key("cells_count");
+        _writer.Uint64(h.cells_count);
+        _writer.Key("histogram");
+        (*this)(h.histogram);
+        _writer.EndObject();
+    }
+
     void operator()(const sstables::scylla_metadata::sstable_identifier& sid) const {
         _writer.AsString(sid.value);
     }
@@ -38,7 +38,21 @@ class response {
     cql_binary_opcode _opcode;
     uint8_t           _flags = 0; // a bitwise OR mask of zero or more cql_frame_flags values
     bytes_ostream _body;
+
+    // A fragment of a value which is not copied into _body, see write_value_by_reference().
+    struct referenced_fragment {
+        // Offset in _body at which the fragment belongs.
+        size_t offset;
+        bytes_view data;
+    };
+    std::vector<referenced_fragment> _referenced_fragments; // sorted by offset
+    size_t _referenced_size = 0;
+    // Keeps the referenced fragments alive.
+    seastar::deleter _referenced_data_owner;
 public:
+    // Smaller fragments are copied into the body even by write_value_by_reference().
+    static constexpr size_t min_referenced_fragment_size = 16 * 1024;
+
     template<typename T>
     class placeholder;
 
@@ -76,6 +90,17 @@ class response {
     void write_string_bytes_map(const std::unordered_map<sstring, bytes>& map);
     void write_value(bytes_opt value);
     void write_value(std::optional<managed_bytes_view> value);
+    // Like write_value(), but large fragments of the value are referenced by
+    // the response instead of being copied into it. The caller has to keep
+    // them alive until the response is written, using hold().
+    void write_value_by_reference(std::optional<managed_bytes_view> value);
+    bool has_referenced_fragments() const noexcept {
+        return !_referenced_fragments.empty();
+    }
+    // Keeps d alive as long as the response.
+    void hold(seastar::deleter d) {
+        _referenced_data_owner.append(std::move(d));
+    }
     void write(const cql3::metadata& m, const cql_metadata_id_wrapper& request_metadata_id, bool no_metadata = false);
     void write(const cql3::prepared_metadata& m, uint8_t version);
 
@@ -85,9 +110,37 @@ class response {
         return _opcode;
     }
     size_t size() const {
-        return _body.size();
+        return _body.size() + _referenced_size;
     }
 private:
+    // Calls func for each fragment of the body, in order, including the referenced ones.
+    template <typename Func>
+    void for_each_fragment(Func&& func) const {
+        auto ref = _referenced_fragments.begin();
+        size_t offset = 0;
+        for (bytes_view fragment : _body) {
+            while (ref != _referenced_fragments.end() && ref->offset < offset + fragment.size()) {
+                auto n = ref->offset - offset;
+                if (n) {
+                    func(fragment.substr(0, n));
+                    fragment.remove_prefix(n);
+                    offset += n;
+                }
+                func(ref->data);
+                ++ref;
+            }
+            if (!fragment.empty()) {
+                func(fragment);
+                offset += fragment.size();
+            }
+        }
+        for (; ref != _referenced_fragments.end(); ++ref) {
+            func(ref->data);
+        }
+    }
+    // Copies the referenced fragments into the body.
+    void copy_referenced_fragments();
+
     void compress(cql_compression compression);
     void compress_lz4();
     void compress_snappy();
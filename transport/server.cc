@@ -1046,7 +1046,7 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_op
 }
 
 std::unique_ptr<cql_server::response>
-make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
+make_result(int16_t stream, ::shared_ptr<messages::result_message> msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata = false);
 
 template <typename Process>
@@ -1156,7 +1156,7 @@ process_query_internal(service::client_state& client_state, sharded<cql3::query_
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
 
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, cql_metadata_id_wrapper{}, skip_metadata)));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, q_state->query_state.get_trace_state(), version, cql_metadata_id_wrapper{}, skip_metadata)));
         }
     });
 }
@@ -1190,7 +1190,7 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
             cql_metadata_id_wrapper metadata_id = is_metadata_id_supported(client_state)
                 ? cql_metadata_id_wrapper(msg->get_metadata_id())
                 : cql_metadata_id_wrapper();
-            return make_result(stream, *msg, trace_state, _version, std::move(metadata_id));
+            return make_result(stream, msg, trace_state, _version, std::move(metadata_id));
         });
     });
 }
@@ -1278,7 +1278,7 @@ process_execute_internal(service::client_state& client_state, sharded<cql3::quer
             return cql_server::process_fn_return_type(convert_error_message_to_coordinator_result(msg.get()));
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, std::move(metadata_id), skip_metadata)));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, q_state->query_state.get_trace_state(), version, std::move(metadata_id), skip_metadata)));
         }
     });
 }
@@ -1423,7 +1423,7 @@ process_batch_internal(service::client_state& client_state, sharded<cql3::query_
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
 
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, trace_state, version, cql_metadata_id_wrapper{})));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, trace_state, version, cql_metadata_id_wrapper{})));
         }
     });
 }
@@ -1711,7 +1711,12 @@ class cql_server::fmt_visitor : public messages::result_message::visitor_base {
                 _row_count++;
             }
             void accept_value(std::optional<managed_bytes_view> cell) {
-                _response.write_value(cell);
+                // The message is kept alive by the response, see make_result().
+                _response.write_value_by_reference(cell);
+            }
+            // Key components exploded by result_generator, which don't outlive the call.
+            void accept_value(bytes_view key_component) {
+                _response.write_value(managed_bytes_view(key_component));
             }
             void end_row() { }
 
@@ -1725,19 +1730,25 @@ class cql_server::fmt_visitor : public messages::result_message::visitor_base {
 };
 
 std::unique_ptr<cql_server::response>
-make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
+make_result(int16_t stream, ::shared_ptr<messages::result_message> msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata) {
     auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::RESULT, tr_state);
-    if (!msg.warnings().empty() && version > 3) [[unlikely]] {
+    if (!msg->warnings().empty() && version > 3) [[unlikely]] {
         response->set_frame_flag(cql_frame_flags::warning);
-        response->write_string_list(msg.warnings());
+        response->write_string_list(msg->warnings());
     }
-    if (msg.custom_payload()) {
+    if (msg->custom_payload()) {
         response->set_frame_flag(cql_frame_flags::custom_payload);
-        response->write_string_bytes_map(msg.custom_payload().value());
+        response->write_string_bytes_map(msg->custom_payload().value());
     }
     cql_server::fmt_visitor fmt{version, *response, skip_metadata, std::move(metadata_id)};
-    msg.accept(fmt);
+    msg->accept(fmt);
+    if (response->has_referenced_fragments()) {
+        // Large cell values of rows results are referenced rather than copied,
+        // so the message, and the query results it holds, must outlive the response.
+        // The response may be written and destroyed on another shard.
+        response->hold(make_object_deleter(make_foreign(std::move(msg))));
+    }
     return response;
 }
 
@@ -1781,16 +1792,26 @@ void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_serv
 
 future<> cql_server::response::write_message(output_stream<char>& out, uint8_t version, cql_compression compression, seastar::deleter del) {
     if (compression != cql_compression::none) {
+        // The compressors need the whole body.
+        if (has_referenced_fragments()) {
+            copy_referenced_fragments();
+        }
         compress(compression);
     }
-    utils::result_with_exception_ptr<temporary_buffer<char>> frame = make_frame(version, _body.size());
+    utils::result_with_exception_ptr<temporary_buffer<char>> frame = make_frame(version, size());
     if (!frame) [[unlikely]] {
         return make_exception_future<>(std::move(frame).assume_error());
     }
-    return out.write(std::move(frame).assume_value()).then([this, &out, del = std::move(del)] mutable {
-        return do_for_each(_body.begin(), _body.end(), [&out, del = std::move(del)] (bytes_view fragment) mutable {
-            temporary_buffer<char> buf(reinterpret_cast<char*>(const_cast<signed char*>(fragment.data())), fragment.size(), del.share());
-            return out.write(std::move(buf));
+    std::vector<bytes_view> fragments;
+    for_each_fragment([&fragments] (bytes_view fragment) {
+        fragments.push_back(fragment);
+    });
+    return out.write(std::move(frame).assume_value()).then([&out, fragments = std::move(fragments), del = std::move(del)] mutable {
+        return do_with(std::move(fragments), [&out, del = std::move(del)] (std::vector<bytes_view>& fragments) mutable {
+            return do_for_each(fragments, [&out, del = std::move(del)] (bytes_view fragment) mutable {
+                temporary_buffer<char> buf(reinterpret_cast<char*>(const_cast<signed char*>(fragment.data())), fragment.size(), del.share());
+                return out.write(std::move(buf));
+            });
         }).then([&out] {
             return out.flush();
         });
@@ -2032,6 +2053,37 @@ void cql_server::response::write_value(std::optional<managed_bytes_view> value)
     }
 }
 
+void cql_server::response::write_value_by_reference(std::optional<managed_bytes_view> value)
+{
+    if (!value) {
+        write_int(-1);
+        return;
+    }
+
+    write_int(value->size_bytes());
+    while (!value->empty()) {
+        auto fragment = value->current_fragment();
+        if (fragment.size() >= min_referenced_fragment_size) {
+            _referenced_fragments.push_back({_body.size(), fragment});
+            _referenced_size += fragment.size();
+        } else {
+            _body.write(fragment);
+        }
+        value->remove_current();
+    }
+}
+
+void cql_server::response::copy_referenced_fragments()
+{
+    bytes_ostream body;
+    for_each_fragment([&body] (bytes_view fragment) {
+        body.write(fragment);
+    });
+    _body = std::move(body);
+    _referenced_fragments.clear();
+    _referenced_size = 0;
+}
+
 class type_codec {
 private:
     enum class type_id : int16_t {
@@ -240,7 +240,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
 private:
     class fmt_visitor;
     friend class connection;
-    friend std::unique_ptr<cql_server::response> make_result(int16_t stream, messages::result_message& msg,
+    friend std::unique_ptr<cql_server::response> make_result(int16_t stream, ::shared_ptr<messages::result_message> msg,
             const tracing::trace_state_ptr& tr_state, cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata);
 
     class connection : public generic_server::connection {
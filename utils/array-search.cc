@@ -14,6 +14,9 @@
 #else
 #define arch_target(name)
 #endif
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
 
 namespace utils {
 
@@ -52,6 +55,57 @@ arch_target("default") unsigned array_search_x32_eq_impl(uint8_t val, const uint
     return array_search_eq_impl(val, arr, 32 * nr);
 }
 
+static inline unsigned array_search_sorted_ge_tail(uint8_t val, const uint8_t* arr, unsigned i, unsigned len) {
+    while (i < len && arr[i] < val) {
+        i++;
+    }
+    return i;
+}
+
+namespace internal {
+
+unsigned array_search_sorted_ge_scalar(uint8_t val, const uint8_t* arr, unsigned len) {
+    return array_search_sorted_ge_tail(val, arr, 0, len);
+}
+
+}
+
+#ifdef __aarch64__
+
+namespace internal {
+
+unsigned array_search_sorted_ge_neon(uint8_t val, const uint8_t* arr, unsigned len) {
+    auto k = vdupq_n_u8(val);
+    unsigned i = 0;
+    for (; i + 16 <= len; i += 16) {
+        // Each element >= val gives 0xff. The array is sorted, so these
+        // are at the tail and the number of the other ones is the index.
+        auto ge = vcgeq_u8(vld1q_u8(arr + i), k);
+        auto n_ge = vaddvq_u8(vshrq_n_u8(ge, 7));
+        if (n_ge) {
+            return i + 16 - n_ge;
+        }
+    }
+    return array_search_sorted_ge_tail(val, arr, i, len);
+}
+
+}
+
+/*
+ * NEON is always there on aarch64, so there's nothing to dispatch.
+ */
+unsigned array_search_sorted_ge_impl(uint8_t val, const uint8_t* arr, unsigned len) {
+    return internal::array_search_sorted_ge_neon(val, arr, len);
+}
+
+#else
+
+arch_target("default") unsigned array_search_sorted_ge_impl(uint8_t val, const uint8_t* arr, unsigned len) {
+    return internal::array_search_sorted_ge_scalar(val, arr, len);
+}
+
+#endif
+
 #ifdef __x86_64__
 
 /*
@@ -136,6 +190,57 @@ arch_target("avx2") unsigned array_search_x32_eq_impl(uint8_t val, const uint8_t
     return len;
 }
 
+/*
+ * There's no unsigned byte comparison before AVX-512, but
+ * max(a, val) == a tells a >= val.
+ */
+namespace internal {
+
+arch_target("sse4.2") unsigned array_search_sorted_ge_sse42(uint8_t val, const uint8_t* arr, unsigned len) {
+    auto k = _mm_set1_epi8(val);
+    unsigned i = 0;
+    for (; i + 16 <= len; i += 16) {
+        auto b = _mm_lddqu_si128((__m128i*)(arr + i));
+        unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(b, k), b));
+        if (m != 0) {
+            return i + __builtin_ctz(m);
+        }
+    }
+    return array_search_sorted_ge_tail(val, arr, i, len);
+}
+
+arch_target("avx2") unsigned array_search_sorted_ge_avx2(uint8_t val, const uint8_t* arr, unsigned len) {
+    auto k = _mm256_set1_epi8(val);
+    unsigned i = 0;
+    for (; i + 32 <= len; i += 32) {
+        auto b = _mm256_lddqu_si256((__m256i*)(arr + i));
+        unsigned m = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(b, k), b));
+        if (m != 0) {
+            return i + __builtin_ctz(m);
+        }
+    }
+    if (i + 16 <= len) {
+        auto k16 = _mm_set1_epi8(val);
+        auto b = _mm_lddqu_si128((__m128i*)(arr + i));
+        unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(b, k16), b));
+        if (m != 0) {
+            return i + __builtin_ctz(m);
+        }
+        i += 16;
+    }
+    return array_search_sorted_ge_tail(val, arr, i, len);
+}
+
+}
+
+arch_target("sse4.2") unsigned array_search_sorted_ge_impl(uint8_t val, const uint8_t* arr, unsigned len) {
+    return internal::array_search_sorted_ge_sse42(val, arr, len);
+}
+
+arch_target("avx2") unsigned array_search_sorted_ge_impl(uint8_t val, const uint8_t* arr, unsigned len) {
+    return internal::array_search_sorted_ge_avx2(val, arr, len);
+}
+
 #endif
 
 int array_search_gt(int64_t val, const int64_t* array, const int capacity, const int size) {
@@ -154,4 +259,8 @@ unsigned array_search_x32_eq(uint8_t val, const uint8_t* array, int nr) {
     return array_search_x32_eq_impl(val, array, nr);
 }
 
+unsigned array_search_sorted_ge(uint8_t val, const uint8_t* array, unsigned len) {
+    return array_search_sorted_ge_impl(val, array, len);
+}
+
 }
@@ -57,4 +57,28 @@ unsigned array_search_16_eq(uint8_t val, const uint8_t* array);
 unsigned array_search_32_eq(uint8_t val, const uint8_t* array);
 unsigned array_search_x32_eq(uint8_t val, const uint8_t* array, int nr);
 
+/*
+ * array_search_sorted_ge(value, array, len)
+ *
+ * Returns the index of the first element in the sorted array that's
+ * greater than or equal to the given value, or len if there's none,
+ * like std::lower_bound(). Only the first len bytes of the array are read.
+ */
+unsigned array_search_sorted_ge(uint8_t val, const uint8_t* array, unsigned len);
+
+// The variants array_search_sorted_ge() dispatches to, exposed for testing.
+// The caller must check that the CPU supports the variant's instructions.
+namespace internal {
+
+unsigned array_search_sorted_ge_scalar(uint8_t val, const uint8_t* array, unsigned len);
+#ifdef __x86_64__
+unsigned array_search_sorted_ge_sse42(uint8_t val, const uint8_t* array, unsigned len);
+unsigned array_search_sorted_ge_avx2(uint8_t val, const uint8_t* array, unsigned len);
+#endif
+#ifdef __aarch64__
+unsigned array_search_sorted_ge_neon(uint8_t val, const uint8_t* array, unsigned len);
+#endif
+
+}
+
 }
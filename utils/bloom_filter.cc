@@ -15,9 +15,21 @@
 #include <seastar/core/loop.hh>
 #include "utils/large_bitset.hh"
 #include <array>
+#include <cmath>
 #include <cstdlib>
 #include "utils/bloom_calculations.hh"
 #include "bloom_filter.hh"
+#include "xor_filter.hh"
+
+#ifdef __x86_64__
+#include <x86intrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define arch_target(name)
+#else
+#define arch_target(name)
+#endif
 
 namespace utils {
 namespace filter {
@@ -61,6 +73,13 @@ bool bloom_filter::is_present(hashed_key key) {
     return result;
 }
 
+void bloom_filter::prefetch(hashed_key key) {
+    for_each_index(key, _hash_count, _bitset.size(), _format, [this] (auto i) {
+        __builtin_prefetch(_bitset.word_ptr(i / 64));
+        return stop_iteration::no;
+    });
+}
+
 void bloom_filter::add(const bytes_view& key) {
     add(make_hashed_key(key));
 }
@@ -76,6 +95,170 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// Odd multipliers used to derive one bit index per block word from the
+// 32-bit key. These are the salts of the Parquet split block Bloom filter.
+static constexpr std::array<uint32_t, split_block_bloom_filter::words_per_block> split_block_salts = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+static_assert(large_bitset::words_per_chunk() % split_block_bloom_filter::words_per_block == 0,
+        "split block must not cross a large_bitset chunk boundary");
+
+#ifdef __aarch64__
+
+static uint64x2_t split_block_mask(uint32x4_t h, bool high) {
+    auto idx = high ? vmovl_high_u32(h) : vmovl_u32(vget_low_u32(h));
+    return vshlq_u64(vdupq_n_u64(1), vreinterpretq_s64_u64(idx));
+}
+
+bool split_block_test_impl(const uint64_t* block, uint32_t key) {
+    auto k = vdupq_n_u32(key);
+    auto h0 = vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salts.data())), 26);
+    auto h1 = vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salts.data() + 4)), 26);
+    auto missing = vorrq_u64(
+            vorrq_u64(vbicq_u64(split_block_mask(h0, false), vld1q_u64(block)),
+                      vbicq_u64(split_block_mask(h0, true), vld1q_u64(block + 2))),
+            vorrq_u64(vbicq_u64(split_block_mask(h1, false), vld1q_u64(block + 4)),
+                      vbicq_u64(split_block_mask(h1, true), vld1q_u64(block + 6))));
+    return (vgetq_lane_u64(missing, 0) | vgetq_lane_u64(missing, 1)) == 0;
+}
+
+void split_block_insert_impl(uint64_t* block, uint32_t key) {
+    auto k = vdupq_n_u32(key);
+    auto h0 = vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salts.data())), 26);
+    auto h1 = vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salts.data() + 4)), 26);
+    vst1q_u64(block, vorrq_u64(vld1q_u64(block), split_block_mask(h0, false)));
+    vst1q_u64(block + 2, vorrq_u64(vld1q_u64(block + 2), split_block_mask(h0, true)));
+    vst1q_u64(block + 4, vorrq_u64(vld1q_u64(block + 4), split_block_mask(h1, false)));
+    vst1q_u64(block + 6, vorrq_u64(vld1q_u64(block + 6), split_block_mask(h1, true)));
+}
+
+#else
+
+arch_target("default") bool split_block_test_impl(const uint64_t* block, uint32_t key) {
+    for (size_t i = 0; i < split_block_bloom_filter::words_per_block; ++i) {
+        if (!(block[i] & (uint64_t(1) << ((key * split_block_salts[i]) >> 26)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+arch_target("default") void split_block_insert_impl(uint64_t* block, uint32_t key) {
+    for (size_t i = 0; i < split_block_bloom_filter::words_per_block; ++i) {
+        block[i] |= uint64_t(1) << ((key * split_block_salts[i]) >> 26);
+    }
+}
+
+#ifdef __x86_64__
+
+// The 64-bit masks for the eight block words: the low and high four words,
+// respectively.
+struct split_block_masks {
+    __m256i lo;
+    __m256i hi;
+};
+
+arch_target("avx2") static inline split_block_masks split_block_masks_avx2(uint32_t key) {
+    auto salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(split_block_salts.data()));
+    auto h = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salts), 26);
+    auto one = _mm256_set1_epi64x(1);
+    return {
+        _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(h))),
+        _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(h, 1))),
+    };
+}
+
+arch_target("avx2") bool split_block_test_impl(const uint64_t* block, uint32_t key) {
+    auto [lo, hi] = split_block_masks_avx2(key);
+    // testc(a, b) is set iff all bits of b are also set in a.
+    return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), lo)
+         & _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 4)), hi);
+}
+
+arch_target("avx2") void split_block_insert_impl(uint64_t* block, uint32_t key) {
+    auto [lo, hi] = split_block_masks_avx2(key);
+    auto p0 = reinterpret_cast<__m256i*>(block);
+    auto p1 = reinterpret_cast<__m256i*>(block + 4);
+    _mm256_storeu_si256(p0, _mm256_or_si256(_mm256_loadu_si256(p0), lo));
+    _mm256_storeu_si256(p1, _mm256_or_si256(_mm256_loadu_si256(p1), hi));
+}
+
+#endif
+
+#endif
+
+split_block_bloom_filter::split_block_bloom_filter(bitmap&& bs) noexcept
+    : bloom_filter(hash_count, std::move(bs), filter_format::split_block_format)
+    , _nr_blocks(bits().size() / bits_per_block)
+{
+}
+
+uint64_t* split_block_bloom_filter::block_for(const hashed_key& key) {
+    // Map the first half of the hash onto [0, _nr_blocks) with a multiply-shift
+    // rather than a modulo.
+    auto block = static_cast<size_t>((static_cast<unsigned __int128>(key.hash()[0]) * _nr_blocks) >> 64);
+    return bits().word_ptr(block * words_per_block);
+}
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    if (!_nr_blocks) [[unlikely]] {
+        return true;
+    }
+    return split_block_test_impl(block_for(key), static_cast<uint32_t>(key.hash()[1]));
+}
+
+void split_block_bloom_filter::prefetch(hashed_key key) {
+    if (_nr_blocks) [[likely]] {
+        __builtin_prefetch(block_for(key));
+    }
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+void split_block_bloom_filter::add(const hashed_key& key) {
+    if (!_nr_blocks) [[unlikely]] {
+        return;
+    }
+    split_block_insert_impl(block_for(key), static_cast<uint32_t>(key.hash()[1]));
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    add(make_hashed_key(key));
+}
+
+double split_block_bloom_filter::false_positive_probability(double bits_per_element) {
+    // The number of keys hashed into a block is approximately Poisson
+    // distributed. A block holding c keys yields a false positive when all
+    // eight probed bits are set, and each word has c single-bit insertions.
+    const double lambda = bits_per_block / bits_per_element;
+    const auto max_keys = static_cast<size_t>(lambda + 12 * std::sqrt(lambda) + 32);
+    double p_keys = std::exp(-lambda);
+    double fpp = 0;
+    for (size_t c = 0; c <= max_keys; ++c) {
+        const double word_fill = 1 - std::pow(1 - 1.0 / 64, c);
+        fpp += p_keys * std::pow(word_fill, words_per_block);
+        p_keys *= lambda / (c + 1);
+    }
+    return fpp;
+}
+
+size_t split_block_bloom_filter::get_bitset_size(int64_t num_elements, double max_false_pos_prob) {
+    // Blocking costs some accuracy compared to a classic Bloom filter, so
+    // pick the smallest number of bits per element which satisfies the
+    // requested probability, rather than reusing bloom_calculations.
+    constexpr int max_bits_per_element = 64;
+    int bits_per_element = 1;
+    while (bits_per_element < max_bits_per_element && false_positive_probability(bits_per_element) > max_false_pos_prob) {
+        ++bits_per_element;
+    }
+    auto nr_blocks = std::max<int64_t>(1, (std::max<int64_t>(num_elements, 0) * bits_per_element + bits_per_block - 1) / bits_per_block);
+    return nr_blocks * bits_per_block;
+}
+
 size_t get_bitset_size(int64_t num_elements, int buckets_per) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
@@ -83,6 +266,12 @@ size_t get_bitset_size(int64_t num_elements, int buckets_per) {
 }
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
+    if (format == filter_format::xor_format) {
+        return std::make_unique<xor_filter>(std::move(bitset));
+    }
+    if (format == filter_format::split_block_format) {
+        return std::make_unique<split_block_bloom_filter>(std::move(bitset));
+    }
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
 
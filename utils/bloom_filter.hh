@@ -45,6 +45,8 @@ class bloom_filter: public i_filter {
 
     virtual bool is_present(hashed_key key) override;
 
+    virtual void prefetch(hashed_key key) override;
+
     virtual void clear() override {
         _bitset.clear();
     }
@@ -67,6 +69,49 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A cache-line-blocked ("split block") Bloom filter.
+//
+// The bitset is divided into 64-byte blocks of eight 64-bit words. The first
+// half of the hashed key selects a block, and the second half is mixed with
+// eight per-word salts to set exactly one bit in each word of the block. All
+// probes of a key hence land in a single cache line, so a negative lookup
+// costs (at most) one cache miss, and the eight words are tested at once with
+// SIMD where available.
+//
+// The storage is a regular large_bitset, so the on-disk layout of Filter.db is
+// the same as that of the murmur3 filter; the two formats are distinguished by
+// the SplitBlockBloomFilter sstable feature.
+class split_block_bloom_filter : public bloom_filter {
+public:
+    static constexpr size_t words_per_block = 8;
+    static constexpr size_t bits_per_block = words_per_block * 64;
+    // Number of bits set (and tested) per key, one per word of the block.
+    static constexpr int hash_count = words_per_block;
+
+private:
+    size_t _nr_blocks;
+
+    uint64_t* block_for(const hashed_key& key);
+public:
+    split_block_bloom_filter(bitmap&& bs) noexcept;
+
+    virtual void add(const bytes_view& key) override;
+    virtual void add(const hashed_key& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void prefetch(hashed_key key) override;
+
+    // Returns the size of the bitset (in bits) needed to satisfy the given false
+    // positive probability for the given number of elements.
+    static size_t get_bitset_size(int64_t num_elements, double max_false_pos_prob);
+
+    // Returns the expected false positive probability of a split block filter
+    // with the given number of bits per element.
+    static double false_positive_probability(double bits_per_element);
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -19,6 +19,7 @@
 #include "utils/cached_file_stats.hh"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
 using namespace seastar;
@@ -55,13 +56,16 @@ class cached_file {
         logalloc::lsa_buffer _lsa_buf;
         temporary_buffer<char> _buf; // Empty when not shared. May mirror _lsa_buf when shared.
         size_t _use_count = 0;
+        bool _pinned = false; // Kept out of the LRU, see cached_file::pin().
     public:
         struct cached_page_del {
             void operator()(cached_page* cp) {
                 if (--cp->_use_count == 0) {
                     cp->parent->_metrics.bytes_in_std -= cp->_buf.size();
                     cp->_buf = {};
-                    cp->parent->_lru.add(*cp);
+                    if (!cp->_pinned) {
+                        cp->parent->_lru.add(*cp);
+                    }
                 }
             }
         };
@@ -139,6 +143,10 @@ class cached_file {
             // _buf is transient and not accounted here.
             return page_size;
         }
+
+        float eviction_cost() const noexcept override {
+            return float(parent->_refetch_cost) / page_size;
+        }
     };
 
     struct page_idx_less_comparator {
@@ -150,6 +158,9 @@ class cached_file {
     file _file;
     sstring _file_name; // for logging / tracing
     cached_file_stats& _metrics;
+    // Optional statistics of the owner of the file, e.g. of a table,
+    // updated along with _metrics.
+    lw_shared_ptr<cached_file_stats> _owner_metrics;
     lru& _lru;
     logalloc::region& _region;
     logalloc::allocating_section _as;
@@ -162,6 +173,11 @@ class cached_file {
 
     offset_type _last_page_size;
     page_idx_type _last_page;
+    // Relative cost of reading a page back from the file.
+    unsigned _refetch_cost = 1;
+    size_t _pinned_bytes = 0;
+    // Number of pages read at once by pin() and populate().
+    static constexpr page_count_type pin_read_ahead = 32;
 public:
     using ptr_type = cached_page::ptr_type;
     struct page_read_result {
@@ -185,13 +201,13 @@ class cached_file {
             std::optional<reader_permit> permit = {}) {
         auto i = _cache.lower_bound(idx);
         if (i != _cache.end() && i->idx == idx) {
-            ++_metrics.page_hits;
+            update_metrics([] (cached_file_stats& m) { ++m.page_hits; });
             tracing::trace(trace_state, "page cache hit: file={}, page={}", _file_name, idx);
             cached_page& cp = *i;
             return make_ready_future<page_read_result>(cp.share(), true);
         }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
-        ++_metrics.page_misses;
+        update_metrics([] (cached_file_stats& m) { ++m.page_misses; });
         size_t size = (idx + read_ahead) > _last_page
                 ? (_last_page_size + (_last_page - idx) * page_size)
                 : read_ahead * page_size;
@@ -218,8 +234,10 @@ class cached_file {
                     buf.trim_front(this_size);
                     ++idx;
                     if (missed) {
-                        ++_metrics.page_populations;
-                        _metrics.cached_bytes += cp->size_in_allocator();
+                        update_metrics([&] (cached_file_stats& m) {
+                            ++m.page_populations;
+                            m.cached_bytes += cp->size_in_allocator();
+                        });
                         _cached_bytes += cp->size_in_allocator();
                     }
                     // pages read ahead will be placed into LRU, as there's no guarantee they will be fetched later.
@@ -424,10 +442,20 @@ class cached_file {
         }
     };
 
+    template <typename Func>
+    void update_metrics(Func&& f) noexcept {
+        f(_metrics);
+        if (_owner_metrics) {
+            f(*_owner_metrics);
+        }
+    }
+
     void on_evicted(cached_page& p) {
-        _metrics.cached_bytes -= p.size_in_allocator();
+        update_metrics([&] (cached_file_stats& m) {
+            m.cached_bytes -= p.size_in_allocator();
+            ++m.page_evictions;
+        });
         _cached_bytes -= p.size_in_allocator();
-        ++_metrics.page_evictions;
     }
 
     size_t evict_range(cache_type::iterator start, cache_type::iterator end) noexcept {
@@ -472,7 +500,23 @@ class cached_file {
     cached_file(cached_file&&) = delete; // captured this
     cached_file(const cached_file&) = delete;
 
+    /// \brief Sets the cost of reading pages of the file relative to local storage.
+    ///
+    /// Pages with a higher cost are kept longer when index pages are evicted, see lru::evict().
+    void set_refetch_cost(unsigned cost) noexcept {
+        _refetch_cost = cost;
+    }
+
+    /// \brief Sets statistics of the owner of the file, e.g. of a table, to update along with the ones
+    /// passed to the constructor.
+    ///
+    /// Must be called before anything is read from the file.
+    void set_owner_metrics(lw_shared_ptr<cached_file_stats> m) noexcept {
+        _owner_metrics = std::move(m);
+    }
+
     ~cached_file() {
+        unpin();
         evict_range(_cache.begin(), _cache.end());
         SCYLLA_ASSERT(_cache.empty());
     }
@@ -540,6 +584,96 @@ class cached_file {
         return _cached_bytes;
     }
 
+    /// \brief Reads the whole area into the cache and keeps it there.
+    ///
+    /// Pinned pages are not linked in the LRU, so they are not evicted
+    /// nor invalidated until unpin() is called.
+    ///
+    /// Returns the number of bytes pinned.
+    future<size_t> pin() {
+        for (page_idx_type idx = 0; _size && idx <= _last_page; ++idx) {
+            auto read_ahead = std::min<page_count_type>(pin_read_ahead, _last_page - idx + 1);
+            auto read_result = co_await get_page_ptr(idx, read_ahead, {});
+            // The page is shared by read_result.ptr, so it is not linked.
+            cached_page& cp = *read_result.ptr;
+            if (!cp._pinned) {
+                cp._pinned = true;
+                _pinned_bytes += cp.size_in_allocator();
+                update_metrics([&] (cached_file_stats& m) { m.pinned_bytes += cp.size_in_allocator(); });
+            }
+        }
+        co_return _pinned_bytes;
+    }
+
+    /// \brief Reads pages overlapping [start, end) into the cache, unless already cached.
+    ///
+    /// The pages end up in the LRU, like pages read ahead by streams.
+    ///
+    /// Returns the number of bytes added to the cache.
+    future<size_t> populate(offset_type start, offset_type end) {
+        end = std::min(end, _size);
+        if (start >= end) {
+            co_return 0;
+        }
+        auto cached_before = _cached_bytes;
+        page_idx_type last = (end - 1) / page_size;
+        for (page_idx_type idx = start / page_size; idx <= last; ++idx) {
+            auto i = _cache.lower_bound(idx);
+            if (i != _cache.end() && i->idx == idx) {
+                continue;
+            }
+            auto read_ahead = std::min<page_count_type>(pin_read_ahead, last - idx + 1);
+            co_await get_page_ptr(idx, read_ahead, {});
+        }
+        co_return _cached_bytes - cached_before;
+    }
+
+    /// \brief Calls func(first, last) for each run of consecutive cached pages
+    /// [first, last], in ascending order.
+    ///
+    /// Pages are not evicted while func runs, but func must not read from this file.
+    template <typename Func>
+    requires std::invocable<Func, page_idx_type, page_idx_type>
+    void for_each_cached_page_run(Func&& func) const {
+        logalloc::reclaim_lock rl(_region);
+        std::optional<std::pair<page_idx_type, page_idx_type>> run;
+        for (const cached_page& cp : _cache) {
+            if (run && cp.idx == run->second + 1) {
+                run->second = cp.idx;
+                continue;
+            }
+            if (run) {
+                func(run->first, run->second);
+            }
+            run.emplace(cp.idx, cp.idx);
+        }
+        if (run) {
+            func(run->first, run->second);
+        }
+    }
+
+    /// \brief Makes pages pinned by pin() evictable again.
+    void unpin() noexcept {
+        if (!_pinned_bytes) {
+            return;
+        }
+        for (cached_page& cp : _cache) {
+            if (cp._pinned) {
+                cp._pinned = false;
+                if (!cp._use_count) {
+                    _lru.add(cp);
+                }
+            }
+        }
+        update_metrics([this] (cached_file_stats& m) { m.pinned_bytes -= _pinned_bytes; });
+        _pinned_bytes = 0;
+    }
+
+    /// \brief Returns the number of bytes pinned by pin().
+    size_t pinned_bytes() const {
+        return _pinned_bytes;
+    }
+
     /// \brief Returns the underlying file.
     file& get_file() {
         return _file;
@@ -16,5 +16,6 @@ struct cached_file_stats {
     uint64_t page_evictions = 0;
     uint64_t page_populations = 0;
     uint64_t cached_bytes = 0;
+    uint64_t pinned_bytes = 0; // part of cached_bytes kept out of the LRU by cached_file::pin()
     uint64_t bytes_in_std = 0; // memory used by active temporary_buffer:s
 };
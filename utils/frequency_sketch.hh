@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace utils {
+
+// Approximate access frequencies of keys, as used by the TinyLFU cache
+// admission policy (Einziger, Friedman, Manes, "TinyLFU: A Highly Efficient
+// Cache Admission Policy").
+//
+// A count-min sketch of 4-bit counters. Each key is counted in one counter of
+// each of 4 rows, and its frequency is estimated as the minimum of these.
+// To make the sketch follow changes in the workload, all counters are halved
+// once sample_size() increments were made since the previous halving.
+class frequency_sketch {
+public:
+    static constexpr unsigned max_frequency = 15;
+private:
+    static constexpr unsigned depth = 4;
+    static constexpr unsigned counters_per_word = 16;
+
+    std::unique_ptr<uint64_t[]> _table;
+    size_t _words;
+    size_t _sample_size;
+    size_t _additions = 0;
+
+    static constexpr std::array<uint64_t, depth> seeds = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+    };
+
+    // Position of the i-th counter of key, as (word, shift).
+    std::pair<size_t, unsigned> counter(uint64_t key, unsigned i) const noexcept {
+        uint64_t h = (key + seeds[i]) * seeds[(i + 1) % depth];
+        h ^= h >> 32;
+        // Each row owns a quarter of every word, so that the counters of a
+        // key spread over several words but not over the whole table.
+        auto word = (h >> 4) & (_words - 1);
+        auto idx = (h & 3) | (i << 2);
+        return {word, unsigned(idx) * 4};
+    }
+
+    void halve() noexcept {
+        for (size_t i = 0; i < _words; ++i) {
+            _table[i] = (_table[i] >> 1) & 0x7777777777777777ULL;
+        }
+        _additions /= 2;
+    }
+public:
+    // The sketch is sized to track about expected_keys distinct keys.
+    explicit frequency_sketch(size_t expected_keys)
+        : _words(std::bit_ceil(std::max<size_t>(expected_keys / 4, 64)))
+        , _sample_size(10 * std::max<size_t>(expected_keys, 256))
+    {
+        _table = std::make_unique<uint64_t[]>(_words);
+    }
+
+    // Counts an access to key.
+    void increment(uint64_t key) noexcept {
+        for (unsigned i = 0; i < depth; ++i) {
+            auto [word, shift] = counter(key, i);
+            if (((_table[word] >> shift) & 0xf) != max_frequency) {
+                _table[word] += uint64_t(1) << shift;
+            }
+        }
+        if (++_additions == _sample_size) {
+            halve();
+        }
+    }
+
+    // Estimated number of accesses to key, at most max_frequency.
+    unsigned frequency(uint64_t key) const noexcept {
+        unsigned res = max_frequency;
+        for (unsigned i = 0; i < depth; ++i) {
+            auto [word, shift] = counter(key, i);
+            res = std::min(res, unsigned((_table[word] >> shift) & 0xf));
+        }
+        return res;
+    }
+
+    size_t sample_size() const noexcept {
+        return _sample_size;
+    }
+
+    size_t memory_usage() const noexcept {
+        return _words * sizeof(uint64_t);
+    }
+};
+
+} // namespace utils
@@ -20,6 +20,11 @@ using filter_ptr = std::unique_ptr<i_filter>;
 enum class filter_format {
     k_l_format,
     m_format,
+    // Cache-line-blocked Bloom filter, see filter::split_block_bloom_filter.
+    split_block_format,
+    // Static binary fuse filter, see filter::xor_filter. It cannot be built
+    // incrementally, so get_filter() does not support it.
+    xor_format,
 };
 
 class hashed_key {
@@ -41,6 +46,10 @@ struct i_filter {
     virtual void add(const hashed_key& key) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
+    // Issues prefetches for the memory is_present() will touch for the given
+    // key, so that checking the key against many filters can overlap the
+    // cache misses. A hint only; the default does nothing.
+    virtual void prefetch(hashed_key) {}
     virtual void clear() = 0;
     virtual void close() = 0;
 
@@ -58,6 +67,6 @@ struct i_filter {
     /**
      * @return the size of the smallest filter (in bytes), according to the conditions described at get_filter()
      */
-    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob);
+    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob, filter_format format);
 };
 }
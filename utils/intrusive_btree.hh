@@ -827,6 +827,14 @@ class tree {
                 return nullptr;
             }
         }
+
+        /*
+         * Returns pointer on the owning tree if this is the end() iterator
+         * reached by advancing an iterator past the last element.
+         */
+        tree_ptr tree_if_end() const noexcept {
+            return is_end() ? _tree : nullptr;
+        }
     };
 
     using iterator_base_const = iterator_base<true, const_iterator>;
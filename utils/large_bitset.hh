@@ -55,6 +55,18 @@ class large_bitset {
     }
     void clear();
 
+    // Direct access to the idx-th word of the bitset. Words of an aligned
+    // group whose size divides the storage chunk capacity are contiguous.
+    int_type* word_ptr(size_t idx) {
+        return &_storage[idx];
+    }
+    const int_type* word_ptr(size_t idx) const {
+        return &_storage[idx];
+    }
+    static constexpr size_t words_per_chunk() {
+        return utils::chunked_vector<int_type>::max_chunk_capacity();
+    }
+
     const utils::chunked_vector<int_type>& get_storage() const {
         return _storage;
     }
@@ -11,6 +11,7 @@
 #include "utils/assert.hh"
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/memory.hh>
+#include <seastar/core/loop.hh>
 
 class evictable {
     friend class lru;
@@ -74,15 +75,28 @@ class index_evictable : public evictable {
     bool is_index() const noexcept override {
         return true;
     }
+public:
+    // Relative cost of loading the entry back after it is evicted, per byte
+    // of memory its eviction frees. See lru::evict().
+    virtual float eviction_cost() const noexcept {
+        return 0;
+    }
 };
 
 // Implements LRU cache replacement for row cache and sstable index cache.
+//
+// Elements can also be added on probation (see add_probation()), to a separate
+// list which is evicted from before the main one. Touching an element moves it
+// to the main list. This keeps the elements seen once, e.g. by a scan, from
+// evicting the ones which are used repeatedly (segmented LRU).
 class lru {
 private:
     using lru_type = boost::intrusive::list<evictable,
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
     lru_type _list;
+    // Shares the hook with _list, an element is linked in one of them.
+    lru_type _probation_list;
 
     // See the comment to index_evictable.
     using index_lru_type = boost::intrusive::list<index_evictable,
@@ -92,17 +106,38 @@ class lru {
 
     using reclaiming_result = seastar::memory::reclaiming_result;
 
+    // When index entries are evicted to keep the index cache within its limits,
+    // the one which is the cheapest to load back per byte among this many least
+    // recently used ones is picked. Looking only at the cold end keeps the order
+    // close to LRU, while pages of slow storage and pages which are expensive to
+    // parse stay longer.
+    static constexpr unsigned index_eviction_candidates = 4;
+
+    index_evictable& index_victim() noexcept {
+        auto victim = _index_list.begin();
+        auto i = std::next(victim);
+        for (unsigned n = 1; n < index_eviction_candidates && i != _index_list.end(); ++n, ++i) {
+            if (i->eviction_cost() < victim->eviction_cost()) {
+                victim = i;
+            }
+        }
+        return *victim;
+    }
+
 public:
     ~lru() {
-        while (!_list.empty()) {
-            evictable& e = _list.front();
-            remove(e);
-            e.on_evicted();
+        for (auto* list : {&_probation_list, &_list}) {
+            while (!list->empty()) {
+                evictable& e = list->front();
+                remove(e);
+                e.on_evicted();
+            }
         }
     }
 
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        // Unlinks from either _list or _probation_list.
+        e._lru_link.unlink();
         if (e.is_index()) {
             _index_list.erase(_index_list.iterator_to(static_cast<index_evictable&>(e)));
         }
@@ -115,9 +150,25 @@ class lru {
         }
     }
 
+    // Like add(e), but e is evicted before all elements which are not on probation.
+    // Index entries are never put on probation.
+    void add_probation(evictable& e) noexcept {
+        if (e.is_index()) {
+            add(e);
+            return;
+        }
+        _probation_list.push_back(e);
+    }
+
     // Like add(e) but makes sure that e is evicted right before "more_recent" in the absence of later touches.
+    // e ends up in the same list as more_recent.
+    //
+    // more_recent may be linked in either _list or _probation_list, and the
+    // hook doesn't tell which one, so e is linked next to it at the node
+    // level rather than through the member functions of either list.
     void add_before(evictable& more_recent, evictable& e) noexcept {
-        _list.insert(_list.iterator_to(more_recent), e);
+        SCYLLA_ASSERT(more_recent.is_linked() && !e.is_linked() && !e.is_index());
+        lru_type::node_algorithms::link_before(lru_type::value_traits::to_node_ptr(more_recent), lru_type::value_traits::to_node_ptr(e));
     }
 
     void touch(evictable& e) noexcept {
@@ -125,13 +176,29 @@ class lru {
         add(e);
     }
 
+    // Calls f on the elements in the order in which evict() would pick them,
+    // not counting the index cache limit, until f returns stop_iteration::yes.
+    // f may unlink elements only when it returns stop_iteration::yes.
+    template <typename Func>
+    void for_each_in_eviction_order(Func&& f) {
+        for (auto* list : {&_probation_list, &_list}) {
+            for (evictable& e : *list) {
+                if (f(e) == seastar::stop_iteration::yes) {
+                    return;
+                }
+            }
+        }
+    }
+
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict(bool should_evict_index) noexcept {
-        if (_list.empty()) {
+        if (_list.empty() && _probation_list.empty()) {
             return reclaiming_result::reclaimed_nothing;
         }
-        evictable& e = (should_evict_index && !_index_list.empty()) ? _index_list.front() : _list.front();
+        evictable& e = (should_evict_index && !_index_list.empty()) ? index_victim()
+                : !_probation_list.empty() ? _probation_list.front()
+                : _list.front();
         remove(e);
         if constexpr (!Shallow) {
             e.on_evicted();
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "xor_filter.hh"
+#include "utils/assert.hh"
+#include <seastar/core/align.hh>
+#include <seastar/core/thread.hh>
+#include <fmt/format.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace utils {
+namespace filter {
+
+thread_local xor_filter::stats xor_filter::_shard_stats;
+
+// The murmur3 64-bit finalizer.
+static uint64_t mix(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t splitmix64(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint32_t mod3(uint32_t x) noexcept {
+    return x > 2 ? x - 3 : x;
+}
+
+struct xor_filter::layout {
+    uint32_t segment_length;
+    uint32_t segment_count_length;
+    uint32_t array_length;
+
+    // Sizing as suggested by the binary fuse filter paper for arity 3.
+    static layout for_size(uint32_t size) {
+        uint32_t segment_length = size <= 1 ? 4 : uint32_t(1) << int(std::floor(std::log(double(size)) / std::log(3.33) + 2.25));
+        segment_length = std::min<uint32_t>(segment_length, 1 << 18);
+        const double size_factor = size <= 1 ? 0 : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(double(size)));
+        const auto capacity = uint64_t(std::round(double(size) * size_factor));
+        const auto segment_count = std::max<int64_t>(1, int64_t((capacity + segment_length - 1) / segment_length) - (hash_count - 1));
+        return layout{
+            .segment_length = segment_length,
+            .segment_count_length = uint32_t(segment_count * segment_length),
+            .array_length = uint32_t((segment_count + hash_count - 1) * segment_length),
+        };
+    }
+
+    static layout for_segments(uint32_t segment_length, uint32_t segment_count_length) {
+        return layout{
+            .segment_length = segment_length,
+            .segment_count_length = segment_count_length,
+            .array_length = segment_count_length + (hash_count - 1) * segment_length,
+        };
+    }
+};
+
+static size_t storage_bits(uint32_t array_length, unsigned fingerprint_bits, size_t header_words) {
+    return header_words * 64 + align_up<size_t>(size_t(array_length) * fingerprint_bits, 64);
+}
+
+xor_filter::xor_filter(large_bitset&& bs, const layout& l, uint64_t seed)
+    : _bitset(std::move(bs))
+    , _seed(seed)
+    , _segment_length(l.segment_length)
+    , _segment_length_mask(l.segment_length - 1)
+    , _segment_count_length(l.segment_count_length)
+{
+    _stats.memory_size += memory_size();
+}
+
+xor_filter::xor_filter(large_bitset&& bs)
+    : _bitset(std::move(bs))
+{
+    if (_bitset.size() >= header_words * 64) {
+        _seed = *_bitset.word_ptr(0);
+        const auto w1 = *_bitset.word_ptr(1);
+        _segment_length = uint32_t(w1);
+        _segment_length_mask = _segment_length - 1;
+        _fingerprint_bits = unsigned(w1 >> 32);
+        _fingerprint_mask = _fingerprint_bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << _fingerprint_bits) - 1;
+        _segment_count_length = uint32_t(*_bitset.word_ptr(2));
+    }
+    if (_segment_count_length) {
+        const auto l = layout::for_segments(_segment_length, _segment_count_length);
+        if (!std::has_single_bit(_segment_length) || !_fingerprint_bits || _fingerprint_bits > 32
+                || _segment_count_length % _segment_length
+                || storage_bits(l.array_length, _fingerprint_bits, header_words) > _bitset.size()) {
+            throw std::runtime_error(fmt::format("Invalid xor filter: segment_length={} segment_count_length={} fingerprint_bits={} size={}",
+                    _segment_length, _segment_count_length, _fingerprint_bits, _bitset.size()));
+        }
+    }
+    _stats.memory_size += memory_size();
+}
+
+xor_filter::~xor_filter() {
+    _stats.memory_size -= memory_size();
+}
+
+uint64_t xor_filter::key_of(const hashed_key& key) noexcept {
+    auto h = key.hash();
+    return h[0] ^ std::rotl(h[1], 32);
+}
+
+std::array<uint32_t, xor_filter::hash_count> xor_filter::positions(uint64_t h) const noexcept {
+    auto h0 = uint32_t((static_cast<unsigned __int128>(h) * _segment_count_length) >> 64);
+    auto h1 = h0 + _segment_length;
+    auto h2 = h1 + _segment_length;
+    h1 ^= uint32_t(h >> 18) & _segment_length_mask;
+    h2 ^= uint32_t(h) & _segment_length_mask;
+    return {h0, h1, h2};
+}
+
+uint64_t xor_filter::get_fingerprint(uint32_t idx) const noexcept {
+    const size_t bit = size_t(idx) * _fingerprint_bits;
+    const size_t word = header_words + bit / 64;
+    const unsigned shift = bit % 64;
+    uint64_t v = *_bitset.word_ptr(word) >> shift;
+    if (shift + _fingerprint_bits > 64) {
+        v |= *_bitset.word_ptr(word + 1) << (64 - shift);
+    }
+    return v & _fingerprint_mask;
+}
+
+void xor_filter::set_fingerprint(uint32_t idx, uint64_t fp) noexcept {
+    const size_t bit = size_t(idx) * _fingerprint_bits;
+    const size_t word = header_words + bit / 64;
+    const unsigned shift = bit % 64;
+    auto* w = _bitset.word_ptr(word);
+    *w = (*w & ~(_fingerprint_mask << shift)) | (fp << shift);
+    if (shift + _fingerprint_bits > 64) {
+        auto* next = _bitset.word_ptr(word + 1);
+        *next = (*next & ~(_fingerprint_mask >> (64 - shift))) | (fp >> (64 - shift));
+    }
+}
+
+void xor_filter::write_header() noexcept {
+    *_bitset.word_ptr(0) = _seed;
+    *_bitset.word_ptr(1) = uint64_t(_segment_length) | (uint64_t(_fingerprint_bits) << 32);
+    *_bitset.word_ptr(2) = _segment_count_length;
+}
+
+static unsigned fingerprint_bits_for(double max_false_pos_prob) {
+    return unsigned(std::clamp<int>(std::ceil(std::log2(1 / max_false_pos_prob)), 1, 32));
+}
+
+size_t xor_filter::get_bitset_size(int64_t num_elements, double max_false_pos_prob) {
+    if (num_elements <= 0) {
+        return 0;
+    }
+    num_elements = std::min<int64_t>(num_elements, std::numeric_limits<uint32_t>::max() / 2);
+    return storage_bits(layout::for_size(num_elements).array_length, fingerprint_bits_for(max_false_pos_prob), header_words);
+}
+
+std::unique_ptr<xor_filter> xor_filter::build(const utils::chunked_vector<uint64_t>& all_keys, double max_false_pos_prob) {
+    SCYLLA_ASSERT(seastar::thread::running_in_thread());
+
+    const utils::chunked_vector<uint64_t>* keys = &all_keys;
+    utils::chunked_vector<uint64_t> unique_keys;
+    size_t size = keys->size();
+    if (!size || size > std::numeric_limits<uint32_t>::max() / 2) {
+        return nullptr;
+    }
+    const auto l = layout::for_size(size);
+    const auto fingerprint_bits = fingerprint_bits_for(max_false_pos_prob);
+
+    // Construction state. Each slot of the fingerprint array tracks how many
+    // keys map to it (in the upper 6 bits of t2count), the XOR of the roles
+    // (0, 1 or 2) those keys map to it in (lower 2 bits), and the XOR of their
+    // hashes. A slot with a single key identifies that key, which can then be
+    // peeled off.
+    utils::chunked_vector<uint8_t> t2count;
+    utils::chunked_vector<uint64_t> t2hash;
+    utils::chunked_vector<uint32_t> alone;
+    utils::chunked_vector<uint64_t> reverse_order;
+    utils::chunked_vector<uint8_t> reverse_h;
+    t2count.resize(l.array_length);
+    t2hash.resize(l.array_length);
+    alone.resize(l.array_length);
+    reverse_order.resize(size);
+    reverse_h.resize(size);
+
+    auto f = std::unique_ptr<xor_filter>(new xor_filter(large_bitset(storage_bits(l.array_length, fingerprint_bits, header_words)), l, 0));
+    f->_fingerprint_bits = fingerprint_bits;
+    f->_fingerprint_mask = (uint64_t(1) << fingerprint_bits) - 1;
+
+    // Deterministic seeds, so that the same keys always produce the same filter.
+    uint64_t seed_state = 0x726f78206c6c7973ULL;
+    constexpr int max_attempts = 100;
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        // Duplicate keys can never be peeled. They are not expected, so only
+        // look for them once the first attempt failed.
+        if (attempt == 1) {
+            unique_keys = all_keys;
+            std::ranges::sort(unique_keys);
+            unique_keys.erase(std::unique(unique_keys.begin(), unique_keys.end()), unique_keys.end());
+            keys = &unique_keys;
+            size = unique_keys.size();
+        }
+        f->_seed = splitmix64(seed_state);
+        std::ranges::fill(t2count, 0);
+        std::ranges::fill(t2hash, 0);
+
+        bool overflow = false;
+        for (size_t i = 0; i < size; ++i) {
+            const auto h = mix((*keys)[i] + f->_seed);
+            const auto hs = f->positions(h);
+            for (uint32_t j = 0; j < uint32_t(hash_count); ++j) {
+                auto& count = t2count[hs[j]];
+                count += 4;
+                count ^= j;
+                t2hash[hs[j]] ^= h;
+                // More than 63 keys in a slot wrap the counter around.
+                overflow |= count < 4;
+            }
+            seastar::thread::maybe_yield();
+        }
+        if (overflow) {
+            continue;
+        }
+
+        size_t qsize = 0;
+        for (uint32_t i = 0; i < l.array_length; ++i) {
+            alone[qsize] = i;
+            qsize += (t2count[i] >> 2) == 1;
+        }
+        size_t stack_size = 0;
+        while (qsize > 0) {
+            const auto index = alone[--qsize];
+            if ((t2count[index] >> 2) != 1) {
+                continue;
+            }
+            const auto h = t2hash[index];
+            const uint32_t found = t2count[index] & 3;
+            reverse_h[stack_size] = found;
+            reverse_order[stack_size] = h;
+            ++stack_size;
+
+            const auto hs = f->positions(h);
+            for (uint32_t role : {mod3(found + 1), mod3(found + 2)}) {
+                const auto other = hs[role];
+                alone[qsize] = other;
+                qsize += (t2count[other] >> 2) == 2;
+                t2count[other] -= 4;
+                t2count[other] ^= role;
+                t2hash[other] ^= h;
+            }
+            seastar::thread::maybe_yield();
+        }
+        if (stack_size != size) {
+            continue;
+        }
+
+        // Assign the fingerprints in the reverse peeling order, so that the
+        // slot assigned for each key is not touched by any later assignment.
+        for (size_t i = size; i-- > 0;) {
+            const auto h = reverse_order[i];
+            const uint32_t found = reverse_h[i];
+            const auto hs = f->positions(h);
+            f->set_fingerprint(hs[found], f->fingerprint(h)
+                    ^ f->get_fingerprint(hs[mod3(found + 1)])
+                    ^ f->get_fingerprint(hs[mod3(found + 2)]));
+            seastar::thread::maybe_yield();
+        }
+        f->write_header();
+        return f;
+    }
+    return nullptr;
+}
+
+void xor_filter::add(const bytes_view& key) {
+    throw std::logic_error("xor_filter is immutable");
+}
+
+void xor_filter::add(const hashed_key& key) {
+    throw std::logic_error("xor_filter is immutable");
+}
+
+bool xor_filter::is_present(hashed_key key) {
+    // Without a usable table, fail open like the other filters: a false
+    // positive costs a read, a false negative loses one.
+    if (!_segment_count_length) [[unlikely]] {
+        return true;
+    }
+    const auto h = mix(key_of(key) + _seed);
+    const auto hs = positions(h);
+    return fingerprint(h) == (get_fingerprint(hs[0]) ^ get_fingerprint(hs[1]) ^ get_fingerprint(hs[2]));
+}
+
+bool xor_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+void xor_filter::prefetch(hashed_key key) {
+    if (!_segment_count_length) [[unlikely]] {
+        return;
+    }
+    for (auto idx : positions(mix(key_of(key) + _seed))) {
+        __builtin_prefetch(_bitset.word_ptr(header_words + size_t(idx) * _fingerprint_bits / 64));
+    }
+}
+
+void xor_filter::clear() {
+    _bitset.clear();
+    _segment_count_length = 0;
+}
+
+}
+}
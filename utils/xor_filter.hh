@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "i_filter.hh"
+#include "utils/chunked_vector.hh"
+#include "utils/large_bitset.hh"
+
+namespace utils {
+namespace filter {
+
+// A static filter of the XOR family (a 3-wise binary fuse filter, see
+// Graf & Lemire, "Binary Fuse Filters: Fast and Smaller Than Xor Filters").
+//
+// Unlike the Bloom filter, it cannot be built incrementally: it is constructed
+// once from the complete set of keys, which is what we have when an sstable is
+// sealed. In exchange, it needs about 1.125 * log2(1 / fp) bits per key,
+// compared to about 1.44 * log2(1 / fp) bits per key for a Bloom filter.
+//
+// The filter is stored in a large_bitset, so it can be written to and read
+// from Filter.db like a Bloom filter. The first header_words words hold the
+// seed and the layout parameters, and are followed by the packed array of
+// fingerprints.
+class xor_filter : public i_filter {
+public:
+    // Number of fingerprints probed per key.
+    static constexpr int hash_count = 3;
+
+private:
+    static constexpr size_t header_words = 3;
+
+    large_bitset _bitset;
+    uint64_t _seed = 0;
+    uint32_t _segment_length = 0;
+    uint32_t _segment_length_mask = 0;
+    uint32_t _segment_count_length = 0;
+    unsigned _fingerprint_bits = 0;
+    uint64_t _fingerprint_mask = 0;
+
+    static thread_local struct stats {
+        uint64_t memory_size = 0;
+    } _shard_stats;
+    stats& _stats = _shard_stats;
+
+    struct layout;
+
+    xor_filter(large_bitset&& bs, const layout& l, uint64_t seed);
+
+    std::array<uint32_t, hash_count> positions(uint64_t h) const noexcept;
+    uint64_t fingerprint(uint64_t h) const noexcept {
+        return (h ^ (h >> 32)) & _fingerprint_mask;
+    }
+    uint64_t get_fingerprint(uint32_t idx) const noexcept;
+    void set_fingerprint(uint32_t idx, uint64_t fp) noexcept;
+    void write_header() noexcept;
+public:
+    // Loads a filter from the storage of a filter built by build().
+    explicit xor_filter(large_bitset&& bs);
+    ~xor_filter();
+
+    // Reduces the hashed key to the 64-bit key the filter is built from.
+    static uint64_t key_of(const hashed_key& key) noexcept;
+
+    // Builds a filter holding the given keys (as returned by key_of()), with
+    // a false positive probability of at most max_false_pos_prob.
+    // Returns nullptr if the filter could not be constructed, in which case the
+    // caller should fall back to a Bloom filter.
+    // Must be called in a seastar thread.
+    static std::unique_ptr<xor_filter> build(const utils::chunked_vector<uint64_t>& keys, double max_false_pos_prob);
+
+    // Size in bits of the storage of a filter built by build() for the given
+    // number of keys (which build() only exceeds if the keys are duplicated).
+    static size_t get_bitset_size(int64_t num_elements, double max_false_pos_prob);
+
+    // The filter is immutable, see build().
+    virtual void add(const bytes_view& key) override;
+    virtual void add(const hashed_key& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void prefetch(hashed_key key) override;
+
+    // Turns this into a filter which holds no keys.
+    virtual void clear() override;
+
+    virtual void close() override { }
+
+    virtual size_t memory_size() override {
+        return sizeof(*this) + _bitset.memory_size();
+    }
+
+    const large_bitset& bits() const noexcept {
+        return _bitset;
+    }
+
+    static const stats& get_shard_stats() noexcept {
+        return _shard_stats;
+    }
+};
+
+}
+}